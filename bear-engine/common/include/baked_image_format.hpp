@@ -0,0 +1,47 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Constants describing the header of a baked image file.
+ * \author Julien Jorge
+ */
+#ifndef __BEAR_BAKED_IMAGE_FORMAT_HPP__
+#define __BEAR_BAKED_IMAGE_FORMAT_HPP__
+
+namespace bear
+{
+  /**
+   * \brief Constants describing the header of a baked image file, shared by
+   *        the bake-image tool and bear::visual::baked_image.
+   *
+   * All the fields of the header are 32 bits little endian integers.
+   */
+  class baked_image_format
+  {
+  public:
+    /** \brief The type of the fields of the header. */
+    typedef unsigned int value_type;
+
+  public:
+    /** \brief The first field of the file, the characters "BTEX". */
+    static const value_type magic = 0x58455442;
+
+    /** \brief The version of the format. */
+    static const value_type version = 1;
+
+    /** \brief The flag telling that some pixels are transparent. */
+    static const value_type flag_transparency = 1;
+
+    /** \brief The number of bytes of a pixel. */
+    static const value_type pixel_size = 4;
+
+  }; // class baked_image_format
+} // namespace bear
+
+#endif // __BEAR_BAKED_IMAGE_FORMAT_HPP__
@@ -0,0 +1,134 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::audio::decoded_sound class.
+ * \author Julien Jorge
+ */
+#include "audio/decoded_sound.hpp"
+
+#include <SDL2/SDL.h>
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param name The name of the sound.
+ * \param file (in/out) The content of the encoded file. It is swapped with the
+ *        content of the instance, thus file is empty after the call.
+ * \param channels The number of channels in the decoded frames.
+ */
+bear::audio::decoded_sound::decoded_sound
+( const std::string& name, std::vector<char>& file, unsigned int channels )
+  : m_name(name), m_channels(channels), m_sound(NULL), m_decoding_duration(0),
+    m_ready(false)
+{
+  m_file.swap( file );
+} // decoded_sound::decoded_sound()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::audio::decoded_sound::~decoded_sound()
+{
+  wait();
+
+  if ( m_sound != NULL )
+    Mix_FreeChunk( m_sound );
+} // decoded_sound::~decoded_sound()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode the file. This method must be called exactly once.
+ */
+void bear::audio::decoded_sound::decode()
+{
+  const Uint64 start( SDL_GetPerformanceCounter() );
+  SDL_RWops* rw(NULL);
+
+  if ( !m_file.empty() )
+    rw = SDL_RWFromConstMem( &m_file[0], m_file.size() );
+
+  if (rw)
+    m_sound = Mix_LoadWAV_RW( rw, 1 );
+
+  std::vector<char>().swap( m_file );
+
+  const double duration
+    ( (double)(SDL_GetPerformanceCounter() - start) * 1000
+      / SDL_GetPerformanceFrequency() );
+
+  if ( m_sound == NULL )
+    claw::logger << claw::log_error << "Can't decode sound '" << m_name
+                 << "': " << Mix_GetError() << std::endl;
+  else
+    claw::logger << claw::log_verbose << "Sound '" << m_name
+                 << "' decoded in " << duration << " ms." << std::endl;
+
+  {
+    boost::mutex::scoped_lock lock( m_mutex );
+    m_decoding_duration = duration;
+    m_ready = true;
+  }
+
+  m_condition.notify_all();
+} // decoded_sound::decode()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait for the end of the decoding.
+ */
+void bear::audio::decoded_sound::wait() const
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  while ( !m_ready )
+    m_condition.wait( lock );
+} // decoded_sound::wait()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the interleaved frames of the sound, NULL if the file could not
+ *        be decoded.
+ */
+const claw::int_16* bear::audio::decoded_sound::get_samples() const
+{
+  wait();
+
+  if ( m_sound == NULL )
+    return NULL;
+  else
+    return reinterpret_cast<const claw::int_16*>( m_sound->abuf );
+} // decoded_sound::get_samples()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of frames in the sound.
+ */
+std::size_t bear::audio::decoded_sound::get_frame_count() const
+{
+  wait();
+
+  if ( m_sound == NULL )
+    return 0;
+  else
+    return m_sound->alen / (m_channels * sizeof(claw::int_16));
+} // decoded_sound::get_frame_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the time spent in the decoding of the file, in milliseconds.
+ */
+double bear::audio::decoded_sound::get_decoding_duration() const
+{
+  wait();
+
+  return m_decoding_duration;
+} // decoded_sound::get_decoding_duration()
@@ -0,0 +1,90 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::audio::decoder_pool class.
+ * \author Julien Jorge
+ */
+#include "audio/decoder_pool.hpp"
+
+#include <claw/assert.hpp>
+
+#include <boost/bind.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param thread_count The number of threads executing the tasks.
+ */
+bear::audio::decoder_pool::decoder_pool( std::size_t thread_count )
+  : m_stop(false)
+{
+  CLAW_PRECOND( thread_count > 0 );
+
+  for ( std::size_t i(0); i != thread_count; ++i )
+    m_threads.create_thread( boost::bind( &decoder_pool::run, this ) );
+} // decoder_pool::decoder_pool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The pending tasks are executed before the threads stop.
+ */
+bear::audio::decoder_pool::~decoder_pool()
+{
+  {
+    boost::mutex::scoped_lock lock( m_mutex );
+    m_stop = true;
+  }
+
+  m_condition.notify_all();
+  m_threads.join_all();
+} // decoder_pool::~decoder_pool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a task to execute.
+ * \param task The task.
+ */
+void bear::audio::decoder_pool::push( const task_type& task )
+{
+  {
+    boost::mutex::scoped_lock lock( m_mutex );
+    m_tasks.push_back( task );
+  }
+
+  m_condition.notify_one();
+} // decoder_pool::push()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The loop of the threads, executing the tasks until the pool is
+ *        stopped.
+ */
+void bear::audio::decoder_pool::run()
+{
+  while ( true )
+    {
+      task_type task;
+
+      {
+        boost::mutex::scoped_lock lock( m_mutex );
+
+        while ( m_tasks.empty() && !m_stop )
+          m_condition.wait( lock );
+
+        if ( m_tasks.empty() )
+          return;
+
+        task.swap( m_tasks.front() );
+        m_tasks.pop_front();
+      }
+
+      task();
+    }
+} // decoder_pool::run()
@@ -0,0 +1,710 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::audio::mixer class.
+ * \author Julien Jorge
+ */
+#include "audio/mixer.hpp"
+
+#include "audio/decoder_pool.hpp"
+#include "audio/detail/apply_stereo_gain.hpp"
+#include "audio/ogg_stream.hpp"
+#include "audio/sdl_sample.hpp"
+#include "audio/sound_manager.hpp"
+
+#include "debug/performance_counters.hpp"
+
+#include <boost/bind.hpp>
+#include <claw/assert.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::audio::mixer::not_a_voice
+( std::numeric_limits<std::size_t>::max() );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param rate The sample rate of the output.
+ * \param max_mixed_voices The maximum number of voices actually mixed in a
+ *        buffer.
+ * \param pool The pool decoding the frames of the streams. If NULL, the
+ *        frames are decoded during the mix, as needed by an offline rendering.
+ */
+bear::audio::mixer::mixer
+( unsigned int rate, unsigned int max_mixed_voices, decoder_pool* pool )
+  : m_rate(rate), m_max_mixed_voices(max_mixed_voices), m_decoder_pool(pool),
+    m_voice_count(0), m_mixed_voice_count(0)
+{
+
+} // mixer::mixer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to play a voice whose frames are in memory.
+ * \param owner The sample playing the voice.
+ * \param manager The manager giving the position of the ears.
+ * \param samples The interleaved stereo frames to play.
+ * \param frames The number of frames in samples.
+ * \param effect The effect applied to the voice.
+ * \param volume The volume of the voice.
+ * \return The identifier of the voice.
+ */
+std::size_t bear::audio::mixer::play
+( sdl_sample& owner, const sound_manager& manager, const claw::int_16* samples,
+  std::size_t frames, const sound_effect& effect, double volume )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  const std::size_t result( new_voice( owner, manager, effect, volume ) );
+
+  m_voices[result].samples = samples;
+  m_voices[result].frames = frames;
+
+  return result;
+} // mixer::play()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to play a voice whose frames are decoded on demand.
+ * \param owner The sample playing the voice.
+ * \param manager The manager giving the position of the ears.
+ * \param stream The decoder of the frames. It must not have been filled yet.
+ * \param effect The effect applied to the voice.
+ * \param volume The volume of the voice.
+ * \return The identifier of the voice.
+ */
+std::size_t bear::audio::mixer::play
+( sdl_sample& owner, const sound_manager& manager,
+  const boost::shared_ptr<ogg_stream>& stream, const sound_effect& effect,
+  double volume )
+{
+  CLAW_PRECOND( stream != NULL );
+
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  const std::size_t result( new_voice( owner, manager, effect, volume ) );
+  voice& v( m_voices[result] );
+
+  // The stream loops by itself since it is decoded ahead.
+  stream->set_loops( v.loops );
+  v.stream = stream;
+  request_frames( v );
+
+  return result;
+} // mixer::play()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop a voice now. The owner of the voice is not notified.
+ * \param v The identifier of the voice.
+ * \param owner The sample that played the voice. Nothing is done if the voice
+ *        has been released in the meantime.
+ */
+void bear::audio::mixer::stop( std::size_t v, const sdl_sample& owner )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  if ( is_owned_by( v, owner ) )
+    release( v );
+} // mixer::stop()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop a voice after fading out. The owner of the voice is notified at
+ *        the end of the fade out.
+ * \param v The identifier of the voice.
+ * \param owner The sample that played the voice.
+ * \param d The duration of the fade out, in seconds.
+ * \remark Nothing is done if the voice is already fading out or if it has been
+ *         released in the meantime.
+ */
+void bear::audio::mixer::fade_out
+( std::size_t v, const sdl_sample& owner, double d )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  if ( !is_owned_by( v, owner ) || (m_voices[v].fade_length != 0) )
+    return;
+
+  const std::size_t length( std::max( 1.0, d * m_rate + 0.5 ) );
+
+  m_voices[v].fade_length = length;
+  m_voices[v].fade_remaining = length;
+} // mixer::fade_out()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pause a voice.
+ * \param v The identifier of the voice.
+ * \param owner The sample that played the voice. Nothing is done if the voice
+ *        has been released in the meantime.
+ */
+void bear::audio::mixer::pause( std::size_t v, const sdl_sample& owner )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  if ( is_owned_by( v, owner ) )
+    m_voices[v].paused = true;
+} // mixer::pause()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Resume a paused voice.
+ * \param v The identifier of the voice.
+ * \param owner The sample that played the voice. Nothing is done if the voice
+ *        has been released in the meantime.
+ */
+void bear::audio::mixer::resume( std::size_t v, const sdl_sample& owner )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  if ( is_owned_by( v, owner ) )
+    m_voices[v].paused = false;
+} // mixer::resume()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Change the effect applied to a voice.
+ * \param v The identifier of the voice.
+ * \param owner The sample that played the voice. Nothing is done if the voice
+ *        has been released in the meantime.
+ * \param effect The new effect. Its loops are ignored.
+ * \param d The duration of the transition from the current volume of the voice
+ *        to the volume of the effect, in seconds.
+ */
+void bear::audio::mixer::set_effect
+( std::size_t v, const sdl_sample& owner, const sound_effect& effect,
+  double d )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  if ( !is_owned_by( v, owner ) )
+    return;
+
+  voice& target( m_voices[v] );
+
+  target.effect = effect;
+
+  if ( d <= 0 )
+    target.effect_volume_step = 0;
+  else
+    target.effect_volume_step =
+      std::abs( effect.get_volume() - target.effect_volume ) / (d * m_rate);
+} // mixer::set_effect()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Change the volume of a voice.
+ * \param v The identifier of the voice.
+ * \param owner The sample that played the voice. Nothing is done if the voice
+ *        has been released in the meantime.
+ * \param volume The new volume.
+ */
+void bear::audio::mixer::set_volume
+( std::size_t v, const sdl_sample& owner, double volume )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  if ( is_owned_by( v, owner ) )
+    m_voices[v].volume = volume;
+} // mixer::set_volume()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mix the voices in an output buffer. The owners of the voices reaching
+ *        their end are notified.
+ * \param output (out) The buffer receiving the interleaved stereo frames.
+ * \param frames The number of frames to write in output.
+ */
+void bear::audio::mixer::mix( claw::int_16* output, std::size_t frames )
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  m_accumulator.assign( 2 * frames, 0 );
+  m_voice_buffer.resize( 2 * frames );
+
+  select_voices( frames );
+  m_mixed_voice_count = mix_voices( frames );
+
+  BEAR_COUNTER_SET( "audio/voices", m_voice_count );
+  BEAR_COUNTER_SET( "audio/mixed_voices", m_mixed_voice_count );
+
+  const claw::int_32 min_value( std::numeric_limits<claw::int_16>::min() );
+  const claw::int_32 max_value( std::numeric_limits<claw::int_16>::max() );
+
+  for ( std::size_t i(0); i != 2 * frames; ++i )
+    output[i] =
+      std::max( min_value, std::min( max_value, m_accumulator[i] ) );
+
+  notify_finished();
+} // mixer::mix()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of voices currently played, mixed or not.
+ */
+std::size_t bear::audio::mixer::get_voice_count() const
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  return m_voice_count;
+} // mixer::get_voice_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of voices actually mixed in the last buffer.
+ */
+std::size_t bear::audio::mixer::get_mixed_voice_count() const
+{
+  boost::recursive_mutex::scoped_lock lock( m_mutex );
+
+  return m_mixed_voice_count;
+} // mixer::get_mixed_voice_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a new voice, with no frames.
+ * \param owner The sample playing the voice.
+ * \param manager The manager giving the position of the ears.
+ * \param effect The effect applied to the voice.
+ * \param volume The volume of the voice.
+ * \return The identifier of the voice.
+ */
+std::size_t bear::audio::mixer::new_voice
+( sdl_sample& owner, const sound_manager& manager, const sound_effect& effect,
+  double volume )
+{
+  std::size_t result;
+
+  if ( m_free_voices.empty() )
+    {
+      result = m_voices.size();
+      m_voices.push_back( voice() );
+    }
+  else
+    {
+      result = m_free_voices.back();
+      m_free_voices.pop_back();
+    }
+
+  voice& v( m_voices[result] );
+
+  v.owner = &owner;
+  v.manager = &manager;
+  v.samples = NULL;
+  v.frames = 0;
+  v.position = 0;
+  v.stream.reset();
+  v.loops = effect.get_loops() - 1;
+  v.effect = effect;
+  v.effect_volume = effect.get_volume();
+  v.effect_volume_step = 0;
+  v.volume = volume;
+  v.paused = false;
+  v.finished = false;
+  v.fade_length = 0;
+  v.fade_remaining = 0;
+  v.has_gains = false;
+  v.left_gain = 1;
+  v.right_gain = 1;
+
+  ++m_voice_count;
+
+  return result;
+} // mixer::new_voice()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the gains of the playing voices and move the most audible
+ *        ones at the beginning of m_candidates.
+ * \param frames The number of frames in the buffer to mix.
+ */
+void bear::audio::mixer::select_voices( std::size_t frames )
+{
+  m_candidates.clear();
+
+  for ( std::size_t i(0); i != m_voices.size(); ++i )
+    {
+      voice& v( m_voices[i] );
+
+      if ( (v.owner == NULL) || v.paused || v.finished )
+        continue;
+
+      double left;
+      double right;
+      compute_gains( v, left, right );
+
+      const double start_gain
+        ( v.volume * v.effect_volume * get_fade_gain( v, 0 ) );
+      const double end_gain
+        ( v.volume * get_effect_volume( v, frames )
+          * get_fade_gain( v, frames ) );
+
+      if ( !v.has_gains )
+        {
+          v.has_gains = true;
+          v.left_gain = left * start_gain;
+          v.right_gain = right * start_gain;
+        }
+
+      candidate c;
+      c.index = i;
+      c.audibility =
+        std::max( left, right ) * std::max( start_gain, end_gain );
+      c.left = left * end_gain;
+      c.right = right * end_gain;
+
+      m_candidates.push_back( c );
+    }
+
+  if ( m_candidates.size() > m_max_mixed_voices )
+    std::nth_element
+      ( m_candidates.begin(), m_candidates.begin() + m_max_mixed_voices,
+        m_candidates.end(), &mixer::is_more_audible );
+} // mixer::select_voices()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mix the selected voices in m_accumulator and move the other ones
+ *        forward.
+ * \param frames The number of frames in the buffer to mix.
+ * \return The number of voices actually mixed.
+ */
+std::size_t bear::audio::mixer::mix_voices( std::size_t frames )
+{
+  std::size_t result(0);
+  m_finished.clear();
+
+  for ( std::size_t i(0); i != m_candidates.size(); ++i )
+    {
+      const candidate& c( m_candidates[i] );
+      voice& v( m_voices[c.index] );
+
+      if ( (i < m_max_mixed_voices)
+           && (c.audibility > std::numeric_limits<double>::epsilon()) )
+        {
+          mix_voice( v, frames, c.left, c.right );
+          ++result;
+        }
+      else if ( (v.left_gain > 0) || (v.right_gain > 0) )
+        // The voice was heard in the previous buffer. It is faded to silence
+        // to avoid a click.
+        mix_voice( v, frames, 0, 0 );
+      else
+        {
+          read_frames( v, NULL, frames );
+          v.left_gain = 0;
+          v.right_gain = 0;
+        }
+
+      v.effect_volume = get_effect_volume( v, frames );
+
+      if ( v.fade_length != 0 )
+        {
+          v.fade_remaining -= std::min( v.fade_remaining, frames );
+
+          if ( v.fade_remaining == 0 )
+            v.finished = true;
+        }
+
+      if ( v.finished )
+        m_finished.push_back( c.index );
+    }
+
+  return result;
+} // mixer::mix_voices()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mix a voice in m_accumulator.
+ * \param v The voice to mix.
+ * \param frames The number of frames in the buffer to mix.
+ * \param left The gain of the left channel at the end of the buffer.
+ * \param right The gain of the right channel at the end of the buffer.
+ */
+void bear::audio::mixer::mix_voice
+( voice& v, std::size_t frames, double left, double right )
+{
+  const std::size_t count( read_frames( v, &m_voice_buffer[0], frames ) );
+
+  detail::apply_stereo_gain
+    ( &m_voice_buffer[0], count, v.left_gain, v.right_gain, left, right );
+
+  for ( std::size_t i(0); i != 2 * count; ++i )
+    m_accumulator[i] += m_voice_buffer[i];
+
+  v.left_gain = left;
+  v.right_gain = right;
+} // mixer::mix_voice()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Release the voices that reached their end during the last mix and
+ *        notify their owners.
+ */
+void bear::audio::mixer::notify_finished()
+{
+  // The owners may stop or play other voices, thus m_voices can be modified
+  // during the loop.
+  for ( std::size_t i(0); i != m_finished.size(); ++i )
+    {
+      const std::size_t index( m_finished[i] );
+
+      if ( (m_voices[index].owner != NULL) && m_voices[index].finished )
+        {
+          sdl_sample* const owner( m_voices[index].owner );
+          release( index );
+          owner->voice_finished();
+        }
+    }
+} // mixer::notify_finished()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mark a voice as unused.
+ * \param v The identifier of the voice.
+ */
+void bear::audio::mixer::release( std::size_t v )
+{
+  m_voices[v].owner = NULL;
+  m_voices[v].effect = sound_effect();
+
+  m_voices[v].stream.reset();
+
+  m_free_voices.push_back( v );
+
+  --m_voice_count;
+} // mixer::release()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a voice is currently played by a given sample. The voice
+ *        known by a sample may have been released by the audio thread and
+ *        given to another sample before the sample is notified.
+ * \param v The identifier of the voice.
+ * \param owner The sample.
+ * \pre m_mutex is locked.
+ */
+bool bear::audio::mixer::is_owned_by
+( std::size_t v, const sdl_sample& owner ) const
+{
+  return (v < m_voices.size()) && (m_voices[v].owner == &owner);
+} // mixer::is_owned_by()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next frames of a voice, looping on the sound if needed.
+ * \param v The voice to read.
+ * \param out (out) The buffer receiving the frames. If NULL, the frames are
+ *        skipped.
+ * \param frames The number of frames to read.
+ * \return The number of frames actually read, less than frames if the voice
+ *         reached its end.
+ */
+std::size_t bear::audio::mixer::read_frames
+( voice& v, claw::int_16* out, std::size_t frames )
+{
+  if ( v.stream == NULL )
+    return read_memory( v, out, frames );
+  else
+    return read_stream( v, out, frames );
+} // mixer::read_frames()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next frames of a streamed voice.
+ * \param v The voice to read.
+ * \param out (out) The buffer receiving the frames. If NULL, the frames are
+ *        skipped.
+ * \param frames The number of frames to read.
+ * \return The number of frames actually read, less than frames if the voice
+ *         reached its end or if the decoder pool is late.
+ */
+std::size_t bear::audio::mixer::read_stream
+( voice& v, claw::int_16* out, std::size_t frames )
+{
+  std::size_t result(0);
+  bool starving(false);
+
+  while ( (result != frames) && !v.finished && !starving )
+    {
+      request_frames( v );
+
+      const std::size_t n
+        ( v.stream->read
+          ( (out == NULL) ? NULL : out + 2 * result, frames - result ) );
+
+      result += n;
+
+      if ( v.stream->is_finished() )
+        v.finished = true;
+      else if ( n == 0 )
+        {
+          starving = true;
+          BEAR_COUNTER_ADD( "audio/stream_underruns", 1 );
+        }
+    }
+
+  return result;
+} // mixer::read_stream()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Ask for the decoding of the next frames of a streamed voice, if
+ *        needed.
+ * \param v The voice.
+ */
+void bear::audio::mixer::request_frames( const voice& v )
+{
+  if ( !v.stream->start_filling() )
+    return;
+
+  if ( m_decoder_pool == NULL )
+    v.stream->fill();
+  else
+    m_decoder_pool->push( boost::bind( &ogg_stream::fill, v.stream ) );
+} // mixer::request_frames()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next frames of a voice decoded in memory, looping on the
+ *        sound if needed.
+ * \param v The voice to read.
+ * \param out (out) The buffer receiving the frames. If NULL, the frames are
+ *        skipped.
+ * \param frames The number of frames to read.
+ * \return The number of frames actually read, less than frames if the voice
+ *         reached its end.
+ */
+std::size_t bear::audio::mixer::read_memory
+( voice& v, claw::int_16* out, std::size_t frames )
+{
+  std::size_t result(0);
+
+  while ( (result != frames) && !v.finished )
+    if ( v.position != v.frames )
+      {
+        const std::size_t n
+          ( std::min( frames - result, v.frames - v.position ) );
+
+        if ( out != NULL )
+          std::copy
+            ( v.samples + 2 * v.position, v.samples + 2 * (v.position + n),
+              out + 2 * result );
+
+        v.position += n;
+        result += n;
+      }
+    else if ( (v.loops == 0) || (v.frames == 0) )
+      v.finished = true;
+    else
+      {
+        if ( v.loops > 0 )
+          --v.loops;
+
+        v.position = 0;
+      }
+
+  if ( (v.position == v.frames) && (v.loops == 0) )
+    v.finished = true;
+
+  return result;
+} // mixer::read_memory()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the gain resulting of the fade out of a voice.
+ * \param v The voice.
+ * \param frames The number of frames after the current position for which we
+ *        want the gain.
+ */
+double bear::audio::mixer::get_fade_gain( const voice& v, std::size_t frames )
+{
+  if ( v.fade_length == 0 )
+    return 1;
+  else
+    return (double)( v.fade_remaining - std::min( frames, v.fade_remaining ) )
+      / v.fade_length;
+} // mixer::get_fade_gain()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the volume of the effect of a voice after some frames.
+ * \param v The voice.
+ * \param frames The number of frames after the current position for which we
+ *        want the volume.
+ */
+double
+bear::audio::mixer::get_effect_volume( const voice& v, std::size_t frames )
+{
+  const double target( v.effect.get_volume() );
+
+  if ( v.effect_volume_step == 0 )
+    return target;
+
+  const double delta( v.effect_volume_step * frames );
+
+  if ( v.effect_volume < target )
+    return std::min( target, v.effect_volume + delta );
+  else
+    return std::max( target, v.effect_volume - delta );
+} // mixer::get_effect_volume()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the gains to apply to the channels of a voice, according to
+ *        the position of its effect.
+ * \param v The voice.
+ * \param left (out) The gain of the left channel.
+ * \param right (out) The gain of the right channel.
+ */
+void bear::audio::mixer::compute_gains
+( const voice& v, double& left, double& right )
+{
+  left = 1;
+  right = 1;
+
+  if ( !v.effect.has_a_position() )
+    return;
+
+  const claw::math::coordinate_2d<double> ears =
+    v.manager->get_ears_position();
+  const claw::math::coordinate_2d<double> pos = v.effect.get_position();
+
+  const double horizontal_distance( std::abs(ears.x - pos.x) );
+  const double tone_down =
+    v.manager->get_volume_for_distance
+    ( horizontal_distance + std::abs(ears.y - pos.y) );
+  const double balance =
+    v.manager->get_volume_for_distance( horizontal_distance );
+
+  left *= tone_down;
+  right *= tone_down;
+
+  if ( ears.x < pos.x )
+    left *= balance;
+  else
+    right *= balance;
+} // mixer::compute_gains()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a voice is more audible than another.
+ * \param a The first voice.
+ * \param b The second voice.
+ */
+bool bear::audio::mixer::is_more_audible
+( const candidate& a, const candidate& b )
+{
+  return a.audibility > b.audibility;
+} // mixer::is_more_audible()
@@ -0,0 +1,503 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::audio::ogg_stream class.
+ * \author Julien Jorge
+ */
+#include "audio/ogg_stream.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/exception.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::audio::ogg_stream::s_buffer_frames = 32768;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param file The content of the encoded file.
+ * \param rate The sample rate of the output.
+ * \param channels The number of channels in the output.
+ */
+bear::audio::ogg_stream::ogg_stream
+( const file_pointer& file, unsigned int rate, unsigned int channels )
+  : m_converter(NULL), m_decoded(4096), m_channels(channels), m_end(false),
+    m_loops(0), m_head(0), m_tail(0), m_decoded_all(false), m_filling(false)
+{
+  CLAW_PRECOND( file != NULL );
+
+  std::size_t size(2);
+
+  while ( size < s_buffer_frames )
+    size *= 2;
+
+  m_frames.resize( size * m_channels );
+
+  m_file.content = file;
+  m_file.position = 0;
+
+  if ( !open( m_vorbis, m_file ) )
+    throw claw::exception( "Can't open the Ogg Vorbis stream." );
+
+  const vorbis_info* const info( ov_info( &m_vorbis, -1 ) );
+
+  if ( ((unsigned int)info->channels != channels)
+       || ((unsigned int)info->rate != rate) )
+    {
+      m_converter =
+        SDL_NewAudioStream
+        ( AUDIO_S16SYS, info->channels, info->rate, AUDIO_S16SYS, channels,
+          rate );
+
+      if ( m_converter == NULL )
+        {
+          ov_clear( &m_vorbis );
+          throw claw::exception( SDL_GetError() );
+        }
+    }
+} // ogg_stream::ogg_stream()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::audio::ogg_stream::~ogg_stream()
+{
+  if ( m_converter != NULL )
+    SDL_FreeAudioStream( m_converter );
+
+  ov_clear( &m_vorbis );
+} // ogg_stream::~ogg_stream()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set how many times the file must be decoded again when reaching its
+ *        end.
+ * \param loops The number of times. A negative value means forever.
+ * \pre fill() has not been called yet.
+ */
+void bear::audio::ogg_stream::set_loops( int loops )
+{
+  m_loops = loops;
+} // ogg_stream::set_loops()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Take the next decoded frames of the stream. The frames are not
+ *        decoded here, see fill().
+ * \param out (out) The buffer receiving the interleaved frames. If NULL, the
+ *        frames are skipped.
+ * \param frames The number of frames to read.
+ * \return The number of frames actually read, less than frames if the
+ *         decoded frames are exhausted.
+ */
+std::size_t
+bear::audio::ogg_stream::read( claw::int_16* out, std::size_t frames )
+{
+  const std::size_t head( m_head.load( std::memory_order_relaxed ) );
+  const std::size_t result
+    ( std::min( frames, m_tail.load( std::memory_order_acquire ) - head ) );
+
+  if ( out != NULL )
+    {
+      const std::size_t capacity( m_frames.size() / m_channels );
+      const std::size_t first( head & (capacity - 1) );
+      const std::size_t n( std::min( result, capacity - first ) );
+
+      std::copy
+        ( m_frames.begin() + first * m_channels,
+          m_frames.begin() + (first + n) * m_channels, out );
+      std::copy
+        ( m_frames.begin(), m_frames.begin() + (result - n) * m_channels,
+          out + n * m_channels );
+    }
+
+  m_head.store( head + result, std::memory_order_release );
+
+  return result;
+} // ogg_stream::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if all the frames of the stream have been read.
+ */
+bool bear::audio::ogg_stream::is_finished() const
+{
+  return m_decoded_all.load( std::memory_order_acquire )
+    && ( m_head.load( std::memory_order_relaxed )
+         == m_tail.load( std::memory_order_acquire ) );
+} // ogg_stream::is_finished()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the decoded frames must be refilled and, if so, reserve the
+ *        call to fill().
+ * \return true if the caller must call fill(). Until then, the next calls
+ *         return false.
+ */
+bool bear::audio::ogg_stream::start_filling()
+{
+  const std::size_t available
+    ( m_tail.load( std::memory_order_acquire )
+      - m_head.load( std::memory_order_relaxed ) );
+
+  if ( m_decoded_all.load( std::memory_order_acquire )
+       || (available >= m_frames.size() / m_channels / 2) )
+    return false;
+
+  return !m_filling.exchange( true );
+} // ogg_stream::start_filling()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode frames until the buffer is full or the stream reaches its
+ *        end, restarting at the beginning of the file according to the loops.
+ *
+ * This method must not be called by several threads at once, see
+ * start_filling().
+ */
+void bear::audio::ogg_stream::fill()
+{
+  const std::size_t capacity( m_frames.size() / m_channels );
+  bool rewound(false);
+  bool full(false);
+
+  while ( !full && !m_decoded_all.load( std::memory_order_relaxed ) )
+    {
+      const std::size_t tail( m_tail.load( std::memory_order_relaxed ) );
+      const std::size_t free
+        ( capacity - (tail - m_head.load( std::memory_order_acquire )) );
+      const std::size_t first( tail & (capacity - 1) );
+
+      if ( free == 0 )
+        full = true;
+      else
+        {
+          const std::size_t n
+            ( decode_frames
+              ( &m_frames[ first * m_channels ],
+                std::min( free, capacity - first ) ) );
+
+          if ( n != 0 )
+            {
+              m_tail.store( tail + n, std::memory_order_release );
+              rewound = false;
+            }
+          else if ( (m_loops == 0) || rewound )
+            m_decoded_all.store( true, std::memory_order_release );
+          else
+            {
+              if ( m_loops > 0 )
+                --m_loops;
+
+              rewind();
+              rewound = true;
+            }
+        }
+    }
+
+  m_filling.store( false, std::memory_order_release );
+} // ogg_stream::fill()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the duration of an Ogg Vorbis file, in seconds.
+ * \param file The content of the file.
+ * \return The duration of the file or zero if it is not an Ogg Vorbis file.
+ *
+ * The duration is computed from the sample rate given in the header of the
+ * stream and from the position of the last page of the stream, thus the file
+ * is not decoded. If the file chains several streams, only the first one is
+ * considered.
+ */
+double bear::audio::ogg_stream::get_duration( const file_pointer& file )
+{
+  CLAW_PRECOND( file != NULL );
+
+  ogg_uint32_t serial;
+  ogg_uint32_t rate;
+  ogg_int64_t granule;
+
+  if ( !is_ogg( *file ) || !get_stream_info( *file, serial, rate )
+       || (rate == 0)
+       || !get_last_granule_position( *file, serial, granule ) )
+    return 0;
+
+  return std::max( 0.0, (double)granule / rate );
+} // ogg_stream::get_duration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode the next frames of the file in the format of the output.
+ * \param out (out) The buffer receiving the interleaved frames.
+ * \param frames The number of frames to decode.
+ * \return The number of frames actually decoded, less than frames if the end
+ *         of the file is reached.
+ */
+std::size_t bear::audio::ogg_stream::decode_frames
+( claw::int_16* out, std::size_t frames )
+{
+  const std::size_t frame_size( m_channels * sizeof(claw::int_16) );
+  const std::size_t length( frames * frame_size );
+
+  if ( m_converter == NULL )
+    return decode( reinterpret_cast<char*>(out), length ) / frame_size;
+
+  while ( !m_end
+          && ((std::size_t)SDL_AudioStreamAvailable( m_converter ) < length) )
+    {
+      const std::size_t n( decode( &m_decoded[0], m_decoded.size() ) );
+
+      if ( n == 0 )
+        {
+          m_end = true;
+          SDL_AudioStreamFlush( m_converter );
+        }
+      else
+        SDL_AudioStreamPut( m_converter, &m_decoded[0], n );
+    }
+
+  const int result( SDL_AudioStreamGet( m_converter, out, length ) );
+
+  if ( result <= 0 )
+    return 0;
+  else
+    return result / frame_size;
+} // ogg_stream::decode_frames()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode the next bytes of the file in the format of the file.
+ * \param out (out) The buffer receiving the decoded bytes.
+ * \param length The size of out.
+ * \return The number of bytes written in out.
+ */
+std::size_t bear::audio::ogg_stream::decode( char* out, std::size_t length )
+{
+  const int big_endian( SDL_BYTEORDER == SDL_BIG_ENDIAN );
+  std::size_t result(0);
+  bool stop(false);
+
+  while ( !stop && (result != length) )
+    {
+      int section;
+      const long n
+        ( ov_read
+          ( &m_vorbis, out + result, length - result, big_endian,
+            sizeof(claw::int_16), 1, &section ) );
+
+      if ( n > 0 )
+        result += n;
+      else if ( n != OV_HOLE )
+        stop = true;
+    }
+
+  return result;
+} // ogg_stream::decode()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restart the stream at its beginning.
+ */
+void bear::audio::ogg_stream::rewind()
+{
+  ov_pcm_seek( &m_vorbis, 0 );
+  m_end = false;
+
+  if ( m_converter != NULL )
+    SDL_AudioStreamClear( m_converter );
+} // ogg_stream::rewind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a file is an Ogg file.
+ * \param file The content of the file.
+ */
+bool bear::audio::ogg_stream::is_ogg( const std::vector<char>& file )
+{
+  return (file.size() >= 4) && (std::memcmp( &file[0], "OggS", 4 ) == 0);
+} // ogg_stream::is_ogg()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Open a decoder on an encoded file.
+ * \param vorbis The decoder to open.
+ * \param file The file read by the decoder. It must live as long as the
+ *        decoder.
+ * \return true if the decoder has been opened.
+ */
+bool bear::audio::ogg_stream::open( OggVorbis_File& vorbis, memory_file& file )
+{
+  ov_callbacks callbacks;
+  callbacks.read_func = &ogg_stream::read_file;
+  callbacks.seek_func = &ogg_stream::seek_file;
+  callbacks.close_func = NULL;
+  callbacks.tell_func = &ogg_stream::tell_file;
+
+  return ov_open_callbacks( &file, &vorbis, NULL, 0, callbacks ) == 0;
+} // ogg_stream::open()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the serial number and the sample rate of the first stream of
+ *        an Ogg Vorbis file from its first page.
+ * \param file The content of the file.
+ * \param serial (out) The serial number of the stream.
+ * \param rate (out) The sample rate of the stream.
+ * \return false if the first page does not begin with the identification
+ *         header of a Vorbis stream.
+ */
+bool bear::audio::ogg_stream::get_stream_info
+( const std::vector<char>& file, ogg_uint32_t& serial, ogg_uint32_t& rate )
+{
+  // The header of a page is made of 27 bytes followed by the size of each
+  // segment. The identification header begins the first packet: its type,
+  // "vorbis", the version, the number of channels then the sample rate.
+  if ( file.size() < 27 )
+    return false;
+
+  const std::size_t packet( 27 + (unsigned char)file[26] );
+
+  if ( (file.size() < packet + 16) || (file[packet] != 1)
+       || (std::memcmp( &file[packet + 1], "vorbis", 6 ) != 0) )
+    return false;
+
+  serial = read_little_endian( file, 14, 4 );
+  rate = read_little_endian( file, packet + 12, 4 );
+
+  return true;
+} // ogg_stream::get_stream_info()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the granule position of the last page of a stream in an Ogg
+ *        file, which is the number of frames of a Vorbis stream.
+ * \param file The content of the file.
+ * \param serial The serial number of the stream.
+ * \param granule (out) The granule position.
+ * \return false if no page of the stream ends a packet.
+ */
+bool bear::audio::ogg_stream::get_last_granule_position
+( const std::vector<char>& file, ogg_uint32_t serial, ogg_int64_t& granule )
+{
+  // The pages are searched backward from the end of the file. A granule
+  // position of -1 means that no packet ends in the page.
+  bool found(false);
+  std::size_t position( file.size() < 27 ? 0 : file.size() - 27 + 1 );
+
+  while ( !found && (position != 0) )
+    {
+      --position;
+
+      if ( (std::memcmp( &file[position], "OggS", 4 ) == 0)
+           && ((ogg_uint32_t)read_little_endian( file, position + 14, 4 )
+               == serial) )
+        {
+          granule = read_little_endian( file, position + 6, 8 );
+          found = (granule != -1);
+        }
+    }
+
+  return found;
+} // ogg_stream::get_last_granule_position()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an unsigned little endian integer in a file.
+ * \param file The content of the file.
+ * \param position The position of the integer in the file.
+ * \param length The number of bytes of the integer.
+ */
+ogg_int64_t bear::audio::ogg_stream::read_little_endian
+( const std::vector<char>& file, std::size_t position, std::size_t length )
+{
+  CLAW_PRECOND( position + length <= file.size() );
+
+  ogg_uint64_t result(0);
+
+  for ( std::size_t i(length); i != 0; --i )
+    result = (result << 8) | (unsigned char)file[position + i - 1];
+
+  return result;
+} // ogg_stream::read_little_endian()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Callback function reading the encoded file for the decoder.
+ * \param ptr (out) The buffer receiving the bytes.
+ * \param size The size of an item to read.
+ * \param count The number of items to read.
+ * \param file (in/out) The file to read.
+ * \return The number of items read.
+ */
+size_t bear::audio::ogg_stream::read_file
+( void* ptr, size_t size, size_t count, void* file )
+{
+  memory_file* const f( static_cast<memory_file*>(file) );
+
+  if ( size == 0 )
+    return 0;
+
+  const std::size_t available( f->content->size() - f->position );
+  const std::size_t result( std::min( count, available / size ) );
+
+  std::copy
+    ( f->content->begin() + f->position,
+      f->content->begin() + f->position + result * size,
+      static_cast<char*>(ptr) );
+
+  f->position += result * size;
+
+  return result;
+} // ogg_stream::read_file()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Callback function moving the decoder in the encoded file.
+ * \param file (in/out) The file in which the decoder moves.
+ * \param offset The offset of the position.
+ * \param whence The origin of the offset.
+ * \return Zero on success.
+ */
+int bear::audio::ogg_stream::seek_file
+( void* file, ogg_int64_t offset, int whence )
+{
+  memory_file* const f( static_cast<memory_file*>(file) );
+  ogg_int64_t position;
+
+  switch ( whence )
+    {
+    case SEEK_SET: position = offset; break;
+    case SEEK_CUR: position = f->position + offset; break;
+    case SEEK_END: position = f->content->size() + offset; break;
+    default: return -1;
+    }
+
+  if ( (position < 0) || (position > (ogg_int64_t)f->content->size()) )
+    return -1;
+
+  f->position = position;
+
+  return 0;
+} // ogg_stream::seek_file()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Callback function telling the position of the decoder in the encoded
+ *        file.
+ * \param file The file in which the decoder is.
+ */
+long bear::audio::ogg_stream::tell_file( void* file )
+{
+  return static_cast<const memory_file*>(file)->position;
+} // ogg_stream::tell_file()
@@ -167,6 +167,17 @@ void bear::audio::sample::set_effect( const sound_effect& effect )
 
 } // sample::set_effect()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the effect of the sample, changing the volume progressively.
+ * \param effect The new effect.
+ * \param d The duration of the transition of the volume, in seconds.
+ */
+void bear::audio::sample::set_effect( const sound_effect& effect, double d )
+{
+  set_effect( effect );
+} // sample::set_effect()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set the volume of the sample (for sound_manager only).
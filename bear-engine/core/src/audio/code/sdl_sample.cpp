@@ -13,109 +13,10 @@
  */
 #include "audio/sdl_sample.hpp"
 
+#include "audio/mixer.hpp"
 #include "audio/sdl_sound.hpp"
 #include "audio/sound_manager.hpp"
 
-#include <SDL2/SDL.h>
-#include <claw/assert.hpp>
-#include <claw/exception.hpp>
-#include <claw/logger.hpp>
-#include <claw/types.hpp>
-#include <cmath>
-#include <limits>
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Constructor.
- * \post is_empty() == true.
- */
-bear::audio::sdl_sample::channel_attribute::channel_attribute()
-  : m_sample(NULL)
-{
-
-} // sdl_sample::channel_attribute::channel_attribute()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Destructor.
- */
-bear::audio::sdl_sample::channel_attribute::~channel_attribute()
-{
-  clear();
-} // sdl_sample::channel_attribute::~channel_attribute()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Set the sample attribute.
- * \param s The sample.
- * \post is_empty() = false.
- */
-void
-bear::audio::sdl_sample::channel_attribute::set_sample( const sdl_sample& s )
-{
-  m_sample = &s;
-} // sdl_sample::channel_attribute::set_sample()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Get the stored sample.
- * \pre is_empty() = false.
- */
-const bear::audio::sdl_sample&
-bear::audio::sdl_sample::channel_attribute::get_sample() const
-{
-  CLAW_PRECOND( m_sample != NULL );
-
-  return *m_sample;
-} // sdl_sample::channel_attribute::get_sample()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Set the effect of the sound.
- * \param effect The effect.
- */
-void bear::audio::sdl_sample::channel_attribute::set_effect
-( const sound_effect& effect )
-{
-
-  m_effect = effect;
-} // sdl_sample::channel_attribute::set_effect()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Get the effect of the sound.
- */
-const bear::audio::sound_effect&
-bear::audio::sdl_sample::channel_attribute::get_effect() const
-{
-  return m_effect;
-} // sdl_sample::channel_attribute::get_effect()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Remove the sound attribute.
- */
-void bear::audio::sdl_sample::channel_attribute::clear()
-{
-  m_sample = NULL;
-} // sdl_sample::channel_attribute::clear()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Tell if there's a sound associated.
- */
-bool bear::audio::sdl_sample::channel_attribute::is_empty() const
-{
-  return m_sample == NULL;
-} // sdl_sample::channel_attribute::is_empty()
-
-
-
-
-/*----------------------------------------------------------------------------*/
-std::vector<bear::audio::sdl_sample::channel_attribute*>
-bear::audio::sdl_sample::s_playing_channels;
-
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -123,7 +24,8 @@ bear::audio::sdl_sample::s_playing_channels;
  * \param owner The instance of sound_manager who manage the sound.
  */
 bear::audio::sdl_sample::sdl_sample( const sdl_sound& s, sound_manager& owner )
-  : sample(s.get_sound_name(), owner), m_channel(-1), m_sound(&s)
+  : sample(s.get_sound_name(), owner), m_voice(mixer::not_a_voice),
+    m_sound(&s)
 {
 
 } // sdl_sample::sdl_sample()
@@ -164,8 +66,10 @@ void bear::audio::sdl_sample::play( const sound_effect& effect )
  */
 void bear::audio::sdl_sample::pause()
 {
-  if ( m_channel != -1 )
-    Mix_Pause( m_channel );
+  const std::size_t v( m_voice );
+
+  if ( v != mixer::not_a_voice )
+    sdl_sound::get_mixer().pause( v, *this );
 } // sdl_sample::pause()
 
 /*----------------------------------------------------------------------------*/
@@ -174,8 +78,10 @@ void bear::audio::sdl_sample::pause()
  */
 void bear::audio::sdl_sample::resume()
 {
-  if ( m_channel != -1 )
-    Mix_Resume( m_channel );
+  const std::size_t v( m_voice );
+
+  if ( v != mixer::not_a_voice )
+    sdl_sound::get_mixer().resume( v, *this );
 } // sdl_sample::resume()
 
 /*----------------------------------------------------------------------------*/
@@ -184,10 +90,12 @@ void bear::audio::sdl_sample::resume()
  */
 void bear::audio::sdl_sample::stop()
 {
-  if ( m_channel != -1 )
-    Mix_HaltChannel( m_channel );
+  const std::size_t v( m_voice );
 
-  m_channel = -1;
+  if ( v != mixer::not_a_voice )
+    sdl_sound::get_mixer().stop( v, *this );
+
+  m_voice = mixer::not_a_voice;
 
   sample_finished();
 } // sdl_sample::stop()
@@ -199,14 +107,14 @@ void bear::audio::sdl_sample::stop()
  */
 void bear::audio::sdl_sample::stop( double d )
 {
-  if ( m_channel != -1 )
-    {
-      const int ms( d * 1000 + 0.5 );
+  const std::size_t v( m_voice );
 
-      if ( ms <= 0 )
-        stop();
-      else if ( Mix_FadeOutChannel( m_channel, ms ) != 1 )
+  if ( v != mixer::not_a_voice )
+    {
+      if ( d <= 0 )
         stop();
+      else
+        sdl_sound::get_mixer().fade_out( v, *this, d );
     }
 } // sdl_sample::stop()
 
@@ -216,10 +124,7 @@ void bear::audio::sdl_sample::stop( double d )
  */
 bear::audio::sound_effect bear::audio::sdl_sample::get_effect() const
 {
-  if ( m_channel != -1 )
-    return s_playing_channels[m_channel]->get_effect();
-  else
-    return m_effect;
+  return m_effect;
 } // sdl_sample::get_effect()
 
 /*----------------------------------------------------------------------------*/
@@ -231,171 +136,51 @@ void bear::audio::sdl_sample::set_effect( const sound_effect& effect )
 {
   m_effect = effect;
 
-  if ( m_channel != -1 )
-    {
-      if ( !Mix_UnregisterAllEffects(m_channel) )
-        claw::logger << claw::log_warning << "sdl_sample::set_effect(): "
-                     << Mix_GetError() << std::endl;
+  const std::size_t v( m_voice );
 
-      inside_set_effect();
-    }
+  if ( v != mixer::not_a_voice )
+    sdl_sound::get_mixer().set_effect( v, *this, m_effect );
 } // sdl_sample::change_effect()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Set the volume of the sample (for sound_manager only).
- * \param v The volume.
- */
-void bear::audio::sdl_sample::set_volume( double v )
-{
-  if ( m_channel != -1 )
-    Mix_Volume( m_channel, (int)(v * MIX_MAX_VOLUME) );
-} // sdl_sample::set_volume()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Callback function called when a channel is finished.
- * \param channel The finished channel.
- */
-void bear::audio::sdl_sample::channel_finished(int channel)
-{
-  /* This is the last use of s_playing_channels[channel] for this sound.
-     sdl_sample::finished() can't be const for now because it needs to remove
-     channel from the m_channels list. That's why we exceptionally remove the
-     const attribute. */
-  sdl_sample* s = const_cast<sdl_sample*>
-    (&s_playing_channels[channel]->get_sample());
-
-  s->finished();
-} // sdl_sample::channel_finished()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Callback function applying a distance tone down effect to a channel.
- * \param channel The channel receiving the effect.
- * \param stream (in/out) Sound data.
- * \param length The size of the stream.
- * \param attr (in) Channel attribute.
- * \pre attr != NULL.
+ * \brief Change the effect of the sample, changing the volume progressively.
+ * \param effect The new effect.
+ * \param d The duration of the transition of the volume, in seconds.
  */
-void bear::audio::sdl_sample::distance_tone_down
-(int channel, void* stream, int length, void* attr)
+void bear::audio::sdl_sample::set_effect( const sound_effect& effect, double d )
 {
-  CLAW_PRECOND( attr != NULL );
-  CLAW_PRECOND( length >= 0 );
-  CLAW_PRECOND( length % 2 == 0 );
-  CLAW_PRECOND( sdl_sound::get_audio_format() == AUDIO_S16 );
-
-  claw::int_16* buffer = static_cast<claw::int_16*>(stream);
-  length /= 2;
-  const channel_attribute* attribute = static_cast<channel_attribute*>(attr);
-
-  const sdl_sound* sound = attribute->get_sample().m_sound;
-
-  const claw::math::coordinate_2d<double> ears =
-    sound->get_manager().get_ears_position();
-
-  const claw::math::coordinate_2d<double> pos =
-    attribute->get_effect().get_position();
+  m_effect = effect;
 
-  const double distance = std::abs(ears.x - pos.x) + std::abs(ears.y - pos.y);
-  const double tone_down =
-    sound->get_manager().get_volume_for_distance( distance );
+  const std::size_t v( m_voice );
 
-  if ( tone_down <= std::numeric_limits<double>::epsilon() )
-    std::fill( buffer, buffer + (unsigned int)length, 0 );
-  else if ( tone_down < 1.0 )
-    for (unsigned int i=0; i!=(unsigned)length; ++i)
-      buffer[i] = (claw::int_16)((double)buffer[i] * tone_down);
-} // sdl_sample::distance_tone_down()
+  if ( v != mixer::not_a_voice )
+    sdl_sound::get_mixer().set_effect( v, *this, m_effect, d );
+} // sdl_sample::set_effect()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Callback function applying the balance effect to a channel.
- * \param channel The channel receiving the effect.
- * \param stream (in/out) Sound data.
- * \param length The size of the stream.
- * \param attr (in) Channel attribute.
- * \pre attr != NULL.
+ * \brief Set the volume of the sample (for sound_manager only).
+ * \param v The volume.
  */
-void bear::audio::sdl_sample::balance
-(int channel, void* stream, int length, void* attr)
+void bear::audio::sdl_sample::set_volume( double v )
 {
-  CLAW_PRECOND( attr != NULL );
-  CLAW_PRECOND( length >= 0 );
-  CLAW_PRECOND( length % 2 == 0 );
-  CLAW_PRECOND( sdl_sound::get_audio_format() == AUDIO_S16 );
-
-  const channel_attribute* attribute = static_cast<channel_attribute*>(attr);
-
-  const sdl_sound* sound = attribute->get_sample().m_sound;
-
-  const claw::math::coordinate_2d<double> ears =
-    sound->get_manager().get_ears_position();
-
-  const claw::math::coordinate_2d<double> pos =
-    attribute->get_effect().get_position();
+  const std::size_t voice( m_voice );
 
-  const double distance = std::abs(ears.x - pos.x);
-  const double tone_down =
-    sound->get_manager().get_volume_for_distance( distance );
-
-  double left_volume;
-  double right_volume;
-
-  if ( ears.x < pos.x )
-    {
-      right_volume = 1;
-      left_volume = tone_down;
-    }
-  else
-    {
-      right_volume = tone_down;
-      left_volume = 1;
-    }
-
-  claw::int_16* buffer = static_cast<claw::int_16*>(stream);
-  length /= 2;
-
-  CLAW_PRECOND( length % 2 == 0 );
-
-  for ( int i=0; i!=length; i += 2 )
-    {
-      buffer[i] *= left_volume;
-      buffer[i+1] *= right_volume;
-    }
-} // sdl_sample::balance()
+  if ( voice != mixer::not_a_voice )
+    sdl_sound::get_mixer().set_volume( voice, *this, v );
+} // sdl_sample::set_volume()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Callback function changing the volume of a channel.
- * \param channel The channel receiving the effect.
- * \param stream (in/out) Sound data.
- * \param length The size of the stream.
- * \param attr (in) Channel attribute.
- * \pre attr != NULL.
- * \remark This method adjust the volume of the sample, independently of the
- *         global volume, actually stored in Mix_Volume().
+ * \brief Inform the sample that its voice reached its end (for mixer only).
  */
-void bear::audio::sdl_sample::volume
-(int channel, void* stream, int length, void* attr)
+void bear::audio::sdl_sample::voice_finished()
 {
-  CLAW_PRECOND( attr != NULL );
-  CLAW_PRECOND( length % 2 == 0 );
-  CLAW_PRECOND( sdl_sound::get_audio_format() == AUDIO_S16 );
-
-  claw::int_16* buffer = static_cast<claw::int_16*>(stream);
-  length /= 2;
-  const channel_attribute* attribute = static_cast<channel_attribute*>(attr);
+  m_voice = mixer::not_a_voice;
 
-  const double v = attribute->get_effect().get_volume();
-
-  if ( v <= std::numeric_limits<double>::epsilon() )
-    std::fill( buffer, buffer + (unsigned int)length, 0 );
-  else
-    for (unsigned int i=0; i!=(unsigned)length; ++i)
-      buffer[i] = (claw::int_16)((double)buffer[i] * v);
-} // sdl_sample::volume()
+  sample_finished();
+} // sdl_sample::voice_finished()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -403,110 +188,31 @@ void bear::audio::sdl_sample::volume
  */
 void bear::audio::sdl_sample::inside_play()
 {
-  if ( m_channel != -1 )
+  if ( m_voice != mixer::not_a_voice )
     stop();
 
-  if ( m_sound != NULL )
-    m_channel = m_sound->play(m_effect.get_loops());
-
-  if ( m_channel != -1 )
-    {
-      set_playing();
-
-      global_add_channel();
-      Mix_Volume
-        ( m_channel,
-          (int)(m_sound->get_manager().get_volume(this) * MIX_MAX_VOLUME) );
-
-      inside_set_effect();
-    }
-} // sdl_sample::inside_play()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Set the effect associated to a channel.
- * \pre m_channel >= 0
- * \pre s_playing_channels[channel]->is_empty() == false.
- * \post s_playing_channels[channel]->get_effect().get_position() == position.
- */
-void bear::audio::sdl_sample::inside_set_effect()
-{
-  CLAW_PRECOND( m_channel >= 0 );
-  CLAW_PRECOND( s_playing_channels[m_channel]->is_empty() == false );
-
-  s_playing_channels[m_channel]->set_effect( m_effect );
-
-  if ( m_effect.has_a_position() )
-    {
-      int ok;
-      ok = Mix_RegisterEffect
-        ( m_channel, distance_tone_down, NULL, s_playing_channels[m_channel] );
-
-      if (!ok)
-        claw::logger << claw::log_warning << "position effect distance: "
-                     << Mix_GetError() << std::endl;
+  if ( m_sound == NULL )
+    return;
 
-      ok = Mix_RegisterEffect
-        ( m_channel, balance, NULL, s_playing_channels[m_channel] );
+  mixer& m( sdl_sound::get_mixer() );
+  const sound_manager& manager( m_sound->get_manager() );
+  const double volume( manager.get_volume(this) );
 
-      if (!ok)
-        claw::logger << claw::log_warning << "position effect balance: "
-                     << Mix_GetError() << std::endl;
-    }
-
-  if ( m_effect.get_volume() != 1 )
+  if ( !m_sound->is_streamed() )
+    m_voice =
+      m.play
+      ( *this, manager, m_sound->get_samples(), m_sound->get_frame_count(),
+        m_effect, volume );
+  else
     {
-      int ok;
-      ok = Mix_RegisterEffect
-        ( m_channel, volume, NULL, s_playing_channels[m_channel] );
+      const ogg_stream::pointer stream( m_sound->new_stream() );
 
-      if (!ok)
-        claw::logger << claw::log_warning << "volume effect: "
-                     << Mix_GetError() << std::endl;
+      if ( stream )
+        m_voice = m.play( *this, manager, stream, m_effect, volume );
     }
-} // sdl_sample::inside_set_effect()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Associate the current instance to a channel in the common list.
- * \pre m_channel >= 0
- * \pre s_playing_channels[m_channel].is_empty().
- * \post &sdl_sample::s_playing_channels[m_channel].get_sound() == this.
- */
-void bear::audio::sdl_sample::global_add_channel()
-{
-  CLAW_PRECOND( m_channel >= 0 );
 
-  if ( (unsigned int)m_channel >= s_playing_channels.size() )
-    s_playing_channels.resize(m_channel+1, NULL);
+  if ( m_voice != mixer::not_a_voice )
+    set_playing();
   else
-    {
-      CLAW_PRECOND( s_playing_channels[m_channel] == NULL );
-    }
-
-  s_playing_channels[m_channel] = new channel_attribute;
-  s_playing_channels[m_channel]->set_sample(*this);
-} // sdl_sample::global_add_channel()
-
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Remove a finished channel from the playing list.
- * \pre m_channel >= 0
- * \post sdl_sample::s_playing_channels[channel]->is_empty() = true.
- * \post m_channels.find( channel ) == m_channels.end().
- */
-void bear::audio::sdl_sample::finished()
-{
-  CLAW_PRECOND( m_channel >= 0 );
-
-  if ( !Mix_UnregisterAllEffects(m_channel) )
-    claw::logger << claw::log_warning << "sdl_sample::finished(): "
-                 << Mix_GetError() << std::endl;
-
-  delete s_playing_channels[m_channel];
-  s_playing_channels[m_channel] = NULL;
-
-  m_channel = -1;
-
-  sample_finished();
-} // sdl_sample::finished()
+    sample_finished();
+} // sdl_sample::inside_play()
@@ -12,20 +12,35 @@
  * \author Julien Jorge
  */
 #include "audio/sdl_sound.hpp"
+
+#include "audio/decoder_pool.hpp"
+#include "audio/mixer.hpp"
 #include "audio/sdl_sample.hpp"
 #include "audio/sound_manager.hpp"
 
+#include "debug/profiler_zone.hpp"
+
 #include <SDL2/SDL.h>
 #include <claw/assert.hpp>
 #include <claw/exception.hpp>
 #include <claw/logger.hpp>
 
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <algorithm>
+
 /*----------------------------------------------------------------------------*/
 unsigned int bear::audio::sdl_sound::s_audio_rate = 44100;
 unsigned int bear::audio::sdl_sound::s_audio_format = AUDIO_S16;
 unsigned int bear::audio::sdl_sound::s_audio_channels = 2;
 unsigned int bear::audio::sdl_sound::s_audio_buffers = 1024;
-unsigned int bear::audio::sdl_sound::s_audio_mix_channels = 256;
+unsigned int bear::audio::sdl_sound::s_audio_mix_channels = 64;
+double bear::audio::sdl_sound::s_streaming_min_duration = 20;
+bear::audio::mixer* bear::audio::sdl_sound::s_mixer = NULL;
+bear::audio::decoder_pool* bear::audio::sdl_sound::s_decoder_pool = NULL;
+bear::audio::decoder_pool*
+bear::audio::sdl_sound::s_stream_decoder_pool = NULL;
+bool bear::audio::sdl_sound::s_offline = false;
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -33,21 +48,34 @@ unsigned int bear::audio::sdl_sound::s_audio_mix_channels = 256;
  * \param file The stream containing the wav file.
  * \param name The name of the sound resource.
  * \param owner The instance of sound_manager who stores me.
+ *
+ * The long Ogg Vorbis files, typically the musics, are kept encoded in memory
+ * and will be decoded progressively during their playback. The other sounds
+ * are fully decoded by the threads of the decoder pool. The duration of the
+ * files is read from their pages, without decoding them.
  */
 bear::audio::sdl_sound::sdl_sound
 ( std::istream& file, const std::string& name, sound_manager& owner )
-  : sound(name, owner), m_sound(NULL), m_raw_audio(NULL)
+  : sound(name, owner)
 {
+  CLAW_PRECOND( s_decoder_pool != NULL );
+
   file.seekg( 0, std::ios::end );
   std::streamoff file_size = file.tellg();
   file.seekg( 0, std::ios::beg );
 
-  char* buffer = new char[file_size];
-  file.read( buffer, file_size );
+  const ogg_stream::file_pointer content( new std::vector<char>(file_size) );
+
+  if ( file_size != 0 )
+    file.read( &(*content)[0], file_size );
 
-  m_loader =
-    new boost::thread
-    ( boost::bind( &sdl_sound::load_sound, this, buffer, file_size ) );
+  if ( ogg_stream::get_duration( content ) >= s_streaming_min_duration )
+    m_file = content;
+  else
+    {
+      m_sound = new decoded_sound( name, *content, s_audio_channels );
+      s_decoder_pool->push( boost::bind( &decoded_sound::decode, &*m_sound ) );
+    }
 } // sdl_sound::sdl_sound()
 
 /*----------------------------------------------------------------------------*/
@@ -55,24 +83,16 @@ bear::audio::sdl_sound::sdl_sound
  * \brief Copy constructor.
  * \param that The instance to copy from.
  * \param owner The instance of sound_manager who stores me.
+ *
+ * The encoded file or the decoded frames are shared with that, thus the copy
+ * does not wait for the end of the decoding.
  */
 bear::audio::sdl_sound::sdl_sound
 ( const sdl_sound& that, sound_manager& owner )
-  : sound(that.get_sound_name(), owner), m_sound(NULL), m_loader(NULL)
+  : sound(that.get_sound_name(), owner), m_sound(that.m_sound),
+    m_file(that.m_file)
 {
-  const Uint32 buffer_length( that.m_sound->alen );
-  m_raw_audio = new Uint8[buffer_length];
-  
-  std::copy
-    ( that.m_sound->abuf, that.m_sound->abuf + buffer_length, m_raw_audio );
-  
-  m_sound = Mix_QuickLoad_RAW( m_raw_audio, buffer_length );
 
-  if (!m_sound)
-    {
-      delete[] m_raw_audio;
-      throw claw::exception( Mix_GetError() );
-    }
 } // sdl_sound::sdl_sound()
 
 /*----------------------------------------------------------------------------*/
@@ -81,13 +101,10 @@ bear::audio::sdl_sound::sdl_sound
  */
 bear::audio::sdl_sound::~sdl_sound()
 {
-  ensure_loaded();
-
-  delete m_loader;
-
-  Mix_FreeChunk( m_sound );
-
-  delete[] m_raw_audio;
+  // The decoder pool uses the decoded sound, we must not release it before the
+  // end of its decoding.
+  if ( m_sound != NULL )
+    m_sound->wait();
 } // sdl_sound::~sdl_sound()
 
 /*----------------------------------------------------------------------------*/
@@ -101,23 +118,61 @@ bear::audio::sample* bear::audio::sdl_sound::new_sample()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Start to play the sound.
- * \param loops Number of loops, 0 for infinite.
- * \return The channel in which the sound is played.
+ * \brief Tell if the sound is decoded progressively during its playback.
+ */
+bool bear::audio::sdl_sound::is_streamed() const
+{
+  return m_file.get() != NULL;
+} // sdl_sound::is_streamed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a decoder of the sound.
+ * \pre is_streamed()
+ * \return The decoder, NULL if it can not be created.
+ */
+bear::audio::ogg_stream::pointer bear::audio::sdl_sound::new_stream() const
+{
+  CLAW_PRECOND( is_streamed() );
+
+  ogg_stream::pointer result;
+
+  try
+    {
+      result.reset( new ogg_stream( m_file, s_audio_rate, s_audio_channels ) );
+    }
+  catch( const std::exception& e )
+    {
+      claw::logger << claw::log_error << "sdl_sound::new_stream(): "
+                   << e.what() << std::endl;
+    }
+
+  return result;
+} // sdl_sound::new_stream()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the interleaved stereo frames of the sound.
+ * \pre !is_streamed()
  */
-int bear::audio::sdl_sound::play( unsigned int loops ) const
+const claw::int_16* bear::audio::sdl_sound::get_samples() const
 {
-  ensure_loaded();
+  CLAW_PRECOND( !is_streamed() );
 
-  const int sdl_loops((int)loops - 1);
-  const int channel = Mix_PlayChannel(-1, m_sound, sdl_loops);
+  return m_sound->get_samples();
+} // sdl_sound::get_samples()
 
-  if (channel == -1)
-    claw::logger << claw::log_warning << "sdl_sound::play(): "
-                 << Mix_GetError() << std::endl;
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of frames in the sound.
+ * \pre !is_streamed()
+ */
+std::size_t bear::audio::sdl_sound::get_frame_count() const
+{
+  CLAW_PRECOND( !is_streamed() );
 
-  return channel;
-} // sdl_sound::play()
+  return m_sound->get_frame_count();
+} // sdl_sound::get_frame_count()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -125,22 +180,23 @@ int bear::audio::sdl_sound::play( unsigned int loops ) const
  */
 bool bear::audio::sdl_sound::initialize()
 {
-  bool result = false;
+  return open_audio( false );
+} // sdl_sound::initialize()
 
-  if ( SDL_InitSubSystem(SDL_INIT_AUDIO) != 0 )
-    claw::logger << claw::log_error << SDL_GetError() << std::endl;
-  else if ( Mix_OpenAudio(s_audio_rate, s_audio_format, s_audio_channels,
-                          s_audio_buffers) != 0 )
-    claw::logger << claw::log_error << Mix_GetError() << std::endl;
-  else
-    {
-      result = true;
-      Mix_AllocateChannels(s_audio_mix_channels);
-      Mix_ChannelFinished(sdl_sample::channel_finished);
-    }
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Initialize the SDL without sending the mixed samples to an audio
+ *        device. The samples are mixed only when render() is called.
+ */
+bool bear::audio::sdl_sound::initialize_offline()
+{
+  // The dummy driver of the SDL discards its output, without requiring an
+  // audio device. Opening it lets SDL_mixer convert the sounds in the format
+  // of the output.
+  SDL_setenv( "SDL_AUDIODRIVER", "dummy", 1 );
 
-  return result;
-} // sdl_sound::initialize()
+  return open_audio( true );
+} // sdl_sound::initialize_offline()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -148,9 +204,51 @@ bool bear::audio::sdl_sound::initialize()
  */
 void bear::audio::sdl_sound::release()
 {
+  // The mixer is uninstalled first since it pushes the decoding of the
+  // streams in their pool.
+  if ( (s_mixer != NULL) && !s_offline )
+    Mix_HookMusic( NULL, NULL );
+
+  delete s_stream_decoder_pool;
+  s_stream_decoder_pool = NULL;
+
+  // The pending decodings are done before the destruction of the pool, thus
+  // the sounds still alive remain usable.
+  delete s_decoder_pool;
+  s_decoder_pool = NULL;
+
+  delete s_mixer;
+  s_mixer = NULL;
+
   SDL_QuitSubSystem(SDL_INIT_AUDIO);
 } // sdl_sound::release()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mix the next frames of the output in a buffer.
+ * \param output (out) The buffer receiving the interleaved frames.
+ * \param frames The number of frames to mix.
+ * \pre The sound system has been initialized with initialize_offline().
+ */
+void bear::audio::sdl_sound::render( claw::int_16* output, std::size_t frames )
+{
+  BEAR_PROFILE_ZONE( "sdl_sound::render" );
+
+  CLAW_PRECOND( s_mixer != NULL );
+  CLAW_PRECOND( s_offline );
+
+  s_mixer->mix( output, frames );
+} // sdl_sound::render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the sample rate of the output audio stream.
+ */
+unsigned int bear::audio::sdl_sound::get_audio_rate()
+{
+  return s_audio_rate;
+} // sdl_sound::get_audio_rate()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the format of the output audio stream.
@@ -162,37 +260,93 @@ unsigned int bear::audio::sdl_sound::get_audio_format()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Loads the sound from a given data.
- * \param buffer The buffer from which the sound is read. It will be deleted by
- *        the end of the call.
- * \param buffer_length The length of buffer.
+ * \brief Get the mixer of the samples.
+ * \pre The sound system is initialized.
  */
-void bear::audio::sdl_sound::load_sound
-( char* buffer, std::size_t buffer_length )
+bear::audio::mixer& bear::audio::sdl_sound::get_mixer()
 {
-  SDL_RWops* rw( SDL_RWFromMem(buffer, buffer_length) );
+  CLAW_PRECOND( s_mixer != NULL );
 
-  if (rw)
-    m_sound = Mix_LoadWAV_RW( rw, 1 );
+  return *s_mixer;
+} // sdl_sound::get_mixer()
 
-  delete[] buffer;
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Open the audio device and create the mixer.
+ * \param offline Tell if the mixer is run by calls to render() instead of
+ *        being installed in the audio device.
+ */
+bool bear::audio::sdl_sound::open_audio( bool offline )
+{
+  bool result = false;
 
-  if (!m_sound)
+  if ( SDL_InitSubSystem(SDL_INIT_AUDIO) != 0 )
+    claw::logger << claw::log_error << SDL_GetError() << std::endl;
+  else if ( Mix_OpenAudio(s_audio_rate, s_audio_format, s_audio_channels,
+                          s_audio_buffers) != 0 )
+    claw::logger << claw::log_error << Mix_GetError() << std::endl;
+  else
     {
-      claw::logger << claw::log_error << Mix_GetError() << std::endl;
-      throw claw::exception( Mix_GetError() );
+      int rate;
+      Uint16 format;
+      int channels;
+      Mix_QuerySpec( &rate, &format, &channels );
+
+      if ( (format != s_audio_format)
+           || ((unsigned int)channels != s_audio_channels) )
+        {
+          claw::logger << claw::log_error << "Unsupported audio output: "
+                       << channels << " channels, format " << format
+                       << std::endl;
+          Mix_CloseAudio();
+        }
+      else
+        {
+          result = true;
+          s_audio_rate = rate;
+          s_offline = offline;
+
+          // The samples are mixed by the engine. The channels of SDL_mixer
+          // are not used and our mixer is installed as the music hook, which
+          // is called first when the output buffer is filled.
+          Mix_AllocateChannels(0);
+
+          // Keep a core for the game and the rendering.
+          const unsigned int cores( boost::thread::hardware_concurrency() );
+          s_decoder_pool =
+            new decoder_pool( std::max( 1u, std::min( 4u, cores - 1 ) ) );
+
+          // The offline mixer decodes the streams itself, such that the
+          // rendering does not depend on the speed of the decoder pool.
+          if ( !offline )
+            s_stream_decoder_pool = new decoder_pool(1);
+
+          s_mixer =
+            new mixer( rate, s_audio_mix_channels, s_stream_decoder_pool );
+
+          if ( !offline )
+            Mix_HookMusic( mix_voices, s_mixer );
+        }
     }
-} // sdl_sound::load_sound()
+
+  return result;
+} // sdl_sound::open_audio()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Ensures the sound has been fully loaded. The function will force the
- *        loading to finish if the sound has not been loaded yet.
+ * \brief Callback function filling the output buffer with the mixed samples.
+ * \param m (in) The mixer.
+ * \param stream (out) The output buffer.
+ * \param length The size of the stream.
  */
-void bear::audio::sdl_sound::ensure_loaded() const
+void bear::audio::sdl_sound::mix_voices( void* m, Uint8* stream, int length )
 {
-  if ( m_loader == NULL )
-    return;
+  BEAR_PROFILE_ZONE( "sdl_sound::mix_voices" );
+
+  CLAW_PRECOND( m != NULL );
+  CLAW_PRECOND( length >= 0 );
 
-  m_loader->join();
-} // sdl_sound::ensure_loaded()
+  static_cast<mixer*>(m)->mix
+    ( reinterpret_cast<claw::int_16*>(stream),
+      length / (s_audio_channels * sizeof(claw::int_16)) );
+} // sdl_sound::mix_voices()
@@ -31,7 +31,7 @@ bool bear::audio::sound_manager::s_initialized = false;
 bear::audio::sound_manager::sound_manager()
   : m_ears_position(0, 0), m_current_music(NULL), m_sound_volume(1),
     m_music_volume(1), m_silence_distance(1200), m_full_volume_distance(200),
-    m_distance_unit(1)
+    m_distance_unit(1), m_music_crossfade_duration(0)
 {
 
 } // sound_manager::sound_manager()
@@ -179,12 +179,15 @@ std::size_t bear::audio::sound_manager::play_music
 {
   CLAW_PRECOND( sound_exists(name) );
 
+  const bool crossfade
+    ( (m_current_music != NULL) && (m_music_crossfade_duration > 0) );
+
   if (m_current_music != NULL)
     {
       sound_effect e(m_current_music->get_effect());
       m_muted_musics.push_front( muted_music_data(m_current_music, e) );
       e.set_volume(0);
-      m_current_music->set_effect(e);
+      m_current_music->set_effect(e, m_music_crossfade_duration);
     }
 
   m_current_music = m_sounds[name]->new_sample();
@@ -197,8 +200,19 @@ std::size_t bear::audio::sound_manager::play_music
   m_samples[m_current_music] = true;
 
   sound_effect e(loops);
+
+  if ( crossfade )
+    e.set_volume(0);
+
   m_current_music->play(e);
 
+  if ( crossfade && (m_current_music != NULL)
+       && (m_current_music->get_id() == result) )
+    {
+      e.set_volume(1);
+      m_current_music->set_effect(e, m_music_crossfade_duration);
+    }
+
   return result;
 } // sound_manager::play_music()
 
@@ -373,7 +387,8 @@ void bear::audio::sound_manager::sample_finished( sample* s )
       else
         {
           m_current_music = m_muted_musics.front().first;
-          m_current_music->set_effect( m_muted_musics.front().second );
+          m_current_music->set_effect
+            ( m_muted_musics.front().second, m_music_crossfade_duration );
           m_muted_musics.pop_front();
         }
     }
@@ -446,6 +461,17 @@ void bear::audio::sound_manager::initialize()
   s_initialized = sdl_sound::initialize();
 } // sound_manager::initialize()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Initialize the sound system without an audio device. The samples are
+ *        mixed only when render() is called, as fast as the caller wants, thus
+ *        the output can be saved or measured.
+ */
+void bear::audio::sound_manager::initialize_offline()
+{
+  s_initialized = sdl_sound::initialize_offline();
+} // sound_manager::initialize_offline()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Close the sound system.
@@ -456,6 +482,30 @@ void bear::audio::sound_manager::release()
   s_initialized = false;
 } // sound_manager::release()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mix the next frames of the samples played by all the managers.
+ * \param output (out) The buffer receiving the interleaved stereo frames.
+ * \param frames The number of frames to mix.
+ * \pre The sound system has been initialized with initialize_offline().
+ */
+void bear::audio::sound_manager::render
+( claw::int_16* output, std::size_t frames )
+{
+  CLAW_PRECOND( s_initialized );
+
+  sdl_sound::render( output, frames );
+} // sound_manager::render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the sample rate of the output of the sound system.
+ */
+unsigned int bear::audio::sound_manager::get_output_rate()
+{
+  return sdl_sound::get_audio_rate();
+} // sound_manager::get_output_rate()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Remove a music from m_muted_musics.
@@ -558,6 +608,28 @@ double bear::audio::sound_manager::get_distance_unit() const
   return m_distance_unit;
 } // sound_manager::get_distance_unit()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the duration of the transition when a music is muted by another
+ *        one, or restored when the other one ends.
+ * \param d The duration, in seconds. Zero means that the musics are muted and
+ *        restored immediately.
+ */
+void bear::audio::sound_manager::set_music_crossfade_duration( double d )
+{
+  m_music_crossfade_duration = std::max( 0.0, d );
+} // sound_manager::set_music_crossfade_duration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Returns the duration of the transition when a music is muted by
+ *        another one, or restored when the other one ends.
+ */
+double bear::audio::sound_manager::get_music_crossfade_duration() const
+{
+  return m_music_crossfade_duration;
+} // sound_manager::get_music_crossfade_duration()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Computes the tone down at a given distance of the ears.
@@ -0,0 +1,139 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::audio::wav_writer class.
+ * \author Julien Jorge
+ */
+#include "audio/wav_writer.hpp"
+
+#include <claw/assert.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param output The stream in which the file is written.
+ * \param rate The sample rate of the frames.
+ * \param channels The number of channels in a frame.
+ */
+bear::audio::wav_writer::wav_writer
+( std::ostream& output, unsigned int rate, unsigned int channels )
+  : m_output(output), m_start(output.tellp()), m_rate(rate),
+    m_channels(channels), m_data_size(0), m_closed(false)
+{
+  CLAW_PRECOND( channels > 0 );
+
+  write_header();
+} // wav_writer::wav_writer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The writer is closed if it is not already.
+ */
+bear::audio::wav_writer::~wav_writer()
+{
+  close();
+} // wav_writer::~wav_writer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Append some frames to the file.
+ * \param frames The interleaved samples of the frames.
+ * \param count The number of frames to write.
+ */
+void bear::audio::wav_writer::write
+( const claw::int_16* frames, std::size_t count )
+{
+  CLAW_PRECOND( !m_closed );
+
+  const std::size_t samples( count * m_channels );
+  m_buffer.resize( samples * sizeof(claw::int_16) );
+
+  for ( std::size_t i(0); i != samples; ++i )
+    {
+      const claw::u_int_16 s( frames[i] );
+      m_buffer[2 * i] = s & 0xFF;
+      m_buffer[2 * i + 1] = s >> 8;
+    }
+
+  m_output.write( m_buffer.data(), m_buffer.size() );
+  m_data_size += m_buffer.size();
+} // wav_writer::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the sizes of the file in its header. No frame can be added
+ *        after this call.
+ */
+void bear::audio::wav_writer::close()
+{
+  if ( m_closed )
+    return;
+
+  m_closed = true;
+
+  const std::streampos end( m_output.tellp() );
+
+  m_output.seekp( m_start + std::streamoff(4) );
+  write_u_int_32( 36 + m_data_size );
+  m_output.seekp( m_start + std::streamoff(40) );
+  write_u_int_32( m_data_size );
+
+  m_output.seekp( end );
+  m_output.flush();
+} // wav_writer::close()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the header of the file, with empty sizes.
+ */
+void bear::audio::wav_writer::write_header()
+{
+  const unsigned int frame_size( m_channels * sizeof(claw::int_16) );
+
+  m_output.write( "RIFF", 4 );
+  write_u_int_32( 0 );
+  m_output.write( "WAVE", 4 );
+
+  m_output.write( "fmt ", 4 );
+  write_u_int_32( 16 );
+  write_u_int_16( 1 ); // PCM
+  write_u_int_16( m_channels );
+  write_u_int_32( m_rate );
+  write_u_int_32( m_rate * frame_size );
+  write_u_int_16( frame_size );
+  write_u_int_16( 8 * sizeof(claw::int_16) );
+
+  m_output.write( "data", 4 );
+  write_u_int_32( 0 );
+} // wav_writer::write_header()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a 16 bits little endian integer in the file.
+ * \param v The value to write.
+ */
+void bear::audio::wav_writer::write_u_int_16( claw::u_int_16 v )
+{
+  const char bytes[] = { char(v & 0xFF), char(v >> 8) };
+  m_output.write( bytes, sizeof(bytes) );
+} // wav_writer::write_u_int_16()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a 32 bits little endian integer in the file.
+ * \param v The value to write.
+ */
+void bear::audio::wav_writer::write_u_int_32( claw::u_int_32 v )
+{
+  const char bytes[] =
+    { char(v & 0xFF), char((v >> 8) & 0xFF), char((v >> 16) & 0xFF),
+      char(v >> 24) };
+  m_output.write( bytes, sizeof(bytes) );
+} // wav_writer::write_u_int_32()
@@ -0,0 +1,90 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The frames of a sound decoded in memory.
+ * \author Julien Jorge
+ */
+#ifndef __AUDIO_DECODED_SOUND_HPP__
+#define __AUDIO_DECODED_SOUND_HPP__
+
+#include "audio/class_export.hpp"
+
+#include <SDL2/SDL_mixer.h>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <claw/non_copyable.hpp>
+#include <claw/types.hpp>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace audio
+  {
+    /**
+     * \brief The frames of a sound decoded in memory.
+     *
+     * The instance is created with the encoded file and the decoding is done
+     * later by a call to decode(), typically in a thread of the decoder_pool.
+     * The accessors to the frames wait for the end of the decoding, thus the
+     * instance can be used as soon as it is created.
+     *
+     * The instance is shared by the copies of the sound, such that the frames
+     * are decoded and stored only once.
+     *
+     * \author Julien Jorge
+     */
+    class AUDIO_EXPORT decoded_sound:
+      public claw::pattern::non_copyable
+    {
+    public:
+      decoded_sound
+      ( const std::string& name, std::vector<char>& file,
+        unsigned int channels );
+      ~decoded_sound();
+
+      void decode();
+      void wait() const;
+
+      const claw::int_16* get_samples() const;
+      std::size_t get_frame_count() const;
+      double get_decoding_duration() const;
+
+    private:
+      /** \brief The name of the sound, for the logs. */
+      const std::string m_name;
+
+      /** \brief The encoded file, released once decoded. */
+      std::vector<char> m_file;
+
+      /** \brief The number of channels in the decoded frames. */
+      const unsigned int m_channels;
+
+      /** \brief The sound allocated by SDL_mixer, NULL if the file could not
+          be decoded. */
+      Mix_Chunk* m_sound;
+
+      /** \brief The time spent in the decoding, in milliseconds. */
+      double m_decoding_duration;
+
+      /** \brief Tell if the decoding is done. */
+      bool m_ready;
+
+      /** \brief The mutex preventing simultaneous accesses to m_ready. */
+      mutable boost::mutex m_mutex;
+
+      /** \brief The condition signaled when the decoding is done. */
+      mutable boost::condition_variable m_condition;
+
+    }; // class decoded_sound
+  } // namespace audio
+} // namespace bear
+
+#endif // __AUDIO_DECODED_SOUND_HPP__
@@ -0,0 +1,76 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A pool of threads decoding the sounds.
+ * \author Julien Jorge
+ */
+#ifndef __AUDIO_DECODER_POOL_HPP__
+#define __AUDIO_DECODER_POOL_HPP__
+
+#include "audio/class_export.hpp"
+
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <claw/non_copyable.hpp>
+#include <deque>
+
+namespace bear
+{
+  namespace audio
+  {
+    /**
+     * \brief A pool of threads decoding the sounds.
+     *
+     * The tasks are executed in the order in which they are pushed, by a fixed
+     * number of threads, such that loading a lot of sounds at once does not
+     * create as many threads.
+     *
+     * \author Julien Jorge
+     */
+    class AUDIO_EXPORT decoder_pool:
+      public claw::pattern::non_copyable
+    {
+    public:
+      /** \brief The type of the tasks executed by the threads. */
+      typedef boost::function<void ()> task_type;
+
+    public:
+      explicit decoder_pool( std::size_t thread_count );
+      ~decoder_pool();
+
+      void push( const task_type& task );
+
+    private:
+      void run();
+
+    private:
+      /** \brief The tasks waiting for a thread. */
+      std::deque<task_type> m_tasks;
+
+      /** \brief Tell the threads to stop once there is no more tasks. */
+      bool m_stop;
+
+      /** \brief The mutex preventing simultaneous accesses to the tasks. */
+      boost::mutex m_mutex;
+
+      /** \brief The condition signaled when a task is added or when the
+          threads must stop. */
+      boost::condition_variable m_condition;
+
+      /** \brief The threads executing the tasks. */
+      boost::thread_group m_threads;
+
+    }; // class decoder_pool
+  } // namespace audio
+} // namespace bear
+
+#endif // __AUDIO_DECODER_POOL_HPP__
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <claw/types.hpp>
+
+#include <cstddef>
+
+namespace bear
+{
+  namespace audio
+  {
+    namespace detail
+    {
+      void apply_stereo_gain
+      ( claw::int_16* samples, std::size_t frames, double left_from,
+        double right_from, double left_to, double right_to );
+    }
+  }
+}
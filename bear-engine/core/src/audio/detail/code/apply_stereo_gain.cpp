@@ -0,0 +1,146 @@
+#include "audio/detail/apply_stereo_gain.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace bear
+{
+  namespace audio
+  {
+    namespace detail
+    {
+      namespace
+      {
+        /** \brief The gains are ramped with 30 bits of precision, such that
+            the step between two frames is not lost on long buffers. */
+        const int ramp_shift( 30 );
+
+        /** \brief The gains are applied as 15 bits fixed point values. */
+        const int gain_shift( 15 );
+
+        /**
+         * \brief Converts a gain in [0, 1] into the fixed point representation
+         *        used for the ramp.
+         * \param g The gain to convert.
+         */
+        claw::int_32 to_ramp_value( double g )
+        {
+          return (claw::int_32)
+            ( std::max( 0.0, std::min( 1.0, g ) ) * (1 << ramp_shift) );
+        }
+
+        /**
+         * \brief Applies a gain to a sample, with saturation.
+         * \param s The sample.
+         * \param g The ramp value of the gain.
+         */
+        claw::int_16 apply_gain( claw::int_16 s, claw::int_32 g )
+        {
+          const claw::int_32 gain
+            ( std::min<claw::int_32>
+              ( g >> (ramp_shift - gain_shift),
+                std::numeric_limits<claw::int_16>::max() ) );
+          const claw::int_32 v
+            ( ( (claw::int_32)s * gain + (1 << (gain_shift - 1)) )
+              >> gain_shift );
+
+          return std::max<claw::int_32>
+            ( std::numeric_limits<claw::int_16>::min(),
+              std::min<claw::int_32>
+              ( std::numeric_limits<claw::int_16>::max(), v ) );
+        }
+      }
+    }
+  }
+}
+
+/**
+ * \brief Multiplies the samples of an interleaved stereo buffer by a gain per
+ *        channel, moving linearly from a gain to another along the buffer.
+ * \param samples The samples to modify.
+ * \param frames The number of stereo frames in samples.
+ * \param left_from The gain of the left channel at the first frame.
+ * \param right_from The gain of the right channel at the first frame.
+ * \param left_to The gain of the left channel after the last frame.
+ * \param right_to The gain of the right channel after the last frame.
+ *
+ * The gains are in [0, 1] and are applied in 16 bits fixed point arithmetic,
+ * with saturation.
+ */
+void bear::audio::detail::apply_stereo_gain
+( claw::int_16* samples, std::size_t frames, double left_from,
+  double right_from, double left_to, double right_to )
+{
+  if ( frames == 0 )
+    return;
+
+  claw::int_32 left( to_ramp_value( left_from ) );
+  claw::int_32 right( to_ramp_value( right_from ) );
+  const claw::int_32 left_step
+    ( (claw::int_32)
+      ( ( (double)to_ramp_value( left_to ) - left ) / frames ) );
+  const claw::int_32 right_step
+    ( (claw::int_32)
+      ( ( (double)to_ramp_value( right_to ) - right ) / frames ) );
+
+  std::size_t i(0);
+
+#ifdef __SSE2__
+  // Four frames are processed at once. The gains of the frames are kept in
+  // two vectors of 32 bits values, interleaved like the samples.
+  __m128i gain_low
+    ( _mm_set_epi32
+      ( right + right_step, left + left_step, right, left ) );
+  __m128i gain_high
+    ( _mm_set_epi32
+      ( right + 3 * right_step, left + 3 * left_step, right + 2 * right_step,
+        left + 2 * left_step ) );
+  const __m128i step
+    ( _mm_set_epi32
+      ( 4 * right_step, 4 * left_step, 4 * right_step, 4 * left_step ) );
+  const __m128i rounding( _mm_set1_epi32( 1 << (gain_shift - 1) ) );
+
+  for ( ; frames - i >= 4; i += 4 )
+    {
+      __m128i* const p( reinterpret_cast<__m128i*>(samples + 2 * i) );
+      const __m128i s( _mm_loadu_si128( p ) );
+
+      // The gains never exceed 1 << gain_shift, which is saturated to the
+      // largest 16 bits value by the pack.
+      const __m128i g
+        ( _mm_packs_epi32
+          ( _mm_srai_epi32( gain_low, ramp_shift - gain_shift ),
+            _mm_srai_epi32( gain_high, ramp_shift - gain_shift ) ) );
+
+      const __m128i low( _mm_mullo_epi16( s, g ) );
+      const __m128i high( _mm_mulhi_epi16( s, g ) );
+
+      const __m128i v_low
+        ( _mm_srai_epi32
+          ( _mm_add_epi32( _mm_unpacklo_epi16( low, high ), rounding ),
+            gain_shift ) );
+      const __m128i v_high
+        ( _mm_srai_epi32
+          ( _mm_add_epi32( _mm_unpackhi_epi16( low, high ), rounding ),
+            gain_shift ) );
+
+      _mm_storeu_si128( p, _mm_packs_epi32( v_low, v_high ) );
+
+      gain_low = _mm_add_epi32( gain_low, step );
+      gain_high = _mm_add_epi32( gain_high, step );
+    }
+
+  left += (claw::int_32)i * left_step;
+  right += (claw::int_32)i * right_step;
+#endif
+
+  for ( ; i != frames; ++i, left += left_step, right += right_step )
+    {
+      samples[2 * i] = apply_gain( samples[2 * i], left );
+      samples[2 * i + 1] = apply_gain( samples[2 * i + 1], right );
+    }
+}
@@ -0,0 +1,249 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The mixer of the samples played by the engine.
+ * \author Julien Jorge
+ */
+#ifndef __AUDIO_MIXER_HPP__
+#define __AUDIO_MIXER_HPP__
+
+#include "audio/sound_effect.hpp"
+
+#include "audio/class_export.hpp"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <claw/non_copyable.hpp>
+#include <claw/types.hpp>
+#include <vector>
+
+namespace bear
+{
+  namespace audio
+  {
+    class decoder_pool;
+    class ogg_stream;
+    class sdl_sample;
+    class sound_manager;
+
+    /**
+     * \brief The mixer combines the voices of the samples in the output
+     *        buffer.
+     *
+     * There is no limit on the number of voices played at once. Each time a
+     * buffer is mixed, the voices are sorted according to their audibility,
+     * computed from their volume and their distance to the ears. Only the most
+     * audible ones are actually mixed, the other voices are virtual: they keep
+     * progressing in their samples without being heard, such that they can
+     * resume seamlessly when they become audible again.
+     *
+     * The frames of a voice are either read from a sound fully decoded in
+     * memory, or read from a stream decoded ahead by the decoder pool. The
+     * mixer only asks the pool to decode the next frames of the streams, thus
+     * the decoding does not hold the mutex of the mixer.
+     *
+     * The output is made of interleaved 16 bits stereo frames.
+     *
+     * \author Julien Jorge
+     */
+    class AUDIO_EXPORT mixer:
+      public claw::pattern::non_copyable
+    {
+    private:
+      /** \brief A sample played by the mixer. */
+      struct voice
+      {
+        /** \brief The sample playing this voice, NULL if the voice is not
+            used. */
+        sdl_sample* owner;
+
+        /** \brief The manager giving the position of the ears. */
+        const sound_manager* manager;
+
+        /** \brief The frames of the sound, if it is decoded in memory. */
+        const claw::int_16* samples;
+
+        /** \brief The number of frames in samples. */
+        std::size_t frames;
+
+        /** \brief The index of the next frame to play in samples. */
+        std::size_t position;
+
+        /** \brief The decoder of the sound, if it is streamed. It is shared
+            with the decoder pool while frames are decoded. */
+        boost::shared_ptr<ogg_stream> stream;
+
+        /** \brief How many times the sound must be replayed when reaching its
+            end. A negative value means forever. */
+        int loops;
+
+        /** \brief The effect applied to the voice. */
+        sound_effect effect;
+
+        /** \brief The current volume of the effect, moving toward the volume
+            of the effect. */
+        double effect_volume;
+
+        /** \brief How much effect_volume changes for each frame. Zero means
+            that the volume is reached in one buffer. */
+        double effect_volume_step;
+
+        /** \brief The volume of the voice, set by the sound_manager. */
+        double volume;
+
+        /** \brief Tell if the voice is paused. */
+        bool paused;
+
+        /** \brief Tell if the voice has reached its end. */
+        bool finished;
+
+        /** \brief The duration of the fade out, in frames. Zero if the voice
+            is not fading out. */
+        std::size_t fade_length;
+
+        /** \brief The number of frames remaining before the end of the fade
+            out. */
+        std::size_t fade_remaining;
+
+        /** \brief Tell if the gains have been computed at least once. */
+        bool has_gains;
+
+        /** \brief The gain applied to the left channel at the end of the last
+            mixed buffer, from which the gain of the next buffer starts. */
+        double left_gain;
+
+        /** \brief The gain applied to the right channel at the end of the last
+            mixed buffer. */
+        double right_gain;
+
+      }; // struct voice
+
+      /** \brief A voice waiting to be mixed. */
+      struct candidate
+      {
+        /** \brief The index of the voice. */
+        std::size_t index;
+
+        /** \brief How loud the voice is in the buffer. */
+        double audibility;
+
+        /** \brief The gain of the left channel at the end of the buffer. */
+        double left;
+
+        /** \brief The gain of the right channel at the end of the buffer. */
+        double right;
+
+      }; // struct candidate
+
+    public:
+      /** \brief The value returned when no voice is available. */
+      static const std::size_t not_a_voice;
+
+    public:
+      mixer
+      ( unsigned int rate, unsigned int max_mixed_voices,
+        decoder_pool* pool );
+
+      std::size_t play
+      ( sdl_sample& owner, const sound_manager& manager,
+        const claw::int_16* samples, std::size_t frames,
+        const sound_effect& effect, double volume );
+      std::size_t play
+      ( sdl_sample& owner, const sound_manager& manager,
+        const boost::shared_ptr<ogg_stream>& stream,
+        const sound_effect& effect, double volume );
+      void stop( std::size_t v, const sdl_sample& owner );
+      void fade_out( std::size_t v, const sdl_sample& owner, double d );
+      void pause( std::size_t v, const sdl_sample& owner );
+      void resume( std::size_t v, const sdl_sample& owner );
+
+      void set_effect
+      ( std::size_t v, const sdl_sample& owner, const sound_effect& effect,
+        double d = 0 );
+      void set_volume( std::size_t v, const sdl_sample& owner, double volume );
+
+      void mix( claw::int_16* output, std::size_t frames );
+
+      std::size_t get_voice_count() const;
+      std::size_t get_mixed_voice_count() const;
+
+    private:
+      std::size_t new_voice
+      ( sdl_sample& owner, const sound_manager& manager,
+        const sound_effect& effect, double volume );
+
+      void select_voices( std::size_t frames );
+      std::size_t mix_voices( std::size_t frames );
+      void mix_voice
+      ( voice& v, std::size_t frames, double left, double right );
+      void notify_finished();
+
+      void release( std::size_t v );
+      bool is_owned_by( std::size_t v, const sdl_sample& owner ) const;
+
+      std::size_t
+      read_frames( voice& v, claw::int_16* out, std::size_t frames );
+      std::size_t
+      read_stream( voice& v, claw::int_16* out, std::size_t frames );
+      void request_frames( const voice& v );
+
+      static std::size_t
+      read_memory( voice& v, claw::int_16* out, std::size_t frames );
+      static double get_fade_gain( const voice& v, std::size_t frames );
+      static double get_effect_volume( const voice& v, std::size_t frames );
+      static void compute_gains( const voice& v, double& left, double& right );
+      static bool
+      is_more_audible( const candidate& a, const candidate& b );
+
+    private:
+      /** \brief The sample rate of the output. */
+      const unsigned int m_rate;
+
+      /** \brief The maximum number of voices actually mixed in a buffer. */
+      const unsigned int m_max_mixed_voices;
+
+      /** \brief The pool decoding the frames of the streams. If NULL, the
+          frames are decoded during the mix. */
+      decoder_pool* const m_decoder_pool;
+
+      /** \brief The voices, used or not. */
+      std::vector<voice> m_voices;
+
+      /** \brief The indices of the unused entries of m_voices. */
+      std::vector<std::size_t> m_free_voices;
+
+      /** \brief The number of used voices. */
+      std::size_t m_voice_count;
+
+      /** \brief The number of voices mixed in the last buffer. */
+      std::size_t m_mixed_voice_count;
+
+      /** \brief The voices to mix in the current buffer. */
+      std::vector<candidate> m_candidates;
+
+      /** \brief The voices that reached their end in the current buffer. */
+      std::vector<std::size_t> m_finished;
+
+      /** \brief The sum of the mixed voices. */
+      std::vector<claw::int_32> m_accumulator;
+
+      /** \brief The frames of the voice being mixed. */
+      std::vector<claw::int_16> m_voice_buffer;
+
+      /** \brief The mutex preventing the modification of the voices while
+          they are mixed. It is recursive since the samples can be stopped or
+          played again when they are notified of their end. */
+      mutable boost::recursive_mutex m_mutex;
+
+    }; // class mixer
+  } // namespace audio
+} // namespace bear
+
+#endif // __AUDIO_MIXER_HPP__
@@ -0,0 +1,155 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A decoder of Ogg Vorbis files, producing the frames progressively.
+ * \author Julien Jorge
+ */
+#ifndef __AUDIO_OGG_STREAM_HPP__
+#define __AUDIO_OGG_STREAM_HPP__
+
+#include "audio/class_export.hpp"
+
+#include <SDL2/SDL.h>
+#include <boost/shared_ptr.hpp>
+#include <claw/non_copyable.hpp>
+#include <claw/types.hpp>
+#include <atomic>
+#include <vector>
+#include <vorbis/vorbisfile.h>
+
+namespace bear
+{
+  namespace audio
+  {
+    /**
+     * \brief A decoder of Ogg Vorbis files, producing the frames
+     *        progressively.
+     *
+     * The encoded file is kept in memory and can be shared by several streams.
+     * The frames are decoded by fill(), in the output format of the mixer, in
+     * a ring buffer from which they are taken by read(). The buffer is filled
+     * by a thread of the decoder pool while the mixer reads it in the audio
+     * thread, thus the decoding is not done during the mix. If the format of
+     * the file is not the same than the output, the decoded frames are
+     * converted through a small buffer.
+     *
+     * \author Julien Jorge
+     */
+    class AUDIO_EXPORT ogg_stream:
+      public claw::pattern::non_copyable
+    {
+    public:
+      /** \brief The type of the pointer to the content of an encoded file.
+          It is released by the threads of the mixer and of the decoder pool,
+          thus its counter must be thread safe. */
+      typedef boost::shared_ptr< std::vector<char> > file_pointer;
+
+      /** \brief The type of the pointers to the streams, shared by the mixer
+          and the decoder pool. */
+      typedef boost::shared_ptr<ogg_stream> pointer;
+
+    private:
+      /** \brief An encoded file read by a decoder. */
+      struct memory_file
+      {
+        /** \brief The content of the file. */
+        file_pointer content;
+
+        /** \brief The position of the decoder in the content. */
+        std::size_t position;
+
+      }; // struct memory_file
+
+    public:
+      ogg_stream
+      ( const file_pointer& file, unsigned int rate, unsigned int channels );
+      ~ogg_stream();
+
+      void set_loops( int loops );
+
+      std::size_t read( claw::int_16* out, std::size_t frames );
+      bool is_finished() const;
+
+      bool start_filling();
+      void fill();
+
+      static double get_duration( const file_pointer& file );
+
+    private:
+      std::size_t decode_frames( claw::int_16* out, std::size_t frames );
+      std::size_t decode( char* out, std::size_t length );
+      void rewind();
+
+      static bool is_ogg( const std::vector<char>& file );
+      static bool open( OggVorbis_File& vorbis, memory_file& file );
+
+      static bool get_stream_info
+      ( const std::vector<char>& file, ogg_uint32_t& serial,
+        ogg_uint32_t& rate );
+      static bool get_last_granule_position
+      ( const std::vector<char>& file, ogg_uint32_t serial,
+        ogg_int64_t& granule );
+      static ogg_int64_t read_little_endian
+      ( const std::vector<char>& file, std::size_t position,
+        std::size_t length );
+
+      static size_t read_file
+      ( void* ptr, size_t size, size_t count, void* file );
+      static int seek_file( void* file, ogg_int64_t offset, int whence );
+      static long tell_file( void* file );
+
+    private:
+      /** \brief The encoded file. */
+      memory_file m_file;
+
+      /** \brief The decoder. */
+      OggVorbis_File m_vorbis;
+
+      /** \brief The converter of the decoded frames to the output format, NULL
+          if the file is already in this format. */
+      SDL_AudioStream* m_converter;
+
+      /** \brief The buffer receiving the frames before the conversion. */
+      std::vector<char> m_decoded;
+
+      /** \brief The number of channels in the output. */
+      const unsigned int m_channels;
+
+      /** \brief Tell if the decoder has reached the end of the file. */
+      bool m_end;
+
+      /** \brief How many times the file must be decoded again when reaching
+          its end. A negative value means forever. */
+      int m_loops;
+
+      /** \brief The decoded frames, interleaved. The number of frames is a
+          power of two. */
+      std::vector<claw::int_16> m_frames;
+
+      /** \brief The index of the next frame to read, modified by read(). */
+      std::atomic<std::size_t> m_head;
+
+      /** \brief The index of the next frame to decode, modified by fill(). */
+      std::atomic<std::size_t> m_tail;
+
+      /** \brief Tell if all the frames of the stream have been decoded. */
+      std::atomic<bool> m_decoded_all;
+
+      /** \brief Tell if a call to fill() is pending. */
+      std::atomic<bool> m_filling;
+
+      /** \brief The minimum number of frames in m_frames. */
+      static const std::size_t s_buffer_frames;
+
+    }; // class ogg_stream
+  } // namespace audio
+} // namespace bear
+
+#endif // __AUDIO_OGG_STREAM_HPP__
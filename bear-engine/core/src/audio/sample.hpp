@@ -52,6 +52,7 @@ namespace bear
 
       virtual sound_effect get_effect() const;
       virtual void set_effect( const sound_effect& effect );
+      virtual void set_effect( const sound_effect& effect, double d );
 
       /* for sound_manager only. */
       virtual void set_volume( double v );
@@ -14,11 +14,14 @@
 #ifndef __AUDIO_SDL_SOUND_HPP__
 #define __AUDIO_SDL_SOUND_HPP__
 
+#include "audio/decoded_sound.hpp"
+#include "audio/ogg_stream.hpp"
 #include "audio/sound.hpp"
 
 #include <SDL2/SDL_mixer.h>
+#include <claw/smart_ptr.hpp>
+#include <claw/types.hpp>
 #include <iostream>
-#include <boost/thread.hpp>
 
 #include "audio/class_export.hpp"
 
@@ -26,6 +29,8 @@ namespace bear
 {
   namespace audio
   {
+    class decoder_pool;
+    class mixer;
     class sound_manager;
 
     /**
@@ -42,28 +47,33 @@ namespace bear
 
       sample* new_sample();
 
-      int play( unsigned int loops ) const;
+      bool is_streamed() const;
+      ogg_stream::pointer new_stream() const;
+
+      const claw::int_16* get_samples() const;
+      std::size_t get_frame_count() const;
 
       static bool initialize();
+      static bool initialize_offline();
       static void release();
 
+      static void render( claw::int_16* output, std::size_t frames );
+
+      static unsigned int get_audio_rate();
       static unsigned int get_audio_format();
+      static mixer& get_mixer();
 
     private:
-      void load_sound( char* buffer, std::size_t buffer_length );
-
-      void ensure_loaded() const;
+      static bool open_audio( bool offline );
+      static void mix_voices( void* m, Uint8* stream, int length );
 
     private:
-      /** \brief The sound allocated by SDL_mixer. */
-      Mix_Chunk* m_sound;
+      /** \brief The frames of the sound, if it is decoded in memory. They are
+          shared with the copies of the sound. */
+      claw::memory::smart_ptr<decoded_sound> m_sound;
 
-      /** \brief The thread loading the sound. */
-      boost::thread* m_loader;
-
-      /** \brief The raw audio data passed to the SDL mixer functions,
-          eventually. */
-      Uint8* m_raw_audio;
+      /** \brief The encoded file, if the sound is streamed. */
+      ogg_stream::file_pointer m_file;
 
       /** \brief Output audio rate. */
       static unsigned int s_audio_rate;
@@ -77,9 +87,30 @@ namespace bear
       /** \brief Size of the buffer. */
       static unsigned int s_audio_buffers;
 
-      /** \brief Count of channels for mixing. */
+      /** \brief Maximum count of voices actually mixed in an output
+          buffer. */
       static unsigned int s_audio_mix_channels;
 
+      /** \brief The minimum duration, in seconds, of the Ogg Vorbis files
+          decoded progressively during their playback instead of being fully
+          decoded in memory. */
+      static double s_streaming_min_duration;
+
+      /** \brief The mixer of the samples. */
+      static mixer* s_mixer;
+
+      /** \brief The threads decoding the sounds. */
+      static decoder_pool* s_decoder_pool;
+
+      /** \brief The thread decoding the next frames of the streams played by
+          the mixer. It is separated from s_decoder_pool such that the
+          streams are not late while a lot of sounds are being loaded. */
+      static decoder_pool* s_stream_decoder_pool;
+
+      /** \brief Tell if the samples are mixed by calls to render() instead of
+          the audio device. */
+      static bool s_offline;
+
     }; // class sdl_sound
   } // namespace audio
 } // namespace bear
@@ -15,6 +15,7 @@
 #define __AUDIO_SOUND_MANAGER_HPP__
 
 #include <claw/coordinate_2d.hpp>
+#include <claw/types.hpp>
 #include <iostream>
 #include <map>
 #include <list>
@@ -89,11 +90,18 @@ namespace bear
       void set_distance_unit( double d );
       double get_distance_unit() const;
 
+      void set_music_crossfade_duration( double d );
+      double get_music_crossfade_duration() const;
+
       double get_volume_for_distance( double d ) const;
 
       static void initialize();
+      static void initialize_offline();
       static void release();
 
+      static void render( claw::int_16* output, std::size_t frames );
+      static unsigned int get_output_rate();
+
     private:
       void remove_muted_music( sample* m );
       bool is_music( const sample* m ) const;
@@ -131,6 +139,10 @@ namespace bear
           distances for the sound effects. */
       double m_distance_unit;
 
+      /** \brief The duration of the transition when a music is muted by
+          another one, or restored when the other one ends. */
+      double m_music_crossfade_duration;
+
       /** \brief Tell if the sound system is initialized. */
       static bool s_initialized;
 
@@ -0,0 +1,79 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A class writing 16 bits frames in a WAV file.
+ * \author Julien Jorge
+ */
+#ifndef __AUDIO_WAV_WRITER_HPP__
+#define __AUDIO_WAV_WRITER_HPP__
+
+#include "audio/class_export.hpp"
+
+#include <claw/non_copyable.hpp>
+#include <claw/types.hpp>
+#include <iostream>
+#include <vector>
+
+namespace bear
+{
+  namespace audio
+  {
+    /**
+     * \brief A class writing 16 bits frames in a WAV file.
+     *
+     * The sizes in the header of the file are written when the writer is
+     * closed, thus the output stream must be seekable.
+     *
+     * \author Julien Jorge
+     */
+    class AUDIO_EXPORT wav_writer:
+      public claw::pattern::non_copyable
+    {
+    public:
+      wav_writer
+      ( std::ostream& output, unsigned int rate, unsigned int channels );
+      ~wav_writer();
+
+      void write( const claw::int_16* frames, std::size_t count );
+      void close();
+
+    private:
+      void write_header();
+      void write_u_int_16( claw::u_int_16 v );
+      void write_u_int_32( claw::u_int_32 v );
+
+    private:
+      /** \brief The stream in which the file is written. */
+      std::ostream& m_output;
+
+      /** \brief The position of the beginning of the file in the stream. */
+      const std::streampos m_start;
+
+      /** \brief The sample rate of the frames. */
+      const unsigned int m_rate;
+
+      /** \brief The number of channels in a frame. */
+      const unsigned int m_channels;
+
+      /** \brief The number of bytes of frames written in the file. */
+      std::size_t m_data_size;
+
+      /** \brief Tell if the sizes have been written in the header. */
+      bool m_closed;
+
+      /** \brief The little endian bytes of the frames, before their
+          writing. */
+      std::vector<char> m_buffer;
+
+    }; // class wav_writer
+  } // namespace audio
+} // namespace bear
+
+#endif // __AUDIO_WAV_WRITER_HPP__
@@ -0,0 +1,157 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::communication::message_queue class.
+ * \author Julien Jorge
+ */
+#include "communication/message_queue.hpp"
+
+#include <claw/assert.hpp>
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::communication::message_queue::message_queue()
+  : m_head(NULL), m_tail(NULL), m_free(NULL), m_size(0)
+{
+
+} // message_queue::message_queue()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Copy constructor.
+ * \param that The instance to copy from.
+ *
+ * Nothing is copied.
+ */
+bear::communication::message_queue::message_queue( const message_queue& that )
+  : m_head(NULL), m_tail(NULL), m_free(NULL), m_size(0)
+{
+
+} // message_queue::message_queue()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::communication::message_queue::~message_queue()
+{
+  delete_nodes( m_head );
+  delete_nodes( m_free );
+} // message_queue::~message_queue()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Assignment.
+ * \param that The instance to copy from.
+ *
+ * Nothing is copied, the messages of this queue are kept.
+ */
+bear::communication::message_queue&
+bear::communication::message_queue::operator=( const message_queue& that )
+{
+  return *this;
+} // message_queue::operator=()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Tell if there is no message in the queue.
+ */
+bool bear::communication::message_queue::empty() const
+{
+  return m_head == NULL;
+} // message_queue::empty()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of messages in the queue.
+ */
+std::size_t bear::communication::message_queue::size() const
+{
+  return m_size;
+} // message_queue::size()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Add a message at the end of the queue.
+ * \param m The message to add.
+ */
+void bear::communication::message_queue::push( message& m )
+{
+  node* n;
+
+  if ( m_free == NULL )
+    n = new node;
+  else
+    {
+      n = m_free;
+      m_free = n->next;
+    }
+
+  n->value = &m;
+  n->next = NULL;
+
+  if ( m_tail == NULL )
+    m_head = n;
+  else
+    m_tail->next = n;
+
+  m_tail = n;
+  ++m_size;
+} // message_queue::push()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Get the first message of the queue.
+ * \pre !empty()
+ */
+bear::communication::message&
+bear::communication::message_queue::front() const
+{
+  CLAW_PRECOND( !empty() );
+
+  return *m_head->value;
+} // message_queue::front()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Remove the first message of the queue.
+ * \pre !empty()
+ */
+void bear::communication::message_queue::pop()
+{
+  CLAW_PRECOND( !empty() );
+
+  node* const n( m_head );
+  m_head = n->next;
+
+  if ( m_head == NULL )
+    m_tail = NULL;
+
+  n->next = m_free;
+  m_free = n;
+  --m_size;
+} // message_queue::pop()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Delete the nodes of a list.
+ * \param n The first node of the list.
+ */
+void bear::communication::message_queue::delete_nodes( node* n )
+{
+  while ( n != NULL )
+    {
+      node* const next( n->next );
+      delete n;
+      n = next;
+    }
+} // message_queue::delete_nodes()
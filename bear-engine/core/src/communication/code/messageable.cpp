@@ -14,14 +14,12 @@
 #include "communication/messageable.hpp"
 #include "communication/post_office.hpp"
 
-#include <claw/assert.hpp>
-
 /*---------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
  */
 bear::communication::messageable::messageable()
-  : m_name(post_office::no_name)
+  : m_name(post_office::no_name), m_post_office(NULL), m_pending(false)
 {
 
 } // messageable::messageable()
@@ -32,7 +30,7 @@ bear::communication::messageable::messageable()
  * \param name The name of this item.
  */
 bear::communication::messageable::messageable( const std::string& name )
-  : m_name(name)
+  : m_name(name), m_post_office(NULL), m_pending(false)
 {
 
 } // messageable::messageable()
@@ -45,7 +43,7 @@ bear::communication::messageable::messageable( const std::string& name )
  * The new instance has no name.
  */
 bear::communication::messageable::messageable( const messageable& that )
-  : super(that), m_name(post_office::no_name)
+  : m_name(post_office::no_name), m_post_office(NULL), m_pending(false)
 {
 
 } // messageable::messageable()
@@ -59,6 +57,20 @@ bear::communication::messageable::~messageable()
 
 } // messageable::~messageable()
 
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Assignment.
+ * \param that The instance to copy from.
+ *
+ * As with the copy constructor, nothing is copied from \a that: this instance
+ * keeps its name, its messages and its registration in its post office.
+ */
+bear::communication::messageable&
+bear::communication::messageable::operator=( const messageable& that )
+{
+  return *this;
+} // messageable::operator=()
+
 /*---------------------------------------------------------------------------*/
 /**
  * \brief Set/change the name of the item.
@@ -84,8 +96,10 @@ const std::string& bear::communication::messageable::get_name() const
  */
 void bear::communication::messageable::post_message(message& msg)
 {
-  message* m = &msg;
-  register_item( m );
+  m_message_queue.push( msg );
+
+  if ( m_post_office != NULL )
+    m_post_office->schedule( *this );
 } // messageable::post_message()
 
 /*---------------------------------------------------------------------------*/
@@ -101,22 +115,19 @@ bool bear::communication::messageable::send_message(message& msg)
 
 /*---------------------------------------------------------------------------*/
 /**
- * \brief Process all messages in queue.
+ * \brief Process all messages in queue. The messages posted during the
+ *        processing are kept for the next call.
  */
 void bear::communication::messageable::process_messages()
 {
-  CLAW_PRECOND( !locked() );
-
-  std::list<message*>::iterator it;
-
-  lock();
-
-  for (it=m_message_queue.begin(); it!=m_message_queue.end(); ++it)
-    process_message(**it);
-
-  m_message_queue.clear();
-
-  unlock();
+  m_pending = false;
+
+  for ( std::size_t n=m_message_queue.size(); n!=0; --n )
+    {
+      message& m( m_message_queue.front() );
+      m_message_queue.pop();
+      process_message(m);
+    }
 } // messageable::process_messages()
 
 /*---------------------------------------------------------------------------*/
@@ -129,25 +140,3 @@ bool bear::communication::messageable::process_message(message& msg)
 {
   return msg.apply_to(*this);
 } // messageable::process_message()
-
-/*---------------------------------------------------------------------------*/
-/**
- * \brief Enqueue a message.
- * \param who The message to add.
- */
-void bear::communication::messageable::add( message* const& who )
-{
-  m_message_queue.push_back( who );
-} // messageable::messageable::add()
-
-/*---------------------------------------------------------------------------*/
-/**
- * \brief Should remove a message from the queue but do nothing.
- * \param who The message that should be removed.
- * \remark This method shouldn't be called.
- */
-void bear::communication::messageable::remove( message* const& who )
-{
-  claw::logger << claw::log_warning
-               << "messageable::remove(): souldn't be called." << std::endl;
-} // messageable::remove()
@@ -19,9 +19,32 @@
 #include <claw/logger.hpp>
 #include <claw/assert.hpp>
 
+#include <algorithm>
+#include <limits>
+
 /*---------------------------------------------------------------------------*/
 const std::string bear::communication::post_office::no_name;
 
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Constructor. The address does not refer to any item.
+ */
+bear::communication::post_office::address::address()
+  : index( std::numeric_limits<std::size_t>::max() ), generation(0)
+{
+
+} // post_office::address::address()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::communication::post_office::slot::slot()
+  : item(NULL), generation(0)
+{
+
+} // post_office::slot::slot()
+
 /*---------------------------------------------------------------------------*/
 /**
  * \brief Immediately send a message to an item.
@@ -34,13 +57,13 @@ bool bear::communication::post_office::send_message
 {
   CLAW_PRECOND( target != no_name );
 
-  std::map<std::string, messageable*>::const_iterator it;
+  std::unordered_map<std::string, std::size_t>::const_iterator it;
   bool result = false;
 
   it = m_items.find( target );
 
   if ( it!=m_items.end() )
-    result = it->second->send_message( msg );
+    result = m_slots[it->second].item->send_message( msg );
   else
     claw::logger << claw::log_warning
                  << "post_office::send_message(): can't find target " << target
@@ -51,22 +74,80 @@ bool bear::communication::post_office::send_message
 
 /*---------------------------------------------------------------------------*/
 /**
- * \brief Process messages of all items.
+ * \brief Immediately send a message to an item.
+ * \param target The address of the item receiving the message, as returned by
+ *        get_address().
+ * \param msg The message to send.
+ * \return true if the message has been proceded.
+ */
+bool bear::communication::post_office::send_message
+( const address& target, message& msg ) const
+{
+  bool result = false;
+
+  if ( (target.index < m_slots.size())
+       && (m_slots[target.index].generation == target.generation)
+       && (m_slots[target.index].item != NULL) )
+    result = m_slots[target.index].item->send_message( msg );
+  else
+    claw::logger << claw::log_warning
+                 << "post_office::send_message(): invalid address."
+                 << std::endl;
+
+  return result;
+} // post_office::send_message()
+
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Process the messages of the items having some.
  */
 void bear::communication::post_office::process_messages()
 {
   CLAW_PRECOND( !locked() );
 
-  std::map<std::string, messageable*>::const_iterator it;
+  // The messages posted during the processing are kept for the next call.
+  std::vector<messageable*> pending;
+  pending.swap( m_pending );
 
   lock();
 
-  for(it=m_items.begin(); it!=m_items.end(); ++it)
-    it->second->process_messages();
+  for( std::size_t i=0; i!=pending.size(); ++i )
+    pending[i]->process_messages();
 
   unlock();
+
+  // Keep the memory of the list for the next call.
+  if ( m_pending.empty() )
+    {
+      pending.clear();
+      m_pending.swap( pending );
+    }
 } // post_office::process_messages()
 
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Get the address of an item, to send it messages without searching it
+ *        by name.
+ * \param name The name of the item.
+ * \return An address referring to no item if there is no item with this name.
+ */
+bear::communication::post_office::address
+bear::communication::post_office::get_address( const std::string& name ) const
+{
+  address result;
+
+  const std::unordered_map<std::string, std::size_t>::const_iterator it
+    ( m_items.find(name) );
+
+  if ( it != m_items.end() )
+    {
+      result.index = it->second;
+      result.generation = m_slots[it->second].generation;
+    }
+
+  return result;
+} // post_office::get_address()
+
 /*---------------------------------------------------------------------------*/
 /**
  * \brief Tell if there exists an item having a given name.
@@ -82,12 +163,12 @@ bool bear::communication::post_office::exists( const std::string& name ) const
  */
 void bear::communication::post_office::clear()
 {
-  std::map<std::string, messageable*>::const_iterator it;
+  std::unordered_map<std::string, std::size_t>::const_iterator it;
 
   lock();
 
   for(it=m_items.begin(); it!=m_items.end(); ++it)
-    release_item(it->second);
+    release_item(m_slots[it->second].item);
 
   unlock();
 } // post_office::process_messages()
@@ -107,12 +188,33 @@ void bear::communication::post_office::add( messageable* const& who)
       return;
     }
 
-  std::map<std::string, messageable*>::const_iterator it;
+  std::unordered_map<std::string, std::size_t>::const_iterator it;
 
   it = m_items.find( who->get_name() );
 
   if ( it == m_items.end() )
-    m_items[who->get_name()] = who;
+    {
+      std::size_t index;
+
+      if ( m_free_slots.empty() )
+        {
+          index = m_slots.size();
+          m_slots.push_back( slot() );
+        }
+      else
+        {
+          index = m_free_slots.back();
+          m_free_slots.pop_back();
+        }
+
+      m_slots[index].item = who;
+      m_items[who->get_name()] = index;
+
+      who->m_post_office = this;
+
+      if ( !who->m_message_queue.empty() )
+        schedule( *who );
+    }
   else
     claw::logger << claw::log_warning << "post_office::add(): item "
                  << who->get_name() << " is already in the list" << std::endl;
@@ -125,14 +227,45 @@ void bear::communication::post_office::add( messageable* const& who)
  */
 void bear::communication::post_office::remove(messageable* const& who)
 {
-  std::map<std::string, messageable*>::iterator it;
+  std::unordered_map<std::string, std::size_t>::iterator it;
 
   it = m_items.find( who->get_name() );
 
   if ( it != m_items.end() )
-    m_items.erase(it);
+    {
+      slot& s( m_slots[it->second] );
+      s.item = NULL;
+      ++s.generation;
+      m_free_slots.push_back( it->second );
+
+      m_items.erase(it);
+
+      if ( who->m_pending )
+        {
+          m_pending.erase
+            ( std::remove( m_pending.begin(), m_pending.end(), who ),
+              m_pending.end() );
+          who->m_pending = false;
+        }
+
+      who->m_post_office = NULL;
+    }
   else
     claw::logger << claw::log_warning << "post_office::remove(): item "
                  << who->get_name() << " isn't in the list" << std::endl;
 } // post_office::remove()
 
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Add an item in the list of the items with messages to process, if it
+ *        is not already there.
+ * \param who The item having messages to process.
+ */
+void bear::communication::post_office::schedule( messageable& who )
+{
+  if ( !who.m_pending )
+    {
+      who.m_pending = true;
+      m_pending.push_back( &who );
+    }
+} // post_office::schedule()
@@ -0,0 +1,86 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A queue of messages whose nodes are reused.
+ * \author Julien Jorge
+ */
+#ifndef __COMMUNICATION_MESSAGE_QUEUE_HPP__
+#define __COMMUNICATION_MESSAGE_QUEUE_HPP__
+
+#include "communication/class_export.hpp"
+
+#include <cstddef>
+
+namespace bear
+{
+  namespace communication
+  {
+    class message;
+
+    /**
+     * \brief A queue of messages whose nodes are reused.
+     *
+     * The queue is a singly linked list. The nodes of the messages removed
+     * from the queue are kept in a free list and used again for the next
+     * messages, thus a queue allocates memory only when it holds more messages
+     * than it ever did.
+     *
+     * \author Julien Jorge
+     */
+    class COMMUNICATION_EXPORT message_queue
+    {
+    private:
+      /** \brief A node of the list. */
+      struct node
+      {
+        /** \brief The message in this node. */
+        message* value;
+
+        /** \brief The next node in the list. */
+        node* next;
+
+      }; // struct node
+
+    public:
+      message_queue();
+      message_queue( const message_queue& that );
+      ~message_queue();
+
+      message_queue& operator=( const message_queue& that );
+
+      bool empty() const;
+      std::size_t size() const;
+
+      void push( message& m );
+      message& front() const;
+      void pop();
+
+    private:
+      static void delete_nodes( node* n );
+
+    private:
+      /** \brief The first message in the queue. */
+      node* m_head;
+
+      /** \brief The last message in the queue. */
+      node* m_tail;
+
+      /** \brief The nodes available for the next messages. */
+      node* m_free;
+
+      /** \brief The number of messages in the queue. */
+      std::size_t m_size;
+
+    }; // class message_queue
+
+  } // namespace communication
+} // namespace bear
+
+#endif // __COMMUNICATION_MESSAGE_QUEUE_HPP__
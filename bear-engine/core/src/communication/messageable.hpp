@@ -15,7 +15,7 @@
 #define __COMMUNICATION_MESSAGEABLE_HPP__
 
 #include "communication/message.hpp"
-#include "concept/item_container.hpp"
+#include "communication/message_queue.hpp"
 
 #include "communication/class_export.hpp"
 
@@ -25,23 +25,28 @@ namespace bear
 {
   namespace communication
   {
+    class post_office;
+
     /**
      * \brief A class for items that can receaive message events.
+     *
+     * The messages posted to the item are kept in a queue until
+     * process_messages() is called. When the item is registered in a
+     * post_office, the latter is informed of the pending messages, so it
+     * processes only the items having some.
+     *
      * \author Julien Jorge
      */
-    class COMMUNICATION_EXPORT messageable:
-      private concept::item_container<message*>
+    class COMMUNICATION_EXPORT messageable
     {
-    public:
-      /** \brief The type of the parent class. */
-      typedef concept::item_container<message*> super;
-
     public:
       messageable();
       messageable( const std::string& name );
       messageable( const messageable& that );
       virtual ~messageable();
 
+      messageable& operator=( const messageable& that );
+
       void set_name(const std::string& name);
       const std::string& get_name() const;
 
@@ -52,15 +57,21 @@ namespace bear
     private:
       virtual bool process_message( message& msg );
 
-      virtual void add( message* const& who);
-      virtual void remove( message* const& who);
-
     private:
       /** \brief The (unique) name of the item. */
       std::string m_name;
 
       /** \brief Message queue. */
-      std::list<message*> m_message_queue;
+      message_queue m_message_queue;
+
+      /** \brief The post office in which the item is registered, if any. */
+      post_office* m_post_office;
+
+      /** \brief Tell if the item is in the list of the items with pending
+          messages of m_post_office. */
+      bool m_pending;
+
+      friend class post_office;
 
     }; // class messageable
   } // namespace communication
@@ -17,8 +17,9 @@
 #include "communication/messageable.hpp"
 #include "concept/item_container.hpp"
 
-#include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace bear
 {
@@ -28,15 +29,55 @@ namespace bear
 
     /**
      * \brief A class to transfer message to items.
+     *
+     * The items are found by name or, faster, with an address obtained once
+     * from the name. The address becomes invalid when the item is removed
+     * from the post office.
+     *
      * \author Julien Jorge
      */
     class COMMUNICATION_EXPORT post_office:
       public concept::item_container<messageable*>
     {
+    public:
+      /** \brief The address of an item in the post office. */
+      struct address
+      {
+      public:
+        address();
+
+      public:
+        /** \brief The index of the slot of the item. */
+        std::size_t index;
+
+        /** \brief The generation of the slot when the address was
+            created. */
+        unsigned int generation;
+
+      }; // struct address
+
+    private:
+      /** \brief A place where an item is stored. */
+      struct slot
+      {
+      public:
+        slot();
+
+      public:
+        /** \brief The item in the slot, NULL if the slot is free. */
+        messageable* item;
+
+        /** \brief The number of items that left the slot. */
+        unsigned int generation;
+
+      }; // struct slot
+
     public:
       bool send_message( const std::string& target, message& msg ) const;
+      bool send_message( const address& target, message& msg ) const;
       void process_messages();
 
+      address get_address( const std::string& name ) const;
       bool exists( const std::string& name ) const;
 
       void clear();
@@ -45,12 +86,27 @@ namespace bear
       void add( messageable* const& who );
       void remove( messageable* const& who );
 
+    private:
+      void schedule( messageable& who );
+
     public:
       /** \brief The name of items that do not have a name... */
       static const std::string no_name;
 
     private:
-      std::map<std::string, messageable*> m_items;
+      /** \brief The indices of the slots of the items, by name. */
+      std::unordered_map<std::string, std::size_t> m_items;
+
+      /** \brief The places where the items are stored. */
+      std::vector<slot> m_slots;
+
+      /** \brief The indices of the slots in m_slots that are free. */
+      std::vector<std::size_t> m_free_slots;
+
+      /** \brief The items with messages to process. */
+      std::vector<messageable*> m_pending;
+
+      friend class messageable;
 
     }; // class post_office
 
@@ -0,0 +1,313 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::debug::performance_counters class.
+ * \author Julien Jorge
+ */
+#include "debug/performance_counters.hpp"
+
+#include "debug/profiler.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+boost::mutex bear::debug::performance_counters::s_mutex;
+std::map<std::string, bear::debug::performance_counters::counter_id>
+bear::debug::performance_counters::s_counter_ids;
+std::vector<const char*> bear::debug::performance_counters::s_counter_names;
+std::vector<bool> bear::debug::performance_counters::s_gauges;
+std::vector< std::atomic<bear::debug::performance_counters::value_type> >
+bear::debug::performance_counters::s_values(128);
+bear::debug::performance_counters::value_list
+bear::debug::performance_counters::s_last_frame;
+std::size_t bear::debug::performance_counters::s_frame_index(0);
+std::ofstream bear::debug::performance_counters::s_export;
+bool bear::debug::performance_counters::s_json_export(false);
+std::size_t bear::debug::performance_counters::s_csv_column_count(0);
+unsigned long long bear::debug::performance_counters::s_export_origin(0);
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of a counter summed during the frame, creating it
+ *        if needed.
+ * \param name The name of the counter. The pointer is kept, thus it must be
+ *        valid until the end of the program, like a string literal.
+ */
+bear::debug::performance_counters::counter_id
+bear::debug::performance_counters::register_counter( const char* name )
+{
+  return register_counter( name, false );
+} // performance_counters::register_counter()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of a gauge, creating it if needed.
+ * \param name The name of the gauge. The pointer is kept, thus it must be
+ *        valid until the end of the program, like a string literal.
+ */
+bear::debug::performance_counters::counter_id
+bear::debug::performance_counters::register_gauge( const char* name )
+{
+  return register_counter( name, true );
+} // performance_counters::register_gauge()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of a counter.
+ * \param c The identifier of the counter.
+ */
+std::string
+bear::debug::performance_counters::get_counter_name( counter_id c )
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  CLAW_PRECOND( c < s_counter_names.size() );
+
+  return s_counter_names[c];
+} // performance_counters::get_counter_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of counters registered.
+ */
+std::size_t bear::debug::performance_counters::get_counter_count()
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+  return s_counter_names.size();
+} // performance_counters::get_counter_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a value to a counter.
+ * \param c The identifier of the counter.
+ * \param v The value to add.
+ */
+void bear::debug::performance_counters::add( counter_id c, value_type v )
+{
+  if ( c < s_values.size() )
+    s_values[c].fetch_add( v, std::memory_order_relaxed );
+} // performance_counters::add()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Assign the value of a counter.
+ * \param c The identifier of the counter.
+ * \param v The new value.
+ */
+void bear::debug::performance_counters::set( counter_id c, value_type v )
+{
+  if ( c < s_values.size() )
+    s_values[c].store( v, std::memory_order_relaxed );
+} // performance_counters::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Keep the values of the counters for the frame that ends, export them
+ *        and reset the counters that are not gauges.
+ */
+void bear::debug::performance_counters::end_frame()
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  s_last_frame.resize( s_counter_names.size() );
+
+  for ( std::size_t i=0; i!=s_last_frame.size(); ++i )
+    if ( s_gauges[i] )
+      s_last_frame[i] = s_values[i].load( std::memory_order_relaxed );
+    else
+      s_last_frame[i] = s_values[i].exchange( 0, std::memory_order_relaxed );
+
+  if ( s_export.is_open() )
+    {
+      const double date( (profiler::get_date() - s_export_origin) / 1000000.0 );
+
+      if ( s_json_export )
+        write_json_frame( date );
+      else
+        write_csv_frame( date );
+
+      ++s_frame_index;
+    }
+} // performance_counters::end_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the values of the counters at the end of the last frame. This
+ *        method must be called from the thread calling end_frame().
+ */
+const bear::debug::performance_counters::value_list&
+bear::debug::performance_counters::get_last_frame()
+{
+  return s_last_frame;
+} // performance_counters::get_last_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to write the values of the counters at the end of each frame in
+ *        a file.
+ * \param path The path to the file. The values are written as one JSON object
+ *        per line if the name of the file ends with ".json", and in CSV
+ *        otherwise.
+ * \return false if the file cannot be created.
+ */
+bool bear::debug::performance_counters::start_export( const std::string& path )
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  if ( s_export.is_open() )
+    s_export.close();
+
+  s_export.clear();
+  s_export.open( path.c_str() );
+
+  if ( !s_export )
+    {
+      claw::logger << claw::log_error << "Can't create the counters file '"
+                   << path << "'." << std::endl;
+      s_export.close();
+      return false;
+    }
+
+  claw::logger << claw::log_verbose << "Writing the performance counters in '"
+               << path << "'." << std::endl;
+
+  const std::string extension(".json");
+
+  s_json_export =
+    ( path.size() >= extension.size() )
+    && ( path.compare
+         ( path.size() - extension.size(), extension.size(), extension ) == 0 );
+
+  s_frame_index = 0;
+  s_csv_column_count = 0;
+  s_export_origin = profiler::get_date();
+
+  return true;
+} // performance_counters::start_export()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the file opened with start_export().
+ */
+void bear::debug::performance_counters::stop_export()
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  if ( s_export.is_open() )
+    s_export.close();
+} // performance_counters::stop_export()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of a counter, creating it if needed.
+ * \param name The name of the counter.
+ * \param gauge Tell if the counter keeps its value from a frame to the next.
+ */
+bear::debug::performance_counters::counter_id
+bear::debug::performance_counters::register_counter
+( const char* name, bool gauge )
+{
+  CLAW_PRECOND( name != NULL );
+
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  const std::map<std::string, counter_id>::const_iterator it
+    ( s_counter_ids.find(name) );
+
+  if ( it != s_counter_ids.end() )
+    return it->second;
+
+  if ( s_counter_names.size() == s_values.size() )
+    {
+      claw::logger << claw::log_warning << "Too many performance counters, '"
+                   << name << "' is ignored." << std::endl;
+      return s_values.size();
+    }
+
+  const counter_id result( s_counter_names.size() );
+  s_counter_ids[name] = result;
+  s_counter_names.push_back( name );
+  s_gauges.push_back( gauge );
+
+  if ( s_export.is_open() && !s_json_export && (s_frame_index != 0) )
+    claw::logger << claw::log_warning << "The performance counter '" << name
+                 << "' is registered after the header of the CSV export, it "
+                 << "will not be exported." << std::endl;
+
+  return result;
+} // performance_counters::register_counter()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the names of the columns in the CSV export. The columns are the
+ *        counters registered at this time.
+ * \pre s_mutex is locked.
+ */
+void bear::debug::performance_counters::write_csv_header()
+{
+  s_export << "frame,time_ms";
+
+  for ( std::size_t i=0; i!=s_counter_names.size(); ++i )
+    s_export << ',' << s_counter_names[i];
+
+  s_export << '\n';
+
+  s_csv_column_count = s_counter_names.size();
+} // performance_counters::write_csv_header()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the values of the last frame in the CSV export. The header is
+ *        written with the first frame, thus it contains the counters
+ *        registered during this frame. The counters registered later are not
+ *        written, such that all the rows have the same columns.
+ * \param date The date of the end of the frame, in milliseconds since the
+ *        beginning of the export.
+ * \pre s_mutex is locked.
+ */
+void bear::debug::performance_counters::write_csv_frame( double date )
+{
+  if ( s_frame_index == 0 )
+    write_csv_header();
+
+  CLAW_PRECOND( s_csv_column_count <= s_last_frame.size() );
+
+  s_export << s_frame_index << ',' << date;
+
+  for ( std::size_t i=0; i!=s_csv_column_count; ++i )
+    s_export << ',' << s_last_frame[i];
+
+  s_export << '\n';
+} // performance_counters::write_csv_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the values of the last frame in the JSON export, as one object
+ *        on a single line.
+ * \param date The date of the end of the frame, in milliseconds since the
+ *        beginning of the export.
+ * \pre s_mutex is locked.
+ */
+void bear::debug::performance_counters::write_json_frame( double date )
+{
+  s_export << "{\"frame\":" << s_frame_index << ",\"time_ms\":" << date
+           << ",\"counters\":{";
+
+  for ( std::size_t i=0; i!=s_last_frame.size(); ++i )
+    {
+      if ( i != 0 )
+        s_export << ',';
+
+      s_export << '"' << s_counter_names[i] << "\":" << s_last_frame[i];
+    }
+
+  s_export << "}}\n";
+} // performance_counters::write_json_frame()
@@ -0,0 +1,387 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::debug::profiler class.
+ * \author Julien Jorge
+ */
+#include "debug/profiler.hpp"
+
+#include "debug/profiler_buffer.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+#include <chrono>
+
+/*----------------------------------------------------------------------------*/
+std::atomic<bool> bear::debug::profiler::s_enabled(false);
+boost::mutex bear::debug::profiler::s_mutex;
+std::map<std::string, bear::debug::profiler::zone_id>
+bear::debug::profiler::s_zone_ids;
+std::vector<const char*> bear::debug::profiler::s_zone_names;
+boost::thread_specific_ptr<bear::debug::profiler_buffer>
+bear::debug::profiler::s_thread_buffer
+( &bear::debug::profiler::release_thread_buffer );
+std::vector<bear::debug::profiler_buffer*> bear::debug::profiler::s_buffers;
+std::vector<bear::debug::profiler::zone_stack>
+bear::debug::profiler::s_stacks;
+std::size_t bear::debug::profiler::s_thread_count(0);
+bear::debug::profiler::frame_statistics bear::debug::profiler::s_last_frame;
+bear::debug::profiler::frame_statistics
+bear::debug::profiler::s_current_frame;
+std::ofstream bear::debug::profiler::s_trace;
+bool bear::debug::profiler::s_trace_has_events(false);
+bear::debug::profiler::date_type bear::debug::profiler::s_trace_origin(0);
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of a zone, creating it if needed.
+ * \param name The name of the zone. The pointer is kept by the profiler, thus
+ *        it must be valid until the end of the program, like a string literal.
+ */
+bear::debug::profiler::zone_id
+bear::debug::profiler::register_zone( const char* name )
+{
+  CLAW_PRECOND( name != NULL );
+
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  const std::map<std::string, zone_id>::const_iterator it
+    ( s_zone_ids.find(name) );
+
+  if ( it != s_zone_ids.end() )
+    return it->second;
+
+  const zone_id result( s_zone_names.size() );
+  s_zone_ids[name] = result;
+  s_zone_names.push_back( name );
+
+  return result;
+} // profiler::register_zone()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of a zone.
+ * \param z The identifier of the zone.
+ */
+std::string bear::debug::profiler::get_zone_name( zone_id z )
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  CLAW_PRECOND( z < s_zone_names.size() );
+
+  return s_zone_names[z];
+} // profiler::get_zone_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of zones registered in the profiler.
+ */
+std::size_t bear::debug::profiler::get_zone_count()
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+  return s_zone_names.size();
+} // profiler::get_zone_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the current date, in nanoseconds, as used for the events.
+ */
+bear::debug::profiler::date_type bear::debug::profiler::get_date()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>
+    ( std::chrono::steady_clock::now().time_since_epoch() ).count();
+} // profiler::get_date()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Turn on or off the recording of the events.
+ * \param e Tell if the events are recorded.
+ */
+void bear::debug::profiler::set_enabled( bool e )
+{
+  s_enabled.store( e, std::memory_order_relaxed );
+} // profiler::set_enabled()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the events are recorded.
+ */
+bool bear::debug::profiler::is_enabled()
+{
+  return s_enabled.load( std::memory_order_relaxed );
+} // profiler::is_enabled()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Record the entry in a zone in the current thread.
+ * \param z The identifier of the zone.
+ * \return true if the entry has been recorded, in which case end() must be
+ *         called when the zone is exited.
+ */
+bool bear::debug::profiler::begin( zone_id z )
+{
+  if ( !is_enabled() )
+    return false;
+
+  profiler_buffer::event e;
+  e.date = get_date();
+  e.zone = z;
+  e.begin = true;
+
+  return get_thread_buffer()->push( e );
+} // profiler::begin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Record the exit of a zone in the current thread.
+ * \param z The identifier of the zone.
+ * \pre begin(z) has returned true in the current thread.
+ */
+void bear::debug::profiler::end( zone_id z )
+{
+  profiler_buffer::event e;
+  e.date = get_date();
+  e.zone = z;
+  e.begin = false;
+
+  get_thread_buffer()->push( e );
+} // profiler::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Collect the events recorded since the previous call in all the
+ *        threads and compute the statistics of the frame.
+ *
+ * The zones still open in a thread are accounted in the frame in which they
+ * are exited.
+ */
+void bear::debug::profiler::end_frame()
+{
+  const date_type now( get_date() );
+
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  if ( s_current_frame.start == 0 )
+    s_current_frame.start = now;
+
+  s_current_frame.zones.resize( s_zone_names.size() );
+
+  std::size_t i(0);
+
+  while ( i != s_buffers.size() )
+    {
+      // The buffer must be tested before being emptied: the events pushed
+      // before the closing are visible once the closing is seen.
+      const bool closed( s_buffers[i]->is_closed() );
+
+      collect( *s_buffers[i], s_stacks[i] );
+      s_current_frame.dropped_events += s_buffers[i]->take_dropped_count();
+
+      if ( closed )
+        {
+          delete s_buffers[i];
+          s_buffers.erase( s_buffers.begin() + i );
+          s_stacks.erase( s_stacks.begin() + i );
+        }
+      else
+        ++i;
+    }
+
+  if ( s_trace.is_open() )
+    s_trace.flush();
+
+  s_current_frame.duration = now - s_current_frame.start;
+  s_last_frame = s_current_frame;
+
+  const zone_statistics empty = { 0, 0, 0 };
+  s_current_frame.start = now;
+  s_current_frame.duration = 0;
+  s_current_frame.dropped_events = 0;
+  std::fill
+    ( s_current_frame.zones.begin(), s_current_frame.zones.end(), empty );
+} // profiler::end_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the statistics of the last frame collected by end_frame(). This
+ *        method must be called from the thread calling end_frame().
+ */
+const bear::debug::profiler::frame_statistics&
+bear::debug::profiler::get_last_frame()
+{
+  return s_last_frame;
+} // profiler::get_last_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to write the zones in a file in the Chrome trace event format,
+ *        and turn on the recording of the events.
+ * \param path The path to the file.
+ * \return false if the file cannot be created.
+ */
+bool bear::debug::profiler::start_trace( const std::string& path )
+{
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  if ( s_trace.is_open() )
+    {
+      s_trace << "\n]\n";
+      s_trace.close();
+    }
+
+  s_trace.clear();
+  s_trace.open( path.c_str() );
+
+  if ( !s_trace )
+    {
+      claw::logger << claw::log_error << "Can't create the trace file '"
+                   << path << "'." << std::endl;
+      s_trace.close();
+      return false;
+    }
+
+  claw::logger << claw::log_verbose << "Writing the profiler trace in '"
+               << path << "'." << std::endl;
+
+  s_trace << "[\n";
+  s_trace.precision(3);
+  s_trace.setf( std::ios::fixed, std::ios::floatfield );
+  s_trace_has_events = false;
+  s_trace_origin = get_date();
+
+  set_enabled(true);
+
+  return true;
+} // profiler::start_trace()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the file opened with start_trace() and turn off the recording
+ *        of the events.
+ */
+void bear::debug::profiler::stop_trace()
+{
+  set_enabled(false);
+
+  boost::mutex::scoped_lock lock( s_mutex );
+
+  if ( s_trace.is_open() )
+    {
+      s_trace << "\n]\n";
+      s_trace.close();
+    }
+} // profiler::stop_trace()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the buffer of the current thread, creating it if needed.
+ */
+bear::debug::profiler_buffer* bear::debug::profiler::get_thread_buffer()
+{
+  profiler_buffer* result( s_thread_buffer.get() );
+
+  if ( result == NULL )
+    {
+      boost::mutex::scoped_lock lock( s_mutex );
+
+      result = new profiler_buffer( s_thread_count, 16384 );
+      ++s_thread_count;
+
+      s_buffers.push_back( result );
+      s_stacks.push_back( zone_stack() );
+      s_thread_buffer.reset( result );
+    }
+
+  return result;
+} // profiler::get_thread_buffer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell that the thread owning a buffer has ended. The buffer is deleted
+ *        by end_frame() once its events have been collected.
+ * \param b The buffer of the thread.
+ */
+void bear::debug::profiler::release_thread_buffer( profiler_buffer* b )
+{
+  b->close();
+} // profiler::release_thread_buffer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Collect the events of a buffer in the current frame.
+ * \param b The buffer.
+ * \param stack The zones open in the thread owning the buffer.
+ * \pre s_mutex is locked.
+ */
+void bear::debug::profiler::collect( profiler_buffer& b, zone_stack& stack )
+{
+  profiler_buffer::event e;
+
+  while ( b.pop(e) )
+    if ( e.begin )
+      {
+        const open_zone z = { e.zone, e.date, 0 };
+        stack.push_back( z );
+      }
+    else
+      {
+        // The exit of a zone whose entry has been dropped is ignored, and the
+        // zones nested in an exited zone whose exit has been dropped are
+        // closed.
+        std::size_t n( stack.size() );
+
+        while ( (n != 0) && (stack[n - 1].zone != e.zone) )
+          --n;
+
+        if ( n == 0 )
+          continue;
+
+        stack.resize( n );
+
+        const open_zone z( stack.back() );
+        const date_type duration( e.date - z.start );
+        stack.pop_back();
+
+        zone_statistics& stats( s_current_frame.zones[z.zone] );
+        ++stats.calls;
+        stats.inclusive_duration += duration;
+        stats.self_duration += duration - z.children_duration;
+
+        if ( !stack.empty() )
+          stack.back().children_duration += duration;
+
+        if ( s_trace.is_open() && (z.start >= s_trace_origin) )
+          write_trace_event
+            ( s_zone_names[z.zone], b.get_thread_index(), z.start, duration );
+      }
+} // profiler::collect()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a complete event in the trace.
+ * \param name The name of the zone.
+ * \param thread The index of the thread in which the zone was executed.
+ * \param start The date at which the zone was entered.
+ * \param duration The time spent in the zone.
+ * \pre s_mutex is locked.
+ */
+void bear::debug::profiler::write_trace_event
+( const char* name, std::size_t thread, date_type start, date_type duration )
+{
+  if ( s_trace_has_events )
+    s_trace << ",\n";
+
+  s_trace << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"ts\":"
+          << (start - s_trace_origin) / 1000.0 << ",\"dur\":"
+          << duration / 1000.0 << ",\"pid\":1,\"tid\":" << thread << '}';
+
+  s_trace_has_events = true;
+} // profiler::write_trace_event()
@@ -0,0 +1,115 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::debug::profiler_buffer class.
+ * \author Julien Jorge
+ */
+#include "debug/profiler_buffer.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param thread_index The index of the thread owning the buffer.
+ * \param capacity The minimum number of events in the buffer. It is rounded
+ *        up to a power of two.
+ */
+bear::debug::profiler_buffer::profiler_buffer
+( std::size_t thread_index, std::size_t capacity )
+  : m_thread_index(thread_index), m_head(0), m_tail(0), m_dropped(0),
+    m_closed(false)
+{
+  std::size_t size(2);
+
+  while ( size < capacity )
+    size *= 2;
+
+  m_events.resize( size );
+} // profiler_buffer::profiler_buffer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the index of the thread owning the buffer.
+ */
+std::size_t bear::debug::profiler_buffer::get_thread_index() const
+{
+  return m_thread_index;
+} // profiler_buffer::get_thread_index()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an event at the end of the buffer. This method must be called
+ *        from the thread owning the buffer.
+ * \param e The event.
+ * \return false if the buffer is full, in which case the event is dropped.
+ */
+bool bear::debug::profiler_buffer::push( const event& e )
+{
+  const std::size_t tail( m_tail.load( std::memory_order_relaxed ) );
+
+  if ( tail - m_head.load( std::memory_order_acquire ) == m_events.size() )
+    {
+      m_dropped.fetch_add( 1, std::memory_order_relaxed );
+      return false;
+    }
+
+  m_events[ tail & (m_events.size() - 1) ] = e;
+  m_tail.store( tail + 1, std::memory_order_release );
+
+  return true;
+} // profiler_buffer::push()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the first event of the buffer. This method must be called
+ *        from the thread collecting the events.
+ * \param e (out) The event.
+ * \return false if the buffer is empty.
+ */
+bool bear::debug::profiler_buffer::pop( event& e )
+{
+  const std::size_t head( m_head.load( std::memory_order_relaxed ) );
+
+  if ( head == m_tail.load( std::memory_order_acquire ) )
+    return false;
+
+  e = m_events[ head & (m_events.size() - 1) ];
+  m_head.store( head + 1, std::memory_order_release );
+
+  return true;
+} // profiler_buffer::pop()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of events dropped since the previous call and reset
+ *        the count.
+ */
+std::size_t bear::debug::profiler_buffer::take_dropped_count()
+{
+  return m_dropped.exchange( 0, std::memory_order_relaxed );
+} // profiler_buffer::take_dropped_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell that the thread owning the buffer has ended. The buffer can be
+ *        deleted once it is empty.
+ */
+void bear::debug::profiler_buffer::close()
+{
+  m_closed.store( true, std::memory_order_release );
+} // profiler_buffer::close()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the thread owning the buffer has ended.
+ */
+bool bear::debug::profiler_buffer::is_closed() const
+{
+  return m_closed.load( std::memory_order_acquire );
+} // profiler_buffer::is_closed()
@@ -0,0 +1,35 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::debug::profiler_zone class.
+ * \author Julien Jorge
+ */
+#include "debug/profiler_zone.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param z The identifier of the zone.
+ */
+bear::debug::profiler_zone::profiler_zone( profiler::zone_id z )
+  : m_zone(z), m_recorded( profiler::begin(z) )
+{
+
+} // profiler_zone::profiler_zone()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::debug::profiler_zone::~profiler_zone()
+{
+  if ( m_recorded )
+    profiler::end( m_zone );
+} // profiler_zone::~profiler_zone()
@@ -0,0 +1,157 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The performance counters collect some measures of the work done in
+ *        each frame.
+ * \author Julien Jorge
+ */
+#ifndef __DEBUG_PERFORMANCE_COUNTERS_HPP__
+#define __DEBUG_PERFORMANCE_COUNTERS_HPP__
+
+#include "debug/class_export.hpp"
+
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace debug
+  {
+    /**
+     * \brief The performance counters collect some measures of the work done
+     *        in each frame.
+     *
+     * The counters are identified by an integer obtained once from their name,
+     * usually through the BEAR_COUNTER_ADD and BEAR_COUNTER_SET macros. A
+     * counter is either summed during the frame and reset at its end, like the
+     * number of draw calls, or is a gauge keeping the last value assigned to
+     * it, like the number of active items. The values can be updated from any
+     * thread without any lock.
+     *
+     * At the end of each frame, the values of the counters are kept to be
+     * displayed and, if an export is started, written in a file, as CSV or as
+     * one JSON object per line. The columns of the CSV export are the counters
+     * registered at the end of the first exported frame, while the JSON export
+     * contains all the counters.
+     *
+     * \author Julien Jorge
+     */
+    class DEBUG_EXPORT performance_counters
+    {
+    public:
+      /** \brief The type of the identifiers of the counters. */
+      typedef unsigned int counter_id;
+
+      /** \brief The type of the values of the counters. */
+      typedef long long value_type;
+
+      /** \brief The values of the counters, indexed by identifier. */
+      typedef std::vector<value_type> value_list;
+
+    public:
+      static counter_id register_counter( const char* name );
+      static counter_id register_gauge( const char* name );
+      static std::string get_counter_name( counter_id c );
+      static std::size_t get_counter_count();
+
+      static void add( counter_id c, value_type v );
+      static void set( counter_id c, value_type v );
+
+      static void end_frame();
+      static const value_list& get_last_frame();
+
+      static bool start_export( const std::string& path );
+      static void stop_export();
+
+    private:
+      static counter_id register_counter( const char* name, bool gauge );
+
+      static void write_csv_header();
+      static void write_csv_frame( double date );
+      static void write_json_frame( double date );
+
+    private:
+      /** \brief The mutex protecting the names of the counters and the
+          export. */
+      static boost::mutex s_mutex;
+
+      /** \brief The identifiers of the counters, by name. */
+      static std::map<std::string, counter_id> s_counter_ids;
+
+      /** \brief The names of the counters, indexed by identifier. */
+      static std::vector<const char*> s_counter_names;
+
+      /** \brief Tell if the counters are gauges, indexed by identifier. */
+      static std::vector<bool> s_gauges;
+
+      /** \brief The current values of the counters. The size of this vector
+          never changes, thus it can be accessed without the mutex. */
+      static std::vector< std::atomic<value_type> > s_values;
+
+      /** \brief The values of the counters at the end of the last frame. */
+      static value_list s_last_frame;
+
+      /** \brief The number of frames ended since the start of the export. */
+      static std::size_t s_frame_index;
+
+      /** \brief The file receiving the values of the frames. */
+      static std::ofstream s_export;
+
+      /** \brief Tell if the export is done in JSON. Otherwise it is done in
+          CSV. */
+      static bool s_json_export;
+
+      /** \brief The number of counters in the header of the CSV export,
+          thus the number of values written in each row. */
+      static std::size_t s_csv_column_count;
+
+      /** \brief The date of the beginning of the export, in nanoseconds. */
+      static unsigned long long s_export_origin;
+
+    }; // class performance_counters
+  } // namespace debug
+} // namespace bear
+
+/**
+ * \brief Adds a value to a counter summed during the frame.
+ * \param name The name of the counter, a string literal.
+ * \param value The value to add.
+ */
+#define BEAR_COUNTER_ADD( name, value )                                 \
+  do                                                                    \
+    {                                                                   \
+      static const bear::debug::performance_counters::counter_id        \
+        bear_counter_id                                                 \
+        ( bear::debug::performance_counters::register_counter( name ) ); \
+      bear::debug::performance_counters::add( bear_counter_id, value ); \
+    }                                                                   \
+  while ( false )
+
+/**
+ * \brief Assigns the value of a gauge.
+ * \param name The name of the gauge, a string literal.
+ * \param value The new value of the gauge.
+ */
+#define BEAR_COUNTER_SET( name, value )                                 \
+  do                                                                    \
+    {                                                                   \
+      static const bear::debug::performance_counters::counter_id        \
+        bear_counter_id                                                 \
+        ( bear::debug::performance_counters::register_gauge( name ) );  \
+      bear::debug::performance_counters::set( bear_counter_id, value ); \
+    }                                                                   \
+  while ( false )
+
+#endif // __DEBUG_PERFORMANCE_COUNTERS_HPP__
@@ -0,0 +1,185 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The profiler measures the time spent in the zones of the code, frame
+ *        by frame.
+ * \author Julien Jorge
+ */
+#ifndef __DEBUG_PROFILER_HPP__
+#define __DEBUG_PROFILER_HPP__
+
+#include "debug/class_export.hpp"
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace debug
+  {
+    class profiler_buffer;
+
+    /**
+     * \brief The profiler measures the time spent in the zones of the code,
+     *        frame by frame.
+     *
+     * The zones are identified by an integer obtained once from their name,
+     * usually through the BEAR_PROFILE_ZONE macro. When the profiler is
+     * enabled, the entry and the exit of the zones are dated in nanoseconds
+     * and stored in a buffer specific to the thread, without any lock. At the
+     * end of each frame, the events of all the threads are collected: the
+     * zones are matched with their parent to compute the time spent in each
+     * zone alone, the durations are summed per zone in the statistics of the
+     * frame and, if a trace is started, each zone is written in a file in the
+     * Chrome trace event format, which can be opened in chrome://tracing or
+     * Perfetto.
+     *
+     * When the profiler is disabled, entering a zone costs a test.
+     *
+     * \author Julien Jorge
+     */
+    class DEBUG_EXPORT profiler
+    {
+    public:
+      /** \brief The type of the identifiers of the zones. */
+      typedef unsigned int zone_id;
+
+      /** \brief The type of the dates, in nanoseconds. */
+      typedef unsigned long long date_type;
+
+      /** \brief The measures of a zone during a frame. */
+      struct zone_statistics
+      {
+        /** \brief How many times the zone has been executed. */
+        unsigned int calls;
+
+        /** \brief The time spent in the zone, nested zones included. */
+        date_type inclusive_duration;
+
+        /** \brief The time spent in the zone, nested zones excluded. */
+        date_type self_duration;
+
+      }; // struct zone_statistics
+
+      /** \brief The measures of a frame. */
+      struct frame_statistics
+      {
+        /** \brief The date of the beginning of the frame. */
+        date_type start;
+
+        /** \brief The duration of the frame. */
+        date_type duration;
+
+        /** \brief The measures of the zones, indexed by zone identifier. */
+        std::vector<zone_statistics> zones;
+
+        /** \brief The number of events lost because a buffer was full. */
+        std::size_t dropped_events;
+
+      }; // struct frame_statistics
+
+    private:
+      /** \brief A zone entered but not exited yet in a thread. */
+      struct open_zone
+      {
+        /** \brief The identifier of the zone. */
+        zone_id zone;
+
+        /** \brief The date at which the zone was entered. */
+        date_type start;
+
+        /** \brief The time spent in the nested zones. */
+        date_type children_duration;
+
+      }; // struct open_zone
+
+      /** \brief The zones entered but not exited yet in a thread. */
+      typedef std::vector<open_zone> zone_stack;
+
+    public:
+      static zone_id register_zone( const char* name );
+      static std::string get_zone_name( zone_id z );
+      static std::size_t get_zone_count();
+
+      static date_type get_date();
+
+      static void set_enabled( bool e );
+      static bool is_enabled();
+
+      static bool begin( zone_id z );
+      static void end( zone_id z );
+
+      static void end_frame();
+      static const frame_statistics& get_last_frame();
+
+      static bool start_trace( const std::string& path );
+      static void stop_trace();
+
+    private:
+      static profiler_buffer* get_thread_buffer();
+      static void release_thread_buffer( profiler_buffer* b );
+
+      static void collect( profiler_buffer& b, zone_stack& stack );
+      static void write_trace_event
+      ( const char* name, std::size_t thread, date_type start,
+        date_type duration );
+
+    private:
+      /** \brief Tell if the events are recorded. */
+      static std::atomic<bool> s_enabled;
+
+      /** \brief The mutex protecting the zones and the list of the buffers. */
+      static boost::mutex s_mutex;
+
+      /** \brief The identifiers of the zones, by name. */
+      static std::map<std::string, zone_id> s_zone_ids;
+
+      /** \brief The names of the zones, indexed by identifier. */
+      static std::vector<const char*> s_zone_names;
+
+      /** \brief The buffer of the current thread. */
+      static boost::thread_specific_ptr<profiler_buffer> s_thread_buffer;
+
+      /** \brief The buffers of all the threads. */
+      static std::vector<profiler_buffer*> s_buffers;
+
+      /** \brief The zones open in each buffer of s_buffers, as seen by the
+          collector. */
+      static std::vector<zone_stack> s_stacks;
+
+      /** \brief The number of buffers created since the beginning. */
+      static std::size_t s_thread_count;
+
+      /** \brief The measures of the last collected frame. */
+      static frame_statistics s_last_frame;
+
+      /** \brief The measures of the frame being collected. */
+      static frame_statistics s_current_frame;
+
+      /** \brief The file receiving the trace. */
+      static std::ofstream s_trace;
+
+      /** \brief Tell if an event has been written in the trace. */
+      static bool s_trace_has_events;
+
+      /** \brief The date of the beginning of the trace. */
+      static date_type s_trace_origin;
+
+    }; // class profiler
+  } // namespace debug
+} // namespace bear
+
+#endif // __DEBUG_PROFILER_HPP__
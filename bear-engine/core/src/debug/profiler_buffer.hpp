@@ -0,0 +1,98 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The events recorded by the profiler in a thread.
+ * \author Julien Jorge
+ */
+#ifndef __DEBUG_PROFILER_BUFFER_HPP__
+#define __DEBUG_PROFILER_BUFFER_HPP__
+
+#include "debug/class_export.hpp"
+
+#include <claw/non_copyable.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace bear
+{
+  namespace debug
+  {
+    /**
+     * \brief The events recorded by the profiler in a thread.
+     *
+     * The buffer is a fixed size ring, filled by the thread it belongs to and
+     * emptied by the thread collecting the frames. Neither of them waits for
+     * the other: when the ring is full, the new events are dropped and
+     * counted.
+     *
+     * \author Julien Jorge
+     */
+    class DEBUG_EXPORT profiler_buffer:
+      private claw::pattern::non_copyable
+    {
+    public:
+      /** \brief The entry or the exit of a zone. */
+      struct event
+      {
+        /** \brief The date of the event, in nanoseconds. */
+        unsigned long long date;
+
+        /** \brief The identifier of the zone. */
+        unsigned int zone;
+
+        /** \brief Tell if the event is the entry in the zone. */
+        bool begin;
+
+      }; // struct event
+
+    public:
+      profiler_buffer( std::size_t thread_index, std::size_t capacity );
+
+      std::size_t get_thread_index() const;
+
+      bool push( const event& e );
+      bool pop( event& e );
+
+      std::size_t take_dropped_count();
+
+      void close();
+      bool is_closed() const;
+
+    private:
+      /** \brief The index of the thread in the order of the creation of the
+          buffers. */
+      const std::size_t m_thread_index;
+
+      /** \brief The events. The size is a power of two. */
+      std::vector<event> m_events;
+
+      /** \brief The index of the next event to pop, modified by the
+          consumer. */
+      std::atomic<std::size_t> m_head;
+
+      /** \brief The index of the next event to push, modified by the
+          producer. */
+      std::atomic<std::size_t> m_tail;
+
+      /** \brief The number of events dropped since the last call to
+          take_dropped_count(). */
+      std::atomic<std::size_t> m_dropped;
+
+      /** \brief Tell if the thread owning the buffer has ended. */
+      std::atomic<bool> m_closed;
+
+    }; // class profiler_buffer
+
+  } // namespace debug
+} // namespace bear
+
+#endif // __DEBUG_PROFILER_BUFFER_HPP__
@@ -0,0 +1,67 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief This class records in the profiler the time spent between its
+ *        creation and its destruction.
+ * \author Julien Jorge
+ */
+#ifndef __DEBUG_PROFILER_ZONE_HPP__
+#define __DEBUG_PROFILER_ZONE_HPP__
+
+#include "debug/profiler.hpp"
+
+#include "debug/class_export.hpp"
+
+#include <claw/non_copyable.hpp>
+
+namespace bear
+{
+  namespace debug
+  {
+    /**
+     * \brief This class records in the profiler the time spent between its
+     *        creation and its destruction.
+     * \author Julien Jorge
+     */
+    class DEBUG_EXPORT profiler_zone:
+      private claw::pattern::non_copyable
+    {
+    public:
+      explicit profiler_zone( profiler::zone_id z );
+      ~profiler_zone();
+
+    private:
+      /** \brief The identifier of the zone. */
+      const profiler::zone_id m_zone;
+
+      /** \brief Tell if the entry in the zone has been recorded. */
+      const bool m_recorded;
+
+    }; // class profiler_zone
+  } // namespace debug
+} // namespace bear
+
+#define BEAR_PROFILE_CONCAT_( a, b ) a ## b
+#define BEAR_PROFILE_CONCAT( a, b ) BEAR_PROFILE_CONCAT_( a, b )
+
+/**
+ * \brief Records in the profiler the time spent from this line to the end of
+ *        the current scope.
+ * \param name The name of the zone, a string literal.
+ */
+#define BEAR_PROFILE_ZONE( name )                                       \
+  static const bear::debug::profiler::zone_id                           \
+  BEAR_PROFILE_CONCAT( bear_profile_zone_id_, __LINE__ )                \
+  ( bear::debug::profiler::register_zone( name ) );                     \
+  bear::debug::profiler_zone                                            \
+  BEAR_PROFILE_CONCAT( bear_profile_zone_, __LINE__ )                   \
+  ( BEAR_PROFILE_CONCAT( bear_profile_zone_id_, __LINE__ ) )
+
+#endif // __DEBUG_PROFILER_ZONE_HPP__
@@ -39,6 +39,7 @@ namespace bear
   {
     class layer;
     class level;
+    class var_map;
     class world;
 
     /**
@@ -112,6 +113,9 @@ namespace bear
       virtual void pre_cache();
       virtual void progress( universe::time_type elapsed_time );
 
+      virtual void save_state( var_map& state ) const;
+      virtual void restore_state( const var_map& state );
+
       scene_visual get_visual() const;
       virtual void get_visual( std::list<scene_visual>& visuals ) const;
 
@@ -163,6 +167,7 @@ namespace bear
       id_type get_id() const;
 
       virtual const char* get_class_name() const;
+      symbol_type get_class_symbol() const;
       virtual std::size_t size_of() const;
 
       void kill();
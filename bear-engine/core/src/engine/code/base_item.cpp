@@ -14,6 +14,7 @@
 #include "engine/base_item.hpp"
 
 #include <algorithm>
+#include <unordered_map>
 #include <claw/logger.hpp>
 
 #include "engine/layer/layer.hpp"
@@ -26,7 +27,8 @@
 #include "visual/scene_shader_pop.hpp"
 #include "visual/scene_shader_push.hpp"
 
-#include "debug/scoped_time_measure.hpp"
+#include "debug/performance_counters.hpp"
+#include "debug/profiler_zone.hpp"
 
 /*----------------------------------------------------------------------------*/
 bear::engine::base_item::id_type bear::engine::base_item::s_next_id = 1;
@@ -173,6 +175,7 @@ bear::engine::base_item::base_item()
     m_flags(item_flag_z_fixed), m_dying(false), m_world(NULL)
 {
   ++s_next_id;
+  BEAR_COUNTER_ADD( "base_item/allocations", 1 );
 #ifndef NDEBUG
   s_allocated.push_front(this);
 #endif
@@ -190,6 +193,7 @@ bear::engine::base_item::base_item( const base_item& that )
   m_flags |= that.m_flags & item_flag_built;
 
   ++s_next_id;
+  BEAR_COUNTER_ADD( "base_item/allocations", 1 );
 #ifndef NDEBUG
   s_allocated.push_front(this);
 #endif
@@ -201,6 +205,8 @@ bear::engine::base_item::base_item( const base_item& that )
  */
 bear::engine::base_item::~base_item()
 {
+  BEAR_COUNTER_ADD( "base_item/deallocations", 1 );
+
 #ifndef NDEBUG
   s_item_counter.uncount(*this);
   s_allocated.erase( std::find(s_allocated.begin(), s_allocated.end(), this) );
@@ -292,6 +298,30 @@ void bear::engine::base_item::progress( universe::time_type elapsed_time )
   // nothing to do
 } // base_item::progress()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Save the variables of the item that are not part of its physical
+ *        state, in order to restore them with restore_state().
+ * \param state (out) The variables of the item.
+ *
+ * The default implementation saves nothing. The items whose behavior must be
+ * restored when the level is rolled back must override this method.
+ */
+void bear::engine::base_item::save_state( var_map& state ) const
+{
+  // nothing to do
+} // base_item::save_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restore the variables of the item saved by save_state().
+ * \param state The variables of the item.
+ */
+void bear::engine::base_item::restore_state( const var_map& state )
+{
+  // nothing to do
+} // base_item::restore_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets the visual of the item.
@@ -301,8 +331,7 @@ void bear::engine::base_item::progress( universe::time_type elapsed_time )
  */
 bear::engine::scene_visual bear::engine::base_item::get_visual() const
 {
-  BEAR_CREATE_SCOPED_TIMELOG
-    ( std::string("insert_visual ") + get_class_name() );
+  BEAR_PROFILE_ZONE( "base_item::get_visual" );
 
   visual::scene_element_sequence result;
 
@@ -666,6 +695,32 @@ const char* bear::engine::base_item::get_class_name() const
   return "bear::engine::base_item";
 } // base_item::get_class_name()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of the class of the item, interned in the symbol table.
+ *        The symbols are cached by address of the name returned by
+ *        get_class_name(), thus the name is hashed only once per class.
+ */
+bear::engine::base_item::symbol_type
+bear::engine::base_item::get_class_symbol() const
+{
+  typedef std::unordered_map<const char*, symbol_type> symbol_map;
+  static symbol_map s_symbols;
+
+  const char* const name( get_class_name() );
+  const symbol_map::const_iterator it( s_symbols.find(name) );
+
+  if ( it != s_symbols.end() )
+    return it->second;
+  else
+    {
+      const symbol_type result
+        ( text_interface::symbol_table::get_symbol(name) );
+      s_symbols[name] = result;
+      return result;
+    }
+} // base_item::get_class_symbol()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the size of the derived class.
@@ -1126,7 +1181,7 @@ void bear::engine::base_item::collision( universe::collision_info& info )
  */
 void bear::engine::base_item::time_step( universe::time_type elapsed_time )
 {
-  BEAR_CREATE_SCOPED_TIMELOG( std::string("progress ") + get_class_name() );
+  BEAR_PROFILE_ZONE( "base_item::time_step" );
 
   super::time_step(elapsed_time);
 
@@ -14,7 +14,6 @@
 #include "engine/bitmap_font_loader.hpp"
 
 #include "engine/level_globals.hpp"
-#include "engine/resource_pool.hpp"
 #include "engine/spritepos.hpp"
 
 #include "visual/font/bitmap_font.hpp"
@@ -170,15 +169,10 @@ bear::visual::bitmap_charmap bear::engine::bitmap_font_loader::read_autofont()
 void bear::engine::bitmap_font_loader::read_autofont_image
 ( visual::bitmap_charmap& cs, const std::string& image_name ) const
 {
-  const std::string spritepos_path
-    ( m_level_globals.get_spritepos_path( image_name ) );
+  const spritepos& pos( m_level_globals.get_spritepos( image_name ) );
 
-  if ( spritepos_path.empty() )
-    fail( "No spritepos file for \"" + image_name + '"' );
-
-  std::stringstream f;
-  resource_pool::get_instance().get_file(spritepos_path, f);
-  const spritepos pos( f );
+  if ( pos.empty() )
+    fail( "No spritepos file, or an empty one, for \"" + image_name + '"' );
 
   const std::size_t image_index( cs.font_images.size() );
   cs.font_images.push_back( m_level_globals.get_image(image_name) );
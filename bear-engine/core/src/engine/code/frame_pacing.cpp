@@ -0,0 +1,191 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::frame_pacing class.
+ * \author Julien Jorge
+ */
+#include "engine/frame_pacing.hpp"
+
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/*----------------------------------------------------------------------------*/
+const bear::systime::microseconds_type
+bear::engine::frame_pacing::s_histogram_step(50);
+const bear::systime::microseconds_type
+bear::engine::frame_pacing::s_max_spin_duration(4000);
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::frame_pacing::frame_pacing()
+  : m_spin_enabled(true), m_spin_duration(1000), m_last_frame(0),
+    m_last_interval(0), m_interval_count(0), m_interval_sum(0),
+    m_interval_square_sum(0), m_jitter_sum(0), m_max_interval(0),
+    m_interval_histogram(2000, 0), m_wait_count(0), m_wait_delay_sum(0),
+    m_max_wait_delay(0)
+{
+
+} // frame_pacing::frame_pacing()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the end of the waits is done by yielding the processor. If
+ *        not, the waits are done only by sleeping.
+ * \param e Yield the processor at the end of the waits.
+ */
+void bear::engine::frame_pacing::set_spin_enabled( bool e )
+{
+  m_spin_enabled = e;
+} // frame_pacing::set_spin_enabled()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait until a given date.
+ * \param date The date at which the wait ends, as given by
+ *        systime::get_date_us().
+ */
+void bear::engine::frame_pacing::wait_until( systime::microseconds_type date )
+{
+  systime::microseconds_type now( systime::get_date_us() );
+
+  if ( now >= date )
+    return;
+
+  const systime::microseconds_type spin( m_spin_enabled ? m_spin_duration : 0 );
+
+  if ( now + spin < date )
+    {
+      const systime::microseconds_type wake_up( date - spin );
+
+      systime::sleep_us( wake_up - now );
+      now = systime::get_date_us();
+
+      if ( m_spin_enabled )
+        {
+          // The spin duration follows immediately the longer delays, and
+          // slowly the shorter ones.
+          const systime::microseconds_type delay
+            ( now > wake_up ? now - wake_up : 0 );
+
+          if ( delay > m_spin_duration )
+            m_spin_duration = std::min( delay, s_max_spin_duration );
+          else
+            m_spin_duration -= (m_spin_duration - delay) / 16;
+        }
+    }
+
+  while ( now < date )
+    {
+      boost::this_thread::yield();
+      now = systime::get_date_us();
+    }
+
+  const systime::microseconds_type delay( now - date );
+
+  ++m_wait_count;
+  m_wait_delay_sum += delay;
+  m_max_wait_delay = std::max( m_max_wait_delay, delay );
+} // frame_pacing::wait_until()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell that a frame has been presented.
+ * \param date The date at which the frame has been presented, as given by
+ *        systime::get_date_us().
+ */
+void bear::engine::frame_pacing::add_frame( systime::microseconds_type date )
+{
+  if ( m_last_frame != 0 )
+    {
+      const systime::microseconds_type interval( date - m_last_frame );
+
+      if ( m_interval_count != 0 )
+        m_jitter_sum +=
+          std::abs( (double)interval - (double)m_last_interval );
+
+      ++m_interval_count;
+      m_interval_sum += interval;
+      m_interval_square_sum += (double)interval * interval;
+      m_max_interval = std::max( m_max_interval, interval );
+      m_last_interval = interval;
+
+      ++m_interval_histogram
+        [ std::min<std::size_t>
+          ( interval / s_histogram_step, m_interval_histogram.size() - 1 ) ];
+    }
+
+  m_last_frame = date;
+} // frame_pacing::add_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the statistics of the intervals between the frames and of the
+ *        waits.
+ * \param os The stream in which the statistics are written.
+ */
+void
+bear::engine::frame_pacing::print_statistics( std::ostream& os ) const
+{
+  os << "frames: " << m_interval_count + (m_last_frame == 0 ? 0 : 1) << '\n';
+
+  if ( m_interval_count != 0 )
+    {
+      const double mean( m_interval_sum / m_interval_count );
+      const double variance
+        ( m_interval_square_sum / m_interval_count - mean * mean );
+
+      os << "mean frame interval us: " << mean << '\n'
+         << "frame interval std deviation us: "
+         << std::sqrt( std::max( 0.0, variance ) ) << '\n'
+         << "p50 frame interval us: " << get_interval_percentile( 0.5 ) << '\n'
+         << "p99 frame interval us: " << get_interval_percentile( 0.99 )
+         << '\n'
+         << "max frame interval us: " << m_max_interval << '\n';
+
+      if ( m_interval_count > 1 )
+        os << "mean jitter us: " << m_jitter_sum / (m_interval_count - 1)
+           << '\n';
+    }
+
+  os << "waits: " << m_wait_count << '\n';
+
+  if ( m_wait_count != 0 )
+    os << "mean wake up delay us: " << m_wait_delay_sum / m_wait_count << '\n'
+       << "max wake up delay us: " << m_max_wait_delay << '\n';
+
+  os << std::flush;
+} // frame_pacing::print_statistics()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an upper bound of a percentile of the intervals between the
+ *        frames, with the precision of the histogram.
+ * \param p The percentile, in [0, 1].
+ */
+bear::systime::microseconds_type
+bear::engine::frame_pacing::get_interval_percentile( double p ) const
+{
+  const std::size_t rank( std::ceil( p * m_interval_count ) );
+  std::size_t count(0);
+
+  for ( std::size_t i=0; i!=m_interval_histogram.size(); ++i )
+    {
+      count += m_interval_histogram[i];
+
+      if ( (count >= rank) && (count != 0) )
+        return (i + 1) * s_histogram_step;
+    }
+
+  return m_max_interval;
+} // frame_pacing::get_interval_percentile()
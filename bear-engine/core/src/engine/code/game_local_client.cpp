@@ -13,7 +13,8 @@
  */
 #include "engine/game_local_client.hpp"
 
-#include "debug/timing_log.hpp"
+#include "debug/performance_counters.hpp"
+#include "debug/profiler.hpp"
 
 #include "engine/game_action/game_action.hpp"
 #include "engine/game_action/game_action_load_level.hpp"
@@ -25,6 +26,8 @@
 #include "engine/level.hpp"
 #include "engine/level_globals.hpp"
 #include "engine/level_loader.hpp"
+#include "engine/level_state.hpp"
+#include "engine/resource_cache.hpp"
 #include "engine/resource_pool.hpp"
 #include "engine/version.hpp"
 
@@ -51,6 +54,11 @@
 #include <claw/logger.hpp>
 #include <claw/socket_traits.hpp>
 #include <claw/string_algorithm.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
 #include <sstream>
 
 /*----------------------------------------------------------------------------*/
@@ -104,6 +112,9 @@ bear::engine::game_local_client::~game_local_client()
   close_environment();
 
   base_item::print_allocated();
+
+  debug::profiler::stop_trace();
+  debug::performance_counters::stop_export();
 } // game_local_client::~game_local_client()
 
 /*----------------------------------------------------------------------------*/
@@ -124,6 +135,9 @@ void bear::engine::game_local_client::run()
       
       run_level();
 
+      if ( m_print_frame_pacing )
+        m_frame_pacing.print_statistics( std::cout );
+
       end_game();
 
       clear();
@@ -721,7 +735,12 @@ void bear::engine::game_local_client::constructor_common_init_members()
   m_time_scale = 1;
   m_frames_per_second = 60;
   m_synchronized_render = false;
+  m_interpolated_render = false;
+  m_millisecond_scheduler = false;
+  m_print_frame_pacing = false;
   m_level_paused_sync = false;
+  m_rollback_state = NULL;
+  m_network_spectator = false;
   m_event_manager = NULL;
 } // game_local_client::constructor_common_init_members()
 
@@ -822,13 +841,29 @@ std::string bear::engine::game_local_client::get_formatted_game_name() const
   return result;
 } // game_local_client::get_formatted_game_name()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the current date used to schedule the iterations, in
+ *        microseconds.
+ */
+bear::systime::microseconds_type
+bear::engine::game_local_client::get_date() const
+{
+  const systime::microseconds_type result( systime::get_date_us() );
+
+  if ( m_millisecond_scheduler )
+    return result - result % 1000;
+  else
+    return result;
+} // game_local_client::get_date()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Assigns the current date to m_last_progress.
  */
 void bear::engine::game_local_client::set_last_progress_date()
 {
-  m_last_progress = systime::get_date_ms();
+  m_last_progress = get_date();
 } // game_local_client::set_last_progress_date()
 
 /*----------------------------------------------------------------------------*/
@@ -867,43 +902,111 @@ void bear::engine::game_local_client::run_level()
  */
 void bear::engine::game_local_client::one_step_beyond()
 {
-  systime::milliseconds_type current_time( systime::get_date_ms() );
+  if ( m_input_record.is_replaying() )
+    {
+      fast_forward();
+      return;
+    }
+
+  const systime::microseconds_type current_time( get_date() );
 
   // The value of m_time_scale may be changed by an item during the progress
   const universe::time_type time_scale( m_time_scale );
-  const universe::time_type time_range( current_time - m_last_progress );
-  universe::time_type dt( time_range * time_scale );
 
-  if ( dt >= m_time_step )
-    {
-      progress( current_time, dt, time_range, time_scale );
-      render();
+  // in milliseconds
+  const universe::time_type time_range
+    ( (universe::time_type)(current_time - m_last_progress) / 1000 );
+  const universe::time_type dt( time_range * time_scale );
 
-      current_time = systime::get_date_ms();
+  const bool progressed( dt >= m_time_step );
+  const systime::microseconds_type last_render( m_last_render );
+
+  if ( progressed )
+    progress( current_time, dt, time_range, time_scale );
+
+  if ( progressed || m_interpolated_render )
+    render();
+
+  if ( progressed || (m_last_render != last_render) )
+    {
+      debug::profiler::end_frame();
+      debug::performance_counters::end_frame();
     }
-  
-  if ( current_time < m_last_progress + m_time_step )
-    systime::sleep( m_last_progress + m_time_step - current_time );
+
+  systime::microseconds_type next_date
+    ( m_last_progress + (systime::microseconds_type)m_time_step * 1000 );
+
+  if ( m_interpolated_render && (m_frames_per_second != 0) )
+    next_date =
+      std::min( next_date, m_last_render + 1000000 / m_frames_per_second );
+
+  m_frame_pacing.wait_until( next_date );
 } // game_local_client::one_step_beyond()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do one progress of the game with the inputs of the replayed
+ *        recording, without rendering nor waiting for the time of the tick.
+ */
+void bear::engine::game_local_client::fast_forward()
+{
+  synchronous_progress( m_time_step );
+  debug::profiler::end_frame();
+  debug::performance_counters::end_frame();
+} // game_local_client::fast_forward()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Try to synchronize the network and pause the level if it is not
  *        synchronized.
+ *
+ * If the network has received messages contradicting the predictions of the
+ * previous iterations, the level is rolled back and these iterations are
+ * replayed. The state of the level is saved before the first iteration played
+ * with predicted messages.
+ *
+ * If the game is a spectator, the level receives the state of the items sent
+ * by the servers.
+ *
+ * Once an item of the saved state is killed, the state can't be restored
+ * anymore, so the game stops predicting the messages and waits for the
+ * actual ones. If the level can't be rolled back anyway, the game ends rather
+ * than continuing desynchronized.
  */
 bool bear::engine::game_local_client::synchronize_network()
 {
+  if ( (m_rollback_state != NULL) && !m_rollback_state->is_complete() )
+    m_network.suspend_prediction();
+
   bool result(false);
+  bool synchronized( m_network.synchronize() );
 
-  if ( m_network.synchronize() )
-    {
-      result = true;
+  if ( m_network_spectator )
+    m_network.apply_snapshots( *m_current_level );
 
+  if ( synchronized )
+    {
       if ( m_level_paused_sync )
         {
           m_current_level->unset_pause();
           m_level_paused_sync = false;
         }
+
+      if ( m_network.get_rollback_length() != 0 )
+        synchronized = roll_back();
+    }
+
+  if ( synchronized )
+    {
+      result = true;
+
+      if ( !m_network.has_prediction() )
+        clear_rollback_state();
+      else if ( m_rollback_state == NULL )
+        {
+          m_rollback_state = new level_state;
+          m_current_level->save_state( *m_rollback_state );
+        }
     }
   else if ( !m_level_paused_sync )
     {
@@ -914,6 +1017,69 @@ bool bear::engine::game_local_client::synchronize_network()
   return result;
 } // game_local_client::synchronize_network()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restore the state of the level saved before the first iteration
+ *        played with predicted network messages, then replay the iterations
+ *        with the actual messages.
+ * \return false if the level can't be restored, in which case the game is
+ *         ended.
+ */
+bool bear::engine::game_local_client::roll_back()
+{
+  if ( (m_rollback_state == NULL)
+       || !m_current_level->restore_state( *m_rollback_state ) )
+    {
+      claw::logger << claw::log_error
+                   << "The level can't be rolled back to its state before the"
+                   << " mispredicted iterations. Ending the game to avoid a"
+                   << " desynchronization." << std::endl;
+      m_network.end_rollback();
+      clear_rollback_state();
+      end();
+      return false;
+    }
+
+  const std::size_t n( m_network.get_rollback_length() );
+  bool saved(false);
+
+  for ( std::size_t i=0; i!=n; ++i )
+    {
+      const bool confirmed( m_network.replay(i) );
+
+      // Keep the state before the first iteration still played with predicted
+      // messages.
+      if ( !confirmed && !saved )
+        {
+          if ( i != 0 )
+            m_current_level->save_state( *m_rollback_state );
+
+          saved = true;
+        }
+
+      m_current_level->progress( (universe::time_type)m_time_step / 1000 );
+    }
+
+  m_network.end_rollback();
+
+  // All the replayed iterations are confirmed. The state will be saved before
+  // the current iteration if it is still predicted.
+  if ( !saved )
+    clear_rollback_state();
+
+  return true;
+} // game_local_client::roll_back()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Forget the state saved to roll back the current level.
+ */
+void bear::engine::game_local_client::clear_rollback_state()
+{
+  delete m_rollback_state;
+  m_rollback_state = NULL;
+} // game_local_client::clear_rollback_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Do one progress of the game.
@@ -930,7 +1096,10 @@ bear::engine::game_local_client::synchronous_progress( universe::time_type dt )
           
   progress( (universe::time_type)m_time_step / 1000 ); // seconds
 
+  m_network.send_snapshot( *m_current_level );
+
   // send a synchronization message on each server
+  m_network.adjust_input_delay( m_time_step );
   m_network.send_synchronization();
 
   const universe::time_type result = dt - m_time_step;
@@ -950,7 +1119,7 @@ bear::engine::game_local_client::synchronous_progress( universe::time_type dt )
  */
 bear::universe::time_type
 bear::engine::game_local_client::asynchronous_progress
-( universe::time_type t, systime::milliseconds_type current_time,
+( universe::time_type t, systime::microseconds_type current_time,
   universe::time_type time_range )
 {
   bool overload = false;
@@ -964,12 +1133,17 @@ bear::engine::game_local_client::asynchronous_progress
 
       progress( (universe::time_type)m_time_step / 1000 ); // seconds
       
+      m_network.send_snapshot( *m_current_level );
+
       // send a synchronization message on each server
+      m_network.adjust_input_delay( m_time_step );
       m_network.send_synchronization();
 
       dt -= m_time_step;
 
-      overload = (systime::get_date_ms() - current_time > time_range);
+      overload =
+        ( (universe::time_type)(get_date() - current_time) / 1000
+          > time_range );
     }
   while ( (dt >= m_time_step) && (m_time_step > 0) && !overload );
 
@@ -991,18 +1165,21 @@ bear::engine::game_local_client::asynchronous_progress
  *        game's time.
  */
 void bear::engine::game_local_client::progress
-( systime::milliseconds_type current_time, universe::time_type dt,
+( systime::microseconds_type current_time, universe::time_type dt,
   universe::time_type time_range, universe::time_type time_scale )
 {
   set_time_scale(1);
   m_last_progress = current_time;
 
-  if ( m_synchronized_render )
+  // The recorded inputs are replayed one tick per iteration, thus the session
+  // must also do one tick per iteration to apply the post actions at the same
+  // ticks.
+  if ( m_synchronized_render || m_input_record.is_recording() )
     dt = synchronous_progress(dt);
   else
     dt = asynchronous_progress(dt, current_time, time_range);
 
-  m_last_progress -= dt / time_scale;
+  m_last_progress -= dt / time_scale * 1000;
 } // game_local_client::progress()
 
 /*----------------------------------------------------------------------------*/
@@ -1019,7 +1196,25 @@ void bear::engine::game_local_client::progress
         m_screen->get_size(),
         m_screen->get_viewport_size() ) );
       
-  input::system::get_instance().refresh();
+  if ( m_input_record.is_replaying() )
+    {
+      if ( !m_input_record.replay( *m_current_level ) )
+        {
+          m_input_record.stop();
+          end();
+          return;
+        }
+    }
+  else
+    {
+      input::system::get_instance().refresh();
+
+      if ( m_input_record.is_recording() )
+        m_input_record.record( *m_current_level );
+    }
+
+  if ( m_interpolated_render )
+    m_render_interpolation.save_positions( *m_current_level );
 
   m_current_level->progress( elapsed_time );
 } // game_local_client::progress()
@@ -1032,23 +1227,53 @@ void bear::engine::game_local_client::render()
 {
   if ( (m_frames_per_second != 0) && !m_synchronized_render )
     {
-      const systime::milliseconds_type render_date
-        ( m_last_render + 1000 / m_frames_per_second );
-      const systime::milliseconds_type current_date( systime::get_date_ms() );
+      const systime::microseconds_type render_date
+        ( m_last_render + 1000000 / m_frames_per_second );
+      const systime::microseconds_type current_date( get_date() );
 
+      // The interpolated renderings are done between the progresses, thus
+      // they can wait for the exact date.
       if ( (current_date < render_date)
-           && (render_date - current_date > m_time_step) )
+           && ( m_interpolated_render
+                || (render_date - current_date
+                    > (systime::microseconds_type)m_time_step * 1000) ) )
         return;
     }
 
+  if ( m_interpolated_render )
+    m_render_interpolation.interpolate
+      ( *m_current_level, get_interpolation_ratio() );
+
   // effective procedure
   m_screen->begin_render();
   m_current_level->render( *m_screen );
   m_screen->end_render();
 
-  m_last_render = systime::get_date_ms();
+  if ( m_interpolated_render )
+    m_render_interpolation.restore();
+
+  m_last_render = get_date();
+  m_frame_pacing.add_frame( m_last_render );
 } // game_local_client::render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the progression of the time from the state of the level before
+ *        the last progress (zero) to its current state (one), for the
+ *        interpolated renderings.
+ */
+double bear::engine::game_local_client::get_interpolation_ratio() const
+{
+  const systime::microseconds_type now( get_date() );
+
+  if ( (m_time_step == 0) || (now <= m_last_progress) )
+    return 0;
+
+  const double elapsed( (double)(now - m_last_progress) * m_time_scale );
+
+  return std::min( 1.0, elapsed / (m_time_step * 1000) );
+} // game_local_client::get_interpolation_ratio()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Initialize the environment (screen, inputs, sounds).
@@ -1265,6 +1490,8 @@ void bear::engine::game_local_client::close_level()
 {
   CLAW_PRECOND( m_current_level != NULL );
 
+  clear_rollback_state();
+
   delete m_current_level;
   m_current_level = NULL;
 
@@ -1284,6 +1511,8 @@ void bear::engine::game_local_client::do_push_level( const std::string& path )
 
   CLAW_PRECOND( m_level_in_abeyance == NULL );
 
+  clear_rollback_state();
+
   m_level_in_abeyance = m_current_level;
   m_level_in_abeyance->set_pause();
   m_current_level = NULL;
@@ -1349,6 +1578,9 @@ void bear::engine::game_local_client::clear()
       close_level();
     }
 
+  // The cached images hold textures, which must be released with the screen.
+  resource_cache::get_instance().clear();
+
   if (m_screen != NULL)
     {
       delete m_screen;
@@ -1400,6 +1632,34 @@ bool bear::engine::game_local_client::check_arguments( int& argc, char** &argv )
   if ( arg.has_value("--tag") )
     m_stats.set_tag( arg.get_string("--tag") );
 
+  if ( arg.has_value("--replay-input") )
+    {
+      if ( m_input_record.start_replay( arg.get_string("--replay-input") ) )
+        {
+          m_time_step = m_input_record.get_time_step();
+          srand( m_input_record.get_seed() );
+        }
+      else
+        help = "--replay-input=" + arg.get_string("--replay-input");
+    }
+  else if ( arg.has_value("--record-input") )
+    {
+      const unsigned int seed( time(NULL) );
+
+      if ( m_input_record.start_recording
+           ( arg.get_string("--record-input"), m_time_step, seed ) )
+        srand( seed );
+      else
+        help = "--record-input=" + arg.get_string("--record-input");
+    }
+
+  if ( arg.has_value("--profile-trace") )
+    debug::profiler::start_trace( arg.get_string("--profile-trace") );
+
+  if ( arg.has_value("--performance-counters") )
+    debug::performance_counters::start_export
+      ( arg.get_string("--performance-counters") );
+
   m_fullscreen = arg.get_bool("--fullscreen") && !arg.get_bool("--windowed");
   
   if ( arg.has_value("--network-horizon") )
@@ -1410,6 +1670,35 @@ bool bear::engine::game_local_client::check_arguments( int& argc, char** &argv )
         help = "--network-horizon=" + arg.get_string("--network-horizon");
     }
 
+  if ( arg.has_value("--network-max-horizon") )
+    {
+      if ( arg.only_integer_values("--network-max-horizon") )
+        m_network.set_max_horizon( arg.get_integer("--network-max-horizon") );
+      else
+        help =
+          "--network-max-horizon=" + arg.get_string("--network-max-horizon");
+    }
+
+  if ( arg.has_value("--network-rollback") )
+    {
+      if ( arg.only_integer_values("--network-rollback") )
+        m_network.set_max_rollback( arg.get_integer("--network-rollback") );
+      else
+        help = "--network-rollback=" + arg.get_string("--network-rollback");
+    }
+
+  if ( arg.has_value("--network-snapshot-period") )
+    {
+      if ( arg.only_integer_values("--network-snapshot-period") )
+        m_network.set_snapshot_period
+          ( arg.get_integer("--network-snapshot-period") );
+      else
+        help = "--network-snapshot-period="
+          + arg.get_string("--network-snapshot-period");
+    }
+
+  m_network_spectator = arg.get_bool("--network-spectator");
+
   if ( arg.has_value("--game-var-assignment") )
     {
       const std::string v( arg.get_string("--game-var-assignment") );
@@ -1445,6 +1734,10 @@ bool bear::engine::game_local_client::check_arguments( int& argc, char** &argv )
       ( arg.get_all_of_string("--set-game-var-string"), game_var_assignment );
 
   m_synchronized_render = arg.get_bool("--sync-render");
+  m_interpolated_render = arg.get_bool("--interpolated-render");
+  m_millisecond_scheduler = arg.get_bool("--millisecond-scheduler");
+  m_print_frame_pacing = arg.get_bool("--frame-pacing-stats");
+  m_frame_pacing.set_spin_enabled( !m_millisecond_scheduler );
 
   if ( arg.has_value("--fps") )
     {
@@ -1549,6 +1842,29 @@ claw::arguments_table bear::engine::game_local_client::get_arguments_table()
       bear_gettext("The delay to apply to the network messages in term of game"
                    " iterations. Default is 1."),
       true, bear_gettext("value") );
+  arg.add_long
+    ( "--network-max-horizon",
+      bear_gettext("The maximum delay to apply to the network messages when it"
+                   " is adjusted according to the round trip times. Default is"
+                   " the value of --network-horizon."),
+      true, bear_gettext("value") );
+  arg.add_long
+    ( "--network-rollback",
+      bear_gettext("The maximum number of iterations played with predicted"
+                   " network messages before waiting for the actual messages."
+                   " Default is 0, meaning no prediction."),
+      true, bear_gettext("value") );
+  arg.add_long
+    ( "--network-snapshot-period",
+      bear_gettext("The number of iterations between two snapshots of the"
+                   " level sent to the clients. Default is 0, meaning no"
+                   " snapshot."),
+      true, bear_gettext("value") );
+  arg.add_long
+    ( "--network-spectator",
+      bear_gettext("Set the state of the level according to the snapshots"
+                   " received from the network."),
+      true );
   arg.add_long
     ( "--set-game-var-int",
       bear_gettext("Sets the value of an integer game variable."), true,
@@ -1587,6 +1903,34 @@ claw::arguments_table bear::engine::game_local_client::get_arguments_table()
       bear_gettext("Associates an identifier with this game."),
       true );
 
+  arg.add_long
+    ( "--record-input",
+      bear_gettext
+      ("Records the inputs of the session in the given file."),
+      true, bear_gettext("file") );
+
+  arg.add_long
+    ( "--replay-input",
+      bear_gettext
+      ("Replays the inputs recorded in the given file as fast as possible,"
+       " without rendering, then prints the number of ticks per second."),
+      true, bear_gettext("file") );
+
+  arg.add_long
+    ( "--profile-trace",
+      bear_gettext
+      ("Writes the time spent in the profiled zones of the engine in the given"
+       " file, in the Chrome trace event format."),
+      true, bear_gettext("file") );
+
+  arg.add_long
+    ( "--performance-counters",
+      bear_gettext
+      ("Writes the performance counters of each frame in the given file, as"
+       " one JSON object per line if its name ends with .json, as CSV"
+       " otherwise."),
+      true, bear_gettext("file") );
+
   arg.add_long
     ( "--fps",
       bear_gettext("Sets the limit of the number of frames per second."),
@@ -1597,6 +1941,25 @@ claw::arguments_table bear::engine::game_local_client::get_arguments_table()
       bear_gettext
       ("Tells to do a rendering of the scene for each progress of the game."),
       true );
+  arg.add_long
+    ( "--interpolated-render",
+      bear_gettext
+      ("Renders the items between their positions of the last two progresses"
+       " of the game, and renders between the progresses as often as allowed"
+       " by --fps."),
+      true );
+  arg.add_long
+    ( "--millisecond-scheduler",
+      bear_gettext
+      ("Measures the time between the iterations in milliseconds and waits by"
+       " sleeping only, like the previous versions of the engine."),
+      true );
+  arg.add_long
+    ( "--frame-pacing-stats",
+      bear_gettext
+      ("Prints the statistics of the intervals between the frames at the end"
+       " of the game."),
+      true );
   arg.add
     ( "-v", "--version",
       bear_gettext("Prints the version of the engine and exit."),
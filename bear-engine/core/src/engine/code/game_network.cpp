@@ -15,13 +15,27 @@
 
 #include "engine/network/client_connection.hpp"
 #include "engine/network/message/sync.hpp"
+#include "engine/network/message/world_snapshot.hpp"
+
+#include <claw/logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/*----------------------------------------------------------------------------*/
+const double bear::engine::game_network::s_delay_decrease_duration = 2000;
+const std::size_t bear::engine::game_network::s_keyframe_period = 32;
 
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
  */
 bear::engine::game_network::game_network()
-  : m_sync_id(0), m_min_horizon(1), m_active(false)
+  : m_sync_id(0), m_min_horizon(1), m_max_horizon(1), m_input_delay(1),
+    m_target_delay(1), m_lower_delay_duration(0), m_max_rollback(0),
+    m_misprediction(false), m_prediction_suspended(false), m_replaying(false),
+    m_snapshot_period(0), m_snapshot_countdown(0), m_keyframe_countdown(0),
+    m_active(false)
 {
 
 } // game_network::game_network()
@@ -35,6 +49,10 @@ bear::engine::game_network::~game_network()
   for ( server_map::const_iterator it=m_server.begin(); it!=m_server.end();
         ++it )
     delete it->second;
+
+  for ( client_list::const_iterator it=m_client.begin(); it!=m_client.end();
+        ++it )
+    delete *it;
 } // game_network::~game_network()
 
 /*----------------------------------------------------------------------------*/
@@ -117,11 +135,307 @@ std::size_t bear::engine::game_network::get_min_horizon() const
 void bear::engine::game_network::set_min_horizon( std::size_t m )
 {
   m_min_horizon = m;
+  m_max_horizon = std::max( m_max_horizon, m );
 } // game_network::set_min_horizon()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Send a message through a service.
+ * \brief Get the maximum input delay.
+ */
+std::size_t bear::engine::game_network::get_max_horizon() const
+{
+  return m_max_horizon;
+} // game_network::get_max_horizon()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the maximum input delay. The input delay is fixed if the maximum
+ *        is equal to the minimum horizon.
+ * \param m The maximum input delay, in iterations.
+ */
+void bear::engine::game_network::set_max_horizon( std::size_t m )
+{
+  m_max_horizon = std::max( m, m_min_horizon );
+} // game_network::set_max_horizon()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of iterations between the dispatch of the messages
+ *        and their processing by the clients.
+ */
+std::size_t bear::engine::game_network::get_input_delay() const
+{
+  return m_input_delay;
+} // game_network::get_input_delay()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the input delay required by the round trip times measured on
+ *        the connections of the servers. The input delay is actually changed
+ *        by send_synchronization().
+ * \param iteration_duration The duration of an iteration, in milliseconds.
+ *
+ * The messages must reach the clients within the input delay, thus the delay
+ * covers half of the round trip time plus four deviations, as in the
+ * retransmission timer of TCP, and an iteration for the processing. The delay
+ * is increased as soon as needed but decreased only when the round trips have
+ * been shorter for a while, to avoid changing it at each spike.
+ */
+void
+bear::engine::game_network::adjust_input_delay( double iteration_duration )
+{
+  if ( iteration_duration <= 0 )
+    return;
+
+  double latency(0);
+
+  for ( server_map::const_iterator it=m_server.begin(); it!=m_server.end();
+        ++it )
+    for ( std::size_t i=0; i!=it->second->get_connection_count(); ++i )
+      {
+        const net::connection_statistics stats
+          ( it->second->get_statistics(i) );
+
+        latency =
+          std::max
+          ( latency,
+            stats.round_trip_time / 2 + 4 * stats.round_trip_time_deviation );
+      }
+
+  if ( latency == 0 )
+    return;
+
+  const std::size_t delay
+    ( std::min
+      ( m_max_horizon,
+        std::max
+        ( m_min_horizon,
+          (std::size_t)std::ceil( latency / iteration_duration ) + 1 ) ) );
+
+  if ( delay >= m_target_delay )
+    {
+      m_target_delay = delay;
+      m_lower_delay_duration = 0;
+    }
+  else
+    {
+      m_lower_delay_duration += iteration_duration;
+
+      if ( m_lower_delay_duration >= s_delay_decrease_duration )
+        {
+          m_target_delay = delay;
+          m_lower_delay_duration = 0;
+        }
+    }
+} // game_network::adjust_input_delay()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the maximum number of iterations played with predicted messages.
+ */
+std::size_t bear::engine::game_network::get_max_rollback() const
+{
+  return m_max_rollback;
+} // game_network::get_max_rollback()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the maximum number of iterations played with predicted messages.
+ * \param n The number of iterations. Zero disables the rollback.
+ */
+void bear::engine::game_network::set_max_rollback( std::size_t n )
+{
+  m_max_rollback = n;
+} // game_network::set_max_rollback()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if some iterations since the last saved state of the level have
+ *        been played with predicted messages not confirmed yet. In this case
+ *        the state of the level before the first of them must be kept in
+ *        order to replay them.
+ */
+bool bear::engine::game_network::has_prediction() const
+{
+  return !m_history.empty();
+} // game_network::has_prediction()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop playing the iterations with predicted messages until the
+ *        predictions of the past iterations are confirmed.
+ *
+ * The game calls this method when the saved state of the level can't be
+ * restored anymore, for example when an item of this state has been killed.
+ * A misprediction could not be replayed, so the game waits for the actual
+ * messages.
+ */
+void bear::engine::game_network::suspend_prediction()
+{
+  m_prediction_suspended = true;
+} // game_network::suspend_prediction()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of past iterations to replay since some predicted
+ *        messages were wrong. Zero if there is nothing to replay.
+ *
+ * The iterations must be replayed from the state of the level saved before
+ * the first iteration played with predicted messages, after the call to
+ * synchronize() and before playing the current iteration.
+ */
+std::size_t bear::engine::game_network::get_rollback_length() const
+{
+  if ( m_misprediction )
+    return m_history.size() - 1;
+  else
+    return 0;
+} // game_network::get_rollback_length()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the messages of the clients for an iteration to replay.
+ * \param i The index of the iteration to replay, from the oldest one.
+ * \return true if the messages of this iteration and of the previous ones
+ *         are the actual messages, false if some of them are still predicted.
+ *
+ * The messages dispatched by the game are not sent while the iterations are
+ * replayed, since they were already sent when the iterations were played the
+ * first time.
+ */
+bool bear::engine::game_network::replay( std::size_t i )
+{
+  CLAW_PRECOND( i < get_rollback_length() );
+
+  m_replaying = true;
+  set_iteration_messages( m_history[i] );
+
+  bool result(true);
+
+  for ( std::size_t j=0; result && (j<=i); ++j )
+    result = is_confirmed( m_history[j] );
+
+  return result;
+} // game_network::replay()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restore the messages of the current iteration after the replay of the
+ *        past iterations.
+ *
+ * The iterations before the first one still played with predicted messages
+ * are forgotten, thus the state of the level must be saved again before this
+ * iteration during the replay.
+ */
+void bear::engine::game_network::end_rollback()
+{
+  CLAW_PRECOND( !m_history.empty() );
+
+  set_iteration_messages( m_history.back() );
+
+  m_replaying = false;
+  m_misprediction = false;
+
+  while ( !m_history.empty() && is_confirmed( m_history.front() ) )
+    m_history.pop_front();
+} // game_network::end_rollback()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of iterations between two snapshots of the level.
+ */
+std::size_t bear::engine::game_network::get_snapshot_period() const
+{
+  return m_snapshot_period;
+} // game_network::get_snapshot_period()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the number of iterations between two snapshots of the level.
+ * \param n The number of iterations. Zero disables the snapshots.
+ */
+void bear::engine::game_network::set_snapshot_period( std::size_t n )
+{
+  m_snapshot_period = n;
+  m_snapshot_countdown = 0;
+} // game_network::set_snapshot_period()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Send the changes in the state of the level since the previous
+ *        snapshot to the clients of all servers, if the period of the
+ *        snapshots is elapsed. The complete state is sent every
+ *        s_keyframe_period snapshots.
+ * \param lvl The level.
+ *
+ * This method must be called once per iteration.
+ */
+void bear::engine::game_network::send_snapshot( const level& lvl )
+{
+  if ( (m_snapshot_period == 0) || m_server.empty() )
+    return;
+
+  if ( m_snapshot_countdown != 0 )
+    {
+      --m_snapshot_countdown;
+      return;
+    }
+
+  m_snapshot_countdown = m_snapshot_period - 1;
+
+  world_snapshot_state state;
+  state.capture( m_snapshot.get_id() + 1, lvl );
+
+  world_snapshot s;
+
+  // A keyframe is sent periodically such that the clients having missed a
+  // snapshot, thus rejecting the next deltas, can resume.
+  if ( m_keyframe_countdown == 0 )
+    {
+      state.make_keyframe( s );
+      m_keyframe_countdown = s_keyframe_period - 1;
+    }
+  else
+    {
+      state.make_delta( m_snapshot, s );
+      --m_keyframe_countdown;
+    }
+
+  std::swap( m_snapshot, state );
+
+  for ( server_map::const_iterator it=m_server.begin(); it!=m_server.end();
+        ++it )
+    it->second->dispatch_message( s );
+} // game_network::send_snapshot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the state of the items of a level according to the snapshots
+ *        received since the previous call.
+ * \param lvl The level.
+ * \return The number of items updated.
+ *
+ * The items are matched by identifier, thus the level must have been built
+ * the same way than the level of the servers.
+ */
+std::size_t bear::engine::game_network::apply_snapshots( level& lvl )
+{
+  std::size_t result(0);
+
+  for ( std::set<client_connection*>::const_iterator it =
+          m_updated_snapshots.begin();
+        it != m_updated_snapshots.end(); ++it )
+    result += m_remote_snapshot[*it].apply( lvl );
+
+  m_updated_snapshots.clear();
+
+  return result;
+} // game_network::apply_snapshots()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Send a message through a service. Nothing is sent while the
+ *        iterations are replayed.
  * \param service_name The name of the service.
  * \param m The message to send.
  */
@@ -130,6 +444,9 @@ void bear::engine::game_network::send_message
 {
   CLAW_PRECOND( m_server.find(service_name) != m_server.end() );
 
+  if ( m_replaying )
+    return;
+
   m.set_date( m_sync_id );
 
   m_server.find(service_name)->second->dispatch_message(m);
@@ -146,7 +463,7 @@ void bear::engine::game_network::create_service
 {
   if ( m_server.find(name) == m_server.end() )
     {
-      net::server* s = new net::server(port);
+      net::server* s = new net::server(m_io, port);
       s->on_new_client.connect
         ( boost::bind( &game_network::on_new_client, this, s, _1 ) );
       m_server[name] = s;
@@ -195,26 +512,52 @@ bool bear::engine::game_network::synchronize()
   for ( client_list::iterator it=m_client.begin(); it!=m_client.end(); ++it )
     pull_client_messages(*it);
 
-  m_active = set_client_messages();
+  if ( m_max_rollback == 0 )
+    m_active = set_client_messages();
+  else
+    m_active = predict_client_messages();
 
   return m_active;
 } // game_network::synchronize()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Send a sync message on all servers.
+ * \brief Send a sync message on all servers, then send all the messages
+ *        dispatched since the previous synchronization.
+ *
+ * The input delay moves by one iteration toward the delay computed by
+ * adjust_input_delay(). It is increased by sending an additional empty
+ * message list, and decreased by sending no sync message, such that the
+ * messages of this iteration are processed with the ones of the next
+ * iteration.
  */
 void bear::engine::game_network::send_synchronization()
 {
-  if ( !m_active )
-    return;
+  if ( m_active )
+    {
+      const std::size_t target
+        ( std::min
+          ( m_max_horizon, std::max( m_min_horizon, m_target_delay ) ) );
+
+      if ( m_input_delay > target )
+        --m_input_delay;
+      else
+        {
+          dispatch_synchronization( m_sync_id + m_input_delay );
+
+          if ( m_input_delay < target )
+            {
+              ++m_input_delay;
+              dispatch_synchronization( m_sync_id + m_input_delay );
+            }
+        }
 
-  sync s(m_sync_id + m_min_horizon, true);
-  ++m_sync_id;
+      ++m_sync_id;
+    }
 
   for ( server_map::const_iterator it=m_server.begin(); it!=m_server.end();
         ++it )
-    it->second->dispatch_message( s );
+    it->second->flush();
 } // game_network::send_synchronize()
 
 /*----------------------------------------------------------------------------*/
@@ -228,7 +571,7 @@ bear::engine::client_connection*
 bear::engine::game_network::create_new_client
 ( const std::string& host, unsigned int port )
 {
-  client_connection* result = new client_connection(host, port);
+  client_connection* result = new client_connection(m_io, host, port);
   m_client.push_back( result );
   m_future[result] = client_future( get_min_horizon() );
 
@@ -239,6 +582,9 @@ bear::engine::game_network::create_new_client
 /**
  * \brief Read the messages of a client until a sync message is received.
  * \param c The client from which the messages are read.
+ *
+ * The world snapshots update the state of the level of the server of the
+ * client instead of being stored in its future.
  */
 void bear::engine::game_network::pull_client_messages( client_connection* c )
 {
@@ -246,7 +592,18 @@ void bear::engine::game_network::pull_client_messages( client_connection* c )
 
   while ( m != NULL )
     {
-      m_future[c].push_message( m );
+      const world_snapshot* const s =
+        dynamic_cast<const world_snapshot*>(&*m);
+
+      if ( s == NULL )
+        m_future[c].push_message( m );
+      else if ( m_remote_snapshot[c].update( *s ) )
+        m_updated_snapshots.insert( c );
+      else
+        claw::logger << claw::log_warning << "Ignoring world snapshot "
+                     << s->get_id() << ": the base snapshot "
+                     << s->get_base_id() << " was not received." << std::endl;
+
       m = c->get_client().pull_message();
     }
 } // game_network::pull_client_messages()
@@ -274,9 +631,7 @@ bool bear::engine::game_network::prepare_clients()
           if ( m_future[c].get_horizon() >= m_min_horizon )
             m_filling.erase(c);
 
-          const sync& s = m_future[c].get_sync_message(0);
-      
-          if ( s.is_active_sync() && (s.get_id() == m_sync_id) )
+          if ( is_ready(c) )
             ++ready;
         }
     }
@@ -305,6 +660,174 @@ bool bear::engine::game_network::set_client_messages()
   return ready;
 } // game_network::set_client_messages()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the messages of the client connections for the current date,
+ *        predicting the missing ones.
+ * \return true if the current iteration can be played.
+ */
+bool bear::engine::game_network::predict_client_messages()
+{
+  confirm_predictions();
+
+  if ( m_history.empty() )
+    m_prediction_suspended = false;
+
+  bool ready(true);
+
+  for ( client_list::iterator it=m_client.begin(); it!=m_client.end(); ++it )
+    {
+      (*it)->clear_message_queue();
+      ready = ready && is_ready(*it);
+    }
+
+  if ( ready && m_history.empty() )
+    {
+      for ( client_list::iterator it=m_client.begin(); it!=m_client.end();
+            ++it )
+        (*it)->set_messages( m_future[*it].next() );
+
+      return true;
+    }
+
+  if ( !ready
+       && (m_prediction_suspended || (m_history.size() >= m_max_rollback)) )
+    return false;
+
+  iteration current;
+  current.id = m_sync_id;
+
+  for ( client_list::iterator it=m_client.begin(); it!=m_client.end(); ++it )
+    {
+      client_messages& m( current.clients[*it] );
+      m.predicted = !is_ready(*it);
+
+      if ( m.predicted )
+        m.messages.push_back
+          ( net::message_handle( new sync(m_sync_id, true) ) );
+      else
+        m.messages = m_future[*it].next();
+    }
+
+  set_iteration_messages( current );
+  m_history.push_back( current );
+
+  // All the predictions were right, there is nothing to replay.
+  if ( !m_misprediction )
+    {
+      bool confirmed(true);
+
+      for ( iteration_history::const_iterator h=m_history.begin();
+            confirmed && (h!=m_history.end()); ++h )
+        confirmed = is_confirmed( *h );
+
+      if ( confirmed )
+        m_history.clear();
+    }
+
+  return true;
+} // game_network::predict_client_messages()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Replace the predicted messages of the past iterations with the
+ *        actual messages received since.
+ */
+void bear::engine::game_network::confirm_predictions()
+{
+  for ( iteration_history::iterator it=m_history.begin(); it!=m_history.end();
+        ++it )
+    for ( std::map<client_connection*, client_messages>::iterator c =
+            it->clients.begin();
+          c != it->clients.end(); ++c )
+      if ( c->second.predicted )
+        {
+          client_future& f( m_future[c->first] );
+
+          if ( (f.get_horizon() != 0)
+               && f.get_sync_message(0).is_active_sync()
+               && (f.get_sync_message(0).get_id() == it->id) )
+            {
+              c->second.messages = f.next();
+              c->second.predicted = false;
+
+              // The prediction is a list with the sync message only.
+              if ( c->second.messages.size() != 1 )
+                m_misprediction = true;
+            }
+        }
+} // game_network::confirm_predictions()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the messages of the client connections for a given iteration.
+ * \param it The iteration.
+ */
+void bear::engine::game_network::set_iteration_messages
+( const iteration& it ) const
+{
+  for ( client_list::const_iterator c=m_client.begin(); c!=m_client.end();
+        ++c )
+    {
+      const std::map<client_connection*, client_messages>::const_iterator m
+        ( it.clients.find(*c) );
+
+      if ( m == it.clients.end() )
+        (*c)->clear_message_queue();
+      else
+        (*c)->set_messages( m->second.messages );
+    }
+} // game_network::set_iteration_messages()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the messages of a client for the current iteration have been
+ *        received.
+ * \param c The client.
+ */
+bool bear::engine::game_network::is_ready( client_connection* c )
+{
+  const client_future& f( m_future[c] );
+
+  if ( f.get_horizon() == 0 )
+    return false;
+
+  const sync& s = f.get_sync_message(0);
+
+  return s.is_active_sync() && (s.get_id() == m_sync_id);
+} // game_network::is_ready()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if all the messages of an iteration are the actual messages.
+ * \param it The iteration.
+ */
+bool bear::engine::game_network::is_confirmed( const iteration& it )
+{
+  for ( std::map<client_connection*, client_messages>::const_iterator c =
+          it.clients.begin();
+        c != it.clients.end(); ++c )
+    if ( c->second.predicted )
+      return false;
+
+  return true;
+} // game_network::is_confirmed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Dispatch an active sync message on all servers.
+ * \param id The identifier of the sync message.
+ */
+void
+bear::engine::game_network::dispatch_synchronization( std::size_t id ) const
+{
+  const sync s( id, true );
+
+  for ( server_map::const_iterator it=m_server.begin(); it!=m_server.end();
+        ++it )
+    it->second->dispatch_message( s );
+} // game_network::dispatch_synchronization()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Send some messages to initialize a new client.
@@ -314,6 +837,14 @@ bool bear::engine::game_network::set_client_messages()
 void bear::engine::game_network::on_new_client
 ( net::server* s, std::size_t client_id )
 {
-  for ( std::size_t i=0; i!=m_min_horizon; ++i )
+  for ( std::size_t i=0; i!=m_input_delay; ++i )
     s->send_message( client_id, sync( m_sync_id + i, true ) );
+
+  // The next snapshots are deltas against the last one.
+  if ( m_snapshot.get_id() != 0 )
+    {
+      world_snapshot keyframe;
+      m_snapshot.make_keyframe( keyframe );
+      s->send_message( client_id, keyframe );
+    }
 } // game_network::on_new_client()
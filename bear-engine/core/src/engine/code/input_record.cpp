@@ -0,0 +1,262 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::input_record class.
+ * \author Julien Jorge
+ */
+#include "engine/input_record.hpp"
+
+#include "input/system.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+#include <iostream>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::engine::input_record::s_checksum_period(60);
+const std::string bear::engine::input_record::s_file_header("bear-input-1");
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::input_record::input_record()
+  : m_time_step(0), m_seed(0), m_tick(0), m_checked_ticks(0),
+    m_mismatch_count(0), m_start_date(0)
+{
+
+} // input_record::input_record()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::engine::input_record::~input_record()
+{
+  stop();
+} // input_record::~input_record()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to record the inputs in a file.
+ * \param path The path to the file.
+ * \param time_step The duration of the ticks.
+ * \param seed The seed of the random number generator for the session.
+ * \return false if the file cannot be created.
+ */
+bool bear::engine::input_record::start_recording
+( const std::string& path, systime::milliseconds_type time_step,
+  unsigned int seed )
+{
+  stop();
+
+  m_output.open( path.c_str() );
+
+  if ( !m_output )
+    {
+      claw::logger << claw::log_error << "Can't create the input record '"
+                   << path << "'." << std::endl;
+      m_output.close();
+      return false;
+    }
+
+  m_time_step = time_step;
+  m_seed = seed;
+  m_tick = 0;
+
+  m_output << s_file_header << ' ' << m_time_step << ' ' << m_seed << '\n';
+
+  return true;
+} // input_record::start_recording()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to replay the inputs recorded in a file.
+ * \param path The path to the file.
+ * \return false if the file cannot be read or is not an input record.
+ */
+bool bear::engine::input_record::start_replay( const std::string& path )
+{
+  stop();
+
+  m_input.open( path.c_str() );
+
+  std::string header;
+  m_input >> header >> m_time_step >> m_seed;
+
+  if ( !m_input || (header != s_file_header) )
+    {
+      claw::logger << claw::log_error << "Can't read the input record '"
+                   << path << "'." << std::endl;
+      m_input.close();
+      return false;
+    }
+
+  m_tick = 0;
+  m_checked_ticks = 0;
+  m_mismatch_count = 0;
+
+  return true;
+} // input_record::start_replay()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the file of the recording or of the replay. The statistics of
+ *        the replay are printed on the standard output.
+ */
+void bear::engine::input_record::stop()
+{
+  if ( m_output.is_open() )
+    m_output.close();
+
+  if ( m_input.is_open() )
+    {
+      print_replay_report();
+      m_input.close();
+    }
+} // input_record::stop()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the inputs are being recorded.
+ */
+bool bear::engine::input_record::is_recording() const
+{
+  return m_output.is_open();
+} // input_record::is_recording()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the inputs are being replayed.
+ */
+bool bear::engine::input_record::is_replaying() const
+{
+  return m_input.is_open();
+} // input_record::is_replaying()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the duration of the ticks of the recording.
+ */
+bear::systime::milliseconds_type
+bear::engine::input_record::get_time_step() const
+{
+  return m_time_step;
+} // input_record::get_time_step()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the seed of the random number generator during the recording.
+ */
+unsigned int bear::engine::input_record::get_seed() const
+{
+  return m_seed;
+} // input_record::get_seed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the current state of the controllers as the inputs of the next
+ *        tick.
+ * \param lvl The level about to progress with these inputs.
+ */
+void bear::engine::input_record::record( const level& lvl )
+{
+  CLAW_PRECOND( is_recording() );
+
+  if ( m_tick % s_checksum_period == 0 )
+    m_output << "1 " << get_checksum( lvl ) << ' ';
+  else
+    m_output << "0 ";
+
+  input::system::get_instance().write_state( m_output );
+  ++m_tick;
+} // input_record::record()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the state of the controllers with the inputs of the next tick of
+ *        the recording.
+ * \param lvl The level about to progress with these inputs.
+ * \return false if the end of the recording has been reached.
+ */
+bool bear::engine::input_record::replay( const level& lvl )
+{
+  CLAW_PRECOND( is_replaying() );
+
+  if ( m_tick == 0 )
+    m_start_date = systime::get_date_ms();
+
+  unsigned int has_checksum;
+
+  if ( !(m_input >> has_checksum) )
+    return false;
+
+  if ( has_checksum != 0 )
+    {
+      std::size_t checksum(0);
+      m_input >> checksum;
+      ++m_checked_ticks;
+
+      if ( checksum != get_checksum( lvl ) )
+        {
+          if ( m_mismatch_count == 0 )
+            claw::logger << claw::log_warning << "The replay diverges from the"
+                         << " recording at tick " << m_tick << '.'
+                         << std::endl;
+
+          ++m_mismatch_count;
+        }
+    }
+
+  if ( !input::system::get_instance().read_state( m_input ) )
+    {
+      claw::logger << claw::log_error << "The input record is corrupted at"
+                   << " tick " << m_tick << '.' << std::endl;
+      return false;
+    }
+
+  ++m_tick;
+
+  return true;
+} // input_record::replay()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the checksum of the state of the items of a level.
+ * \param lvl The level.
+ */
+std::size_t bear::engine::input_record::get_checksum( const level& lvl )
+{
+  m_state.capture( 0, lvl );
+  return m_state.get_checksum();
+} // input_record::get_checksum()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Print the number of ticks replayed per second and the result of the
+ *        verification of the checksums.
+ */
+void bear::engine::input_record::print_replay_report() const
+{
+  const systime::milliseconds_type duration
+    ( m_tick == 0 ? 0 : systime::get_date_ms() - m_start_date );
+
+  std::cout << "Replayed ticks: " << m_tick << '\n'
+            << "Duration: " << duration << " ms\n";
+
+  if ( duration != 0 )
+    std::cout << "Ticks per second: " << m_tick * 1000.0 / duration << '\n'
+              << "Speed: " << (double)(m_tick * m_time_step) / duration
+              << "x real time\n";
+
+  std::cout << "Verified checksums: " << m_checked_ticks << ", mismatches: "
+            << m_mismatch_count << std::endl;
+} // input_record::print_replay_report()
@@ -18,11 +18,13 @@
 
 #include "engine/game.hpp"
 #include "engine/level_globals.hpp"
+#include "engine/level_state.hpp"
+#include "engine/world.hpp"
 #include "engine/layer/gui_layer.hpp"
 #include "engine/variable/base_variable.hpp"
 #include "universe/const_item_handle.hpp"
 
-#include "debug/scoped_time_measure.hpp"
+#include "debug/profiler_zone.hpp"
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -107,7 +109,7 @@ void bear::engine::level::stop()
  */
 void bear::engine::level::progress( universe::time_type elapsed_time )
 {
-  BEAR_CREATE_SCOPED_TIMELOG( std::string("progress level") );
+  BEAR_PROFILE_ZONE( "level::progress" );
 
   if ( !is_paused() )
     {
@@ -153,7 +155,7 @@ bear::engine::level::on_progress_done( boost::function<void ()> f )
  */
 void bear::engine::level::render( visual::screen& screen ) const
 {
-  BEAR_CREATE_SCOPED_TIMELOG( std::string("render level") );
+  BEAR_PROFILE_ZONE( "level::render" );
 
   render_layers(screen);
   render_gui(screen);
@@ -601,6 +603,86 @@ bear::engine::level::level_variable_exists( const base_variable& val ) const
   return val.exists(m_level_variables);
 } // level::level_variable_exists()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Save the state of the level, such that it can be restored later.
+ * \param s (out) The state of the level.
+ */
+void bear::engine::level::save_state( level_state& s ) const
+{
+  s.m_level_variables = m_level_variables;
+  s.m_layers.resize( m_layers.size() );
+
+  for ( std::size_t i=0; i!=m_layers.size(); ++i )
+    if ( !m_layers[i]->has_world() )
+      s.m_layers[i].clear();
+    else
+      {
+        const world& w( m_layers[i]->get_world() );
+        level_state::layer_state& items( s.m_layers[i] );
+
+        // The states are stored in the order of the identifiers of the items,
+        // as given by the world. The items already dying are not saved since
+        // they can't be restored.
+        items.clear();
+
+        for ( world::const_item_iterator it=w.living_items_begin();
+              it!=w.living_items_end(); ++it )
+          if ( !it->is_dead() )
+            {
+              items.push_back( level_state::item_state() );
+
+              level_state::item_state& state( items.back() );
+              state.item = &*it;
+              state.id = it->get_id();
+              state.physical_state = *it;
+              it->save_state( state.variables );
+            }
+      }
+} // level::save_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restore a state of the level saved with save_state().
+ * \param s The state of the level.
+ * \return false if some items of the saved state have been killed since the
+ *         state was saved, in which case the level is left unchanged.
+ *
+ * The items created since the state was saved are killed.
+ */
+bool bear::engine::level::restore_state( const level_state& s )
+{
+  if ( !s.is_complete() )
+    return false;
+
+  m_level_variables = s.m_level_variables;
+
+  for ( std::size_t i=0; (i!=m_layers.size()) && (i!=s.m_layers.size()); ++i )
+    if ( m_layers[i]->has_world() )
+      {
+        const world& w( m_layers[i]->get_world() );
+        std::vector<base_item*> created;
+
+        for ( world::const_item_iterator it=w.living_items_begin();
+              it!=w.living_items_end(); ++it )
+          if ( !it->is_dead() && !s.has_item( i, it->get_id() ) )
+            created.push_back( &*it );
+
+        for ( std::size_t j=0; j!=created.size(); ++j )
+          created[j]->kill();
+
+        const level_state::layer_state& items( s.m_layers[i] );
+
+        for ( std::size_t j=0; j!=items.size(); ++j )
+          {
+            items[j].item->set_physical_state( items[j].physical_state );
+            items[j].item->restore_state( items[j].variables );
+          }
+      }
+
+  return true;
+} // level::restore_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Draw the visible part of the level layers on the screen.
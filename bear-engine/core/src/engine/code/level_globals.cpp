@@ -15,11 +15,14 @@
 
 #include "engine/bitmap_font_loader.hpp"
 #include "engine/model_loader.hpp"
+#include "engine/resource_cache.hpp"
 #include "engine/resource_pool.hpp"
 #include "engine/shader_loader.hpp"
 #include "engine/sprite_loader.hpp"
 #include "engine/spritepos.hpp"
 
+#include "debug/profiler_zone.hpp"
+
 #include <sstream>
 #include <cassert>
 #include <claw/logger.hpp>
@@ -59,6 +62,18 @@ bear::engine::level_globals::level_globals
   constructor_default();
 } // level_globals::level_globals()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::engine::level_globals::~level_globals()
+{
+  resource_cache& cache( resource_cache::get_instance() );
+
+  for ( std::size_t i(0); i!=m_cached_images.size(); ++i )
+    cache.release_image( m_cached_images[i] );
+} // level_globals::~level_globals()
+
 void bear::engine::level_globals::add_image
 ( const std::string& file_name, const bear::visual::image& image )
 {
@@ -75,10 +90,20 @@ void bear::engine::level_globals::add_image
  */
 void bear::engine::level_globals::load_image( const std::string& file_name )
 {
+  BEAR_PROFILE_ZONE( "level_globals::load_image" );
+
   if ( image_exists(file_name) )
     return;
 
-  if ( (m_temporary_resources != NULL)
+  resource_cache& cache( resource_cache::get_instance() );
+  visual::image img;
+
+  if ( cache.acquire_image( file_name, img ) )
+    {
+      m_image_manager.add_image( file_name, img );
+      m_cached_images.push_back( file_name );
+    }
+  else if ( (m_temporary_resources != NULL)
        && m_temporary_resources->image_exists( file_name ) )
     m_image_manager.add_image
       ( file_name, m_temporary_resources->get_existing_image( file_name ) );
@@ -91,7 +116,12 @@ void bear::engine::level_globals::load_image( const std::string& file_name )
       resource_pool::get_instance().get_file(file_name, f);
 
       if (f)
-        m_image_manager.load_image(file_name, f);
+        {
+          m_image_manager.load_image(file_name, f);
+          cache.store_image
+            ( file_name, m_image_manager.get_image( file_name ) );
+          m_cached_images.push_back( file_name );
+        }
       else
         claw::logger << claw::log_error << "can not open file '" << file_name
                      << "'." << std::endl;
@@ -105,6 +135,8 @@ void bear::engine::level_globals::load_image( const std::string& file_name )
  */
 void bear::engine::level_globals::load_sound( const std::string& file_name )
 {
+  BEAR_PROFILE_ZONE( "level_globals::load_sound" );
+
   if ( m_sound_manager.sound_exists(file_name) )
     return;
 
@@ -142,6 +174,8 @@ void bear::engine::level_globals::load_sound( const std::string& file_name )
  */
 void bear::engine::level_globals::load_model( const std::string& file_name )
 {
+  BEAR_PROFILE_ZONE( "level_globals::load_model" );
+
   if ( !model_exists(file_name) )
     {
       claw::logger << claw::log_verbose << "loading model '" << file_name
@@ -153,9 +187,7 @@ void bear::engine::level_globals::load_model( const std::string& file_name )
       if (f)
         {
           model_loader ldr( f, *this );
-          model_actor* m = ldr.run();
-          m_model[file_name] = *m;
-          delete m;
+          m_model[file_name] = model_pointer( ldr.run() );
         }
       else
         claw::logger << claw::log_error << "can not open file '" << file_name
@@ -309,7 +341,7 @@ bear::engine::level_globals::get_existing_model( const std::string& name ) const
   CLAW_PRECOND( model_exists( name ) );
 
   if ( m_model.find( name ) != m_model.end() )
-    return m_model.find( name )->second;
+    return *m_model.find( name )->second;
   else
     return m_shared_resources->get_existing_model( name );
 } // level_globals::get_existing_model()
@@ -430,70 +462,106 @@ bear::engine::level_globals::get_existing_shader
 std::string bear::engine::level_globals::get_spritepos_path
 ( const std::string& image_name ) const
 {
-  std::size_t pos( image_name.find_last_of('.') );
+  const std::string candidate( get_spritepos_name( image_name ) );
 
-  if ( pos != std::string::npos )
-    {
-      const std::string candidate( image_name.substr(0, pos) + ".spritepos" );
-
-      if ( resource_pool::get_instance().exists( candidate ) )
-        return candidate;
-    }
+  if ( !candidate.empty()
+       && resource_pool::get_instance().exists( candidate ) )
+    return candidate;
 
   return std::string();
 } // level_globals::get_spritepos_path()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the entries of the spritepos file associated with a given image.
+ * \param image_name The name of the image.
+ * \remark The spritepos file is read only once for each image. An empty
+ *         spritepos is returned if the image has no such file.
+ */
+const bear::engine::spritepos&
+bear::engine::level_globals::get_spritepos( const std::string& image_name )
+{
+  const spritepos_cache::const_iterator it
+    ( m_spritepos_cache.find( image_name ) );
+
+  if ( it != m_spritepos_cache.end() )
+    return it->second;
+
+  const std::string spritepos_file( get_spritepos_name(image_name) );
+  spritepos& result( m_spritepos_cache[ image_name ] );
+
+  if ( spritepos_file.empty() )
+    return result;
+
+  std::stringstream f;
+
+  // The file is opened without checking its existence first, such that it is
+  // searched only once in the resource pool.
+  try
+    {
+      resource_pool::get_instance().get_file( spritepos_file, f );
+    }
+  catch( const claw::exception& )
+    {
+      return result;
+    }
+
+  if (f)
+    result = spritepos(f);
+  else
+    claw::logger << claw::log_error << "can not open spritepos file for '"
+                 << image_name << "'." << std::endl;
+
+  return result;
+} // level_globals::get_spritepos()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Create a sprite by reading its position and its size in the spritepos
  *        file associated with the image.
  * \param image_name The name of the image.
  * \param sprite_name The name of the sprite in the spritepos file.
- * \remark The spritepos file in opened in each call and read until the sprite
- *         is found.
+ * \remark A missing sprite is reported only in the first call.
  */
 bear::visual::sprite bear::engine::level_globals::auto_sprite
 ( const std::string& image_name, const std::string& sprite_name )
 {
-  const spritepos_entry entry(image_name, sprite_name);
-  const auto_sprite_cache::const_iterator it
-    ( m_auto_sprite_cache.find( entry ) );
+  const spritepos& s( get_spritepos( image_name ) );
+  const spritepos::const_iterator it( s.find( sprite_name ) );
 
-  if ( it != m_auto_sprite_cache.end() )
-    return it->second;
+  if ( it != s.end() )
+    return visual::sprite( get_image(image_name), it->get_clip() );
 
-  const std::string spritepos_file( get_spritepos_path(image_name) );
-  visual::sprite result;
+  if ( m_missing_sprites.insert
+       ( spritepos_entry( image_name, sprite_name ) ).second )
+    claw::logger << claw::log_error << "can not find a valid sprite '"
+                 << sprite_name << "' in the spritepos file of '"
+                 << image_name << "'." << std::endl;
 
-  if ( !spritepos_file.empty() )
-    {
-      std::stringstream f;
-      resource_pool::get_instance().get_file( spritepos_file, f );
+  return visual::sprite();
+} // level_globals::auto_sprite()
 
-      if (f)
-        {
-          const spritepos s(f);
-          const spritepos::const_iterator it( s.find( sprite_name ) );
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create all the sprites described in the spritepos file associated
+ *        with an image.
+ * \param image_name The name of the image.
+ * \param sprites (out) The sprites, indexed by their names in the spritepos
+ *        file. The existing entries with the same names are replaced.
+ */
+void bear::engine::level_globals::auto_sprites
+( const std::string& image_name, sprite_map& sprites )
+{
+  const spritepos& s( get_spritepos( image_name ) );
 
-          if ( it != s.end() )
-            {
-              const visual::image& img( get_image(image_name) );
-              result = visual::sprite( img, it->get_clip() );
-            }
-          else
-            claw::logger << claw::log_error << "can not find a valid sprite '"
-                         << sprite_name << "' in the spritepos file of '"
-                         << image_name << "'." << std::endl;
-        }
-      else
-        claw::logger << claw::log_error << "can not open spritepos file for '"
-                     << image_name << "'." << std::endl;
-    }
+  if ( s.empty() )
+    return;
 
-  m_auto_sprite_cache[ entry ] = result;
-  
-  return result;
-} // level_globals::auto_sprite()
+  const visual::image img( get_image(image_name) );
+
+  for ( spritepos::const_iterator it=s.begin(); it!=s.end(); ++it )
+    sprites[ it->get_name() ] = visual::sprite( img, it->get_clip() );
+} // level_globals::auto_sprites()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -894,6 +962,32 @@ bool bear::engine::level_globals::send_message
   return m_post_office.send_message( target, msg );
 } // level_globals::send_message()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Send a message to an item via the post office.
+ * \param target The address of the item to contact, as returned by
+ *        get_address().
+ * \param msg The message to send to this item.
+ */
+bool bear::engine::level_globals::send_message
+( const communication::post_office::address& target,
+  communication::message& msg ) const
+{
+  return m_post_office.send_message( target, msg );
+} // level_globals::send_message()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the address of an item in the post office, to send it messages
+ *        without searching it by name.
+ * \param name The name of the item.
+ */
+bear::communication::post_office::address
+bear::engine::level_globals::get_address( const std::string& name ) const
+{
+  return m_post_office.get_address( name );
+} // level_globals::get_address()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set the position of the ears.
@@ -971,6 +1065,10 @@ double bear::engine::level_globals::get_distance_unit() const
  */
 void bear::engine::level_globals::restore_resources()
 {
+  // The images that are not used by any level will not be restored, thus we
+  // remove them from the cache before their textures become invalid.
+  resource_cache::get_instance().clear_unused();
+
   restore_images();
   restore_shader_programs();
 } // level_globals::restore_resources()
@@ -1086,3 +1184,22 @@ void bear::engine::level_globals::constructor_default()
   else
     m_sound_manager.set_music_volume(s_music_volume);
 } // level_globals::constructor_default()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of the spritepos file that would be associated with a
+ *        given image, without checking its existence.
+ * \param image_name The name of the image.
+ * \return The name of the file, empty if the name of the image has no
+ *         extension.
+ */
+std::string bear::engine::level_globals::get_spritepos_name
+( const std::string& image_name )
+{
+  const std::size_t pos( image_name.find_last_of('.') );
+
+  if ( pos == std::string::npos )
+    return std::string();
+  else
+    return image_name.substr(0, pos) + ".spritepos";
+} // level_globals::get_spritepos_name()
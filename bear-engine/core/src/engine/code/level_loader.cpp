@@ -29,6 +29,8 @@
 #include "engine/layer/layer_factory.hpp"
 #include "engine/loader/item_loader_map.hpp"
 
+#include "debug/profiler_zone.hpp"
+
 #include "easing.hpp"
 
 #include <claw/exception.hpp>
@@ -123,6 +125,8 @@ bear::engine::level* bear::engine::level_loader::drop_level()
  */
 void bear::engine::level_loader::complete_run()
 {
+  BEAR_PROFILE_ZONE( "level_loader::complete_run" );
+
   bool stop = false;
 
   do
@@ -0,0 +1,76 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::level_state class.
+ * \author Julien Jorge
+ */
+#include "engine/level_state.hpp"
+
+#include <algorithm>
+#include <claw/assert.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the saved state.
+ */
+void bear::engine::level_state::clear()
+{
+  m_level_variables = var_map();
+  m_layers.clear();
+} // level_state::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if all the items whose state has been saved are still alive,
+ *        thus if the state can be restored.
+ */
+bool bear::engine::level_state::is_complete() const
+{
+  bool result(true);
+
+  for ( std::size_t i=0; result && (i!=m_layers.size()); ++i )
+    for ( std::size_t j=0; result && (j!=m_layers[i].size()); ++j )
+      result = ( m_layers[i][j].item != (base_item*)NULL )
+        && !m_layers[i][j].item->is_dead();
+
+  return result;
+} // level_state::is_complete()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the state of a given item has been saved.
+ * \param layer The index of the layer of the item.
+ * \param id The identifier of the item.
+ */
+bool bear::engine::level_state::has_item
+( std::size_t layer, base_item::id_type id ) const
+{
+  CLAW_PRECOND( layer < m_layers.size() );
+
+  const layer_state::const_iterator it
+    ( std::lower_bound
+      ( m_layers[layer].begin(), m_layers[layer].end(), id,
+        &level_state::is_before ) );
+
+  return (it != m_layers[layer].end()) && (it->id == id);
+} // level_state::has_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the state of an item is before a given identifier in the
+ *        states of a layer.
+ * \param s The state of the item.
+ * \param id The identifier.
+ */
+bool bear::engine::level_state::is_before
+( const item_state& s, base_item::id_type id )
+{
+  return s.id < id;
+} // level_state::is_before()
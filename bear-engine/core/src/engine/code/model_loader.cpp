@@ -19,22 +19,63 @@
 #include "engine/model/model_snapshot.hpp"
 #include "universe/types.hpp"
 
+#include "debug/profiler_zone.hpp"
+
 #include "easing.hpp"
 
 #include <claw/assert.hpp>
 #include <claw/exception.hpp>
 
+#include <iterator>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param content The content to read.
+ */
+bear::engine::model_loader::content_buffer::content_buffer
+( const std::string& content )
+{
+  char* const begin( const_cast<char*>( content.data() ) );
+
+  setg( begin, begin, begin + content.size() );
+} // model_loader::content_buffer::content_buffer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Moves the position in the content. Only the queries of the current
+ *        position are supported.
+ * \param off The offset of the move.
+ * \param dir The reference position of the move.
+ * \param which The sequence in which the position is changed.
+ */
+bear::engine::model_loader::content_buffer::pos_type
+bear::engine::model_loader::content_buffer::seekoff
+( off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which )
+{
+  if ( (off != 0) || (dir != std::ios_base::cur)
+       || ((which & std::ios_base::in) == 0) )
+    return pos_type( off_type(-1) );
+
+  return pos_type( gptr() - eback() );
+} // model_loader::content_buffer::seekoff()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
  * \param f The file from which we load the model.
  * \param glob The level_globals in which we load the resources.
  *
- * \a f must live longer than this instance of model_loader.
+ * The content of \a f is read in memory in order to load the snapshots of the
+ * actions later.
  */
 bear::engine::model_loader::model_loader
 ( std::istream& f, level_globals& glob )
-  : m_file(f, true), m_level_globals(glob),
+  : m_content
+    ( new std::string
+      ( std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>() ) ),
+    m_buffer(*m_content), m_stream(&m_buffer), m_file(m_stream, true),
+    m_level_globals(&glob),
     m_major_version(0),
     m_minor_version(0),
     m_release_version(0)
@@ -42,12 +83,34 @@ bear::engine::model_loader::model_loader
 
 } // model_loader::model_loader()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor used to load the snapshots of an action on demand.
+ * \param content The part of the model file describing the snapshots.
+ * \param major_version The major version number of the model file.
+ * \param minor_version The minor version number of the model file.
+ * \param release_version The release version number of the model file.
+ */
+bear::engine::model_loader::model_loader
+( const content_pointer& content, unsigned int major_version,
+  unsigned int minor_version, unsigned int release_version )
+  : m_content(content), m_buffer(*m_content), m_stream(&m_buffer),
+    m_file(m_stream, true), m_level_globals(NULL),
+    m_major_version(major_version),
+    m_minor_version(minor_version),
+    m_release_version(release_version)
+{
+
+} // model_loader::model_loader()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Builds the model
  */
 bear::engine::model_actor* bear::engine::model_loader::run()
 {
+  BEAR_PROFILE_ZONE( "model_loader::run" );
+
   m_file >> m_major_version >> m_minor_version >> m_release_version;
 
   if ( !m_file )
@@ -138,7 +201,7 @@ void bear::engine::model_loader::load_action
       model_action a( n, duration, autonext, sound_name, glob );
 
       load_marks(a, anim_map);
-      load_snapshots(a);
+      skip_snapshots(a);
       m.add_action( name, a );
     }
   else
@@ -163,7 +226,9 @@ void bear::engine::model_loader::load_sound
       for ( std::size_t i=0; i!=count; ++i )
         {
           m_file >> sounds[i];
-          m_level_globals.load_sound( sounds[i] );
+
+          if ( m_level_globals != NULL )
+            m_level_globals->load_sound( sounds[i] );
         }
     }
 } // model_loader::load_sound()
@@ -213,23 +278,83 @@ void bear::engine::model_loader::load_marks
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Load the snpashots of an action.
- * \param a The action.
+ * \param marks_count The number of marks of the action.
+ * \param snapshots (out) The snapshots.
  */
-void bear::engine::model_loader::load_snapshots( model_action& a )
+void bear::engine::model_loader::load_snapshots
+( std::size_t marks_count, snapshot_list& snapshots )
 {
   std::size_t n;
   m_file >> n;
 
-  for ( ; n!=0; --n )
-    load_snapshot(a);
+  snapshots.reserve( n );
+
+  for ( ; (n!=0) && m_file; --n )
+    load_snapshot(marks_count, snapshots);
 } // model_loader::load_snapshots()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Load a snapshot of an action.
+ * \brief Moves past the snapshots of an action without parsing them and gives
+ *        their part of the file to the action. The sounds of the snapshots
+ *        are loaded.
  * \param a The action.
  */
-void bear::engine::model_loader::load_snapshot( model_action& a )
+void bear::engine::model_loader::skip_snapshots( model_action& a )
+{
+  const std::size_t begin( m_stream.tellg() );
+
+  std::size_t n;
+  m_file >> n;
+
+  for ( ; (n!=0) && m_file; --n )
+    {
+      skip_values( s_snapshot_header_size );
+
+      bool glob;
+      std::vector<std::string> sounds;
+      load_sound(sounds, glob);
+
+      skip_values( a.get_marks_count() * s_mark_placement_size );
+    }
+
+  if ( !m_file )
+    {
+      claw::logger << claw::log_error << "The snapshots are incomplete."
+                   << std::endl;
+      return;
+    }
+
+  const std::size_t end( m_stream.tellg() );
+
+  a.set_snapshot_source
+    ( model_snapshot_source
+      ( content_pointer( new std::string( *m_content, begin, end - begin ) ),
+        a.get_marks_count(), m_major_version, m_minor_version,
+        m_release_version ) );
+} // model_loader::skip_snapshots()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Moves past some values in the file.
+ * \param n The number of values to skip.
+ */
+void bear::engine::model_loader::skip_values( std::size_t n )
+{
+  std::string value;
+
+  for ( ; (n!=0) && m_file; --n )
+    m_file >> value;
+} // model_loader::skip_values()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Load a snapshot of an action.
+ * \param marks_count The number of marks of the action.
+ * \param snapshots (out) The snapshots in which the snapshot is added.
+ */
+void bear::engine::model_loader::load_snapshot
+( std::size_t marks_count, snapshot_list& snapshots )
 {
   universe::time_type date;
   std::string func;
@@ -245,7 +370,7 @@ void bear::engine::model_loader::load_snapshot( model_action& a )
       std::vector<std::string> sounds;
       load_sound(sounds, glob);
 
-      model_snapshot s(date, a.get_marks_count(), func, sounds, glob);
+      model_snapshot s(date, marks_count, func, sounds, glob);
       s.set_size(width, height);
       s.set_x_alignment
         (model_snapshot::horizontal_alignment::from_string(x_align));
@@ -255,7 +380,7 @@ void bear::engine::model_loader::load_snapshot( model_action& a )
       s.set_y_alignment_value(y_align_value);
 
       load_mark_placements(s);
-      a.add_snapshot(s);
+      snapshots.push_back(s);
     }
   else
     claw::logger << claw::log_error << "The snapshot is incomplete."
@@ -336,7 +461,7 @@ void bear::engine::model_loader::load_animations( anim_map_type& anim_map )
   for (std::size_t i=0; i!=n; ++i)
     {
       visual::animation val =
-        sprite_loader::load_any_animation(m_file, m_level_globals);
+        sprite_loader::load_any_animation(m_file, *m_level_globals);
 
       anim_map[i] = new visual::animation(val);
     }
@@ -16,6 +16,9 @@
 #include <claw/assert.hpp>
 #include <claw/logger.hpp>
 
+/*----------------------------------------------------------------------------*/
+const bear::engine::population::id_set bear::engine::population::s_no_instance;
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Destructor.
@@ -41,6 +44,7 @@ void bear::engine::population::insert( base_item* item )
     m_dropped_items.erase(item->get_id());
 
   m_items[ item->get_id() ] = item;
+  index_item( *item );
 } // population::insert()
 
 /*----------------------------------------------------------------------------*/
@@ -79,6 +83,37 @@ bool bear::engine::population::exists( base_item::id_type id ) const
   return m_items.find(id) != m_items.end();
 } // population::exists()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of items in the population whose class has a given
+ *        name.
+ * \param c The symbol of the name of the class.
+ * \remark The parent classes are not considered.
+ */
+std::size_t
+bear::engine::population::count_instances( base_item::symbol_type c ) const
+{
+  return get_instances(c).size();
+} // population::count_instances()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifiers of the items in the population whose class has a
+ *        given name.
+ * \param c The symbol of the name of the class.
+ * \remark The parent classes are not considered.
+ */
+const bear::engine::population::id_set&
+bear::engine::population::get_instances( base_item::symbol_type c ) const
+{
+  const class_map::const_iterator it( m_instances.find(c) );
+
+  if ( it == m_instances.end() )
+    return s_no_instance;
+  else
+    return it->second;
+} // population::get_instances()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Delete items on the dead-items list.
@@ -90,6 +125,7 @@ void bear::engine::population::remove_dead_items()
   for (it=m_dead_items.begin(); it!=m_dead_items.end(); ++it)
     if ( exists(*it) )
       {
+        unindex_item(*it);
         delete m_items[*it];
         m_items.erase(*it);
       }
@@ -97,7 +133,10 @@ void bear::engine::population::remove_dead_items()
   m_dead_items.clear();
 
   for ( it=m_dropped_items.begin(); it!=m_dropped_items.end(); ++it )
-    m_items.erase(*it);
+    {
+      unindex_item(*it);
+      m_items.erase(*it);
+    }
 
   m_dropped_items.clear();
 } // population::remove_dead_items()
@@ -120,6 +159,8 @@ void bear::engine::population::clear()
     }
 
   m_items.clear();
+  m_instances.clear();
+  m_item_classes.clear();
 } // population::clear()
 
 /*----------------------------------------------------------------------------*/
@@ -139,3 +180,41 @@ bear::engine::population::const_iterator bear::engine::population::end() const
 {
   return m_items.end();
 } // population::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an item in the index of the instances of its class.
+ * \param item The item to add.
+ */
+void bear::engine::population::index_item( const base_item& item )
+{
+  const base_item::symbol_type c( item.get_class_symbol() );
+
+  m_item_classes[ item.get_id() ] = c;
+  m_instances[c].insert( item.get_id() );
+} // population::index_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove an item from the index of the instances of its class.
+ * \param id The identifier of the item to remove.
+ */
+void bear::engine::population::unindex_item( base_item::id_type id )
+{
+  const item_class_map::iterator it( m_item_classes.find(id) );
+
+  if ( it != m_item_classes.end() )
+    {
+      const class_map::iterator instances( m_instances.find(it->second) );
+
+      CLAW_ASSERT( instances != m_instances.end(),
+                   "The class of the item is not indexed." );
+
+      instances->second.erase(id);
+
+      if ( instances->second.empty() )
+        m_instances.erase(instances);
+
+      m_item_classes.erase(it);
+    }
+} // population::unindex_item()
@@ -0,0 +1,127 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::render_interpolation class.
+ * \author Julien Jorge
+ */
+#include "engine/render_interpolation.hpp"
+
+#include "engine/level.hpp"
+#include "engine/world.hpp"
+
+#include <claw/assert.hpp>
+
+#include <cmath>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Save the positions of the living items of a level, before its
+ *        progress.
+ * \param lvl The level.
+ */
+void bear::engine::render_interpolation::save_positions( const level& lvl )
+{
+  CLAW_PRECOND( m_moved.empty() );
+
+  m_previous.clear();
+
+  for ( level::const_layer_iterator it=lvl.layer_begin(); it!=lvl.layer_end();
+        ++it )
+    if ( it->has_world() )
+      {
+        const world& w( it->get_world() );
+
+        for ( world::const_item_iterator item=w.living_items_begin();
+              item!=w.living_items_end(); ++item )
+          {
+            item_position& p( m_previous[ item->get_id() ] );
+            p.bottom_left = item->get_bottom_left();
+            p.system_angle = item->get_system_angle();
+          }
+      }
+} // render_interpolation::save_positions()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move the living items of a level between their saved positions and
+ *        their current positions.
+ * \param lvl The level.
+ * \param ratio The progression from the saved positions (zero) to the current
+ *        positions (one).
+ */
+void bear::engine::render_interpolation::interpolate
+( const level& lvl, double ratio )
+{
+  CLAW_PRECOND( m_moved.empty() );
+  CLAW_PRECOND( (ratio >= 0) && (ratio <= 1) );
+
+  for ( level::const_layer_iterator it=lvl.layer_begin(); it!=lvl.layer_end();
+        ++it )
+    if ( it->has_world() )
+      {
+        const world& w( it->get_world() );
+
+        for ( world::const_item_iterator item=w.living_items_begin();
+              item!=w.living_items_end(); ++item )
+          {
+            const position_map::const_iterator previous
+              ( m_previous.find( item->get_id() ) );
+
+            if ( previous == m_previous.end() )
+              continue;
+
+            moved_item m;
+            m.item = &*item;
+            m.position.bottom_left = item->get_bottom_left();
+            m.position.system_angle = item->get_system_angle();
+
+            const item_position& p( previous->second );
+            const universe::position_type& c( m.position.bottom_left );
+
+            item->set_bottom_left
+              ( universe::position_type
+                ( p.bottom_left.x + (c.x - p.bottom_left.x) * ratio,
+                  p.bottom_left.y + (c.y - p.bottom_left.y) * ratio ) );
+
+            // The angles are not interpolated across the wrapping around.
+            if ( std::abs( m.position.system_angle - p.system_angle ) < 3.14 )
+              item->set_system_angle
+                ( p.system_angle
+                  + (m.position.system_angle - p.system_angle) * ratio );
+
+            m_moved.push_back( m );
+          }
+      }
+} // render_interpolation::interpolate()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move the items moved by interpolate() back to their current
+ *        positions.
+ */
+void bear::engine::render_interpolation::restore()
+{
+  for ( std::size_t i=0; i!=m_moved.size(); ++i )
+    {
+      m_moved[i].item->set_bottom_left( m_moved[i].position.bottom_left );
+      m_moved[i].item->set_system_angle( m_moved[i].position.system_angle );
+    }
+
+  m_moved.clear();
+} // render_interpolation::restore()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Forget the saved positions.
+ */
+void bear::engine::render_interpolation::clear()
+{
+  m_previous.clear();
+} // render_interpolation::clear()
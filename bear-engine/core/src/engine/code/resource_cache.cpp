@@ -0,0 +1,246 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::resource_cache class.
+ * \author Julien Jorge
+ */
+#include "engine/resource_cache.hpp"
+
+#include "debug/performance_counters.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t
+bear::engine::resource_cache::default_memory_budget( 128 * 1024 * 1024 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the instance.
+ */
+bear::engine::resource_cache& bear::engine::resource_cache::get_instance()
+{
+  return super::get_instance();
+} // resource_cache::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::resource_cache::resource_cache()
+  : m_memory_budget( default_memory_budget ), m_memory_usage(0),
+    m_hit_count(0), m_miss_count(0)
+{
+
+} // resource_cache::resource_cache()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets an image from the cache and increments its reference count.
+ * \param name The name of the image.
+ * \param img (out) The image, if found.
+ * \return true if the image was in the cache.
+ */
+bool bear::engine::resource_cache::acquire_image
+( const std::string& name, visual::image& img )
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  const image_map::iterator it( m_images.find( name ) );
+
+  if ( it == m_images.end() )
+    {
+      ++m_miss_count;
+      BEAR_COUNTER_ADD( "resource_cache/misses", 1 );
+      return false;
+    }
+
+  ++m_hit_count;
+  BEAR_COUNTER_ADD( "resource_cache/hits", 1 );
+
+  if ( it->second.references == 0 )
+    m_unused.erase( it->second.lru_position );
+
+  ++it->second.references;
+  img = it->second.image;
+
+  return true;
+} // resource_cache::acquire_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Adds an image in the cache, referenced once by the caller.
+ * \param name The name of the image.
+ * \param img The image.
+ */
+void bear::engine::resource_cache::store_image
+( const std::string& name, const visual::image& img )
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  const image_map::iterator it( m_images.find( name ) );
+
+  if ( it != m_images.end() )
+    {
+      if ( it->second.references == 0 )
+        m_unused.erase( it->second.lru_position );
+
+      ++it->second.references;
+    }
+  else
+    {
+      image_entry& entry( m_images[ name ] );
+      entry.image = img;
+      entry.references = 1;
+      entry.memory = 4 * img.width() * img.height();
+
+      m_memory_usage += entry.memory;
+      evict_unused( m_memory_budget );
+    }
+} // resource_cache::store_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decrements the reference count of an image. The image is kept in the
+ *        cache until the memory budget is exceeded.
+ * \param name The name of the image.
+ */
+void bear::engine::resource_cache::release_image( const std::string& name )
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  const image_map::iterator it( m_images.find( name ) );
+
+  if ( it == m_images.end() )
+    return;
+
+  CLAW_PRECOND( it->second.references > 0 );
+
+  --it->second.references;
+
+  if ( it->second.references == 0 )
+    {
+      it->second.lru_position = m_unused.insert( m_unused.end(), name );
+      evict_unused( m_memory_budget );
+    }
+} // resource_cache::release_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes all the entries that are not referenced.
+ */
+void bear::engine::resource_cache::clear_unused()
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  evict_unused( 0 );
+} // resource_cache::clear_unused()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes all the entries, even the referenced ones, and writes the
+ *        statistics of the cache in the log.
+ */
+void bear::engine::resource_cache::clear()
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  claw::logger << claw::log_verbose << "Resource cache: " << m_hit_count
+               << " hits, " << m_miss_count << " misses, " << m_images.size()
+               << " images using " << m_memory_usage << " bytes."
+               << std::endl;
+
+  m_images.clear();
+  m_unused.clear();
+  m_memory_usage = 0;
+} // resource_cache::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Sets the maximum memory used by the cached entries.
+ * \param bytes The budget, in bytes.
+ * \remark The referenced entries are never evicted, thus the memory usage may
+ *         exceed the budget.
+ */
+void bear::engine::resource_cache::set_memory_budget( std::size_t bytes )
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  m_memory_budget = bytes;
+  evict_unused( m_memory_budget );
+} // resource_cache::set_memory_budget()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the maximum memory used by the cached entries, in bytes.
+ */
+std::size_t bear::engine::resource_cache::get_memory_budget() const
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  return m_memory_budget;
+} // resource_cache::get_memory_budget()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the estimated memory used by the cached entries, in bytes.
+ */
+std::size_t bear::engine::resource_cache::get_memory_usage() const
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  return m_memory_usage;
+} // resource_cache::get_memory_usage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets how many resources have been found in the cache.
+ */
+std::size_t bear::engine::resource_cache::get_hit_count() const
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  return m_hit_count;
+} // resource_cache::get_hit_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets how many resources have not been found in the cache.
+ */
+std::size_t bear::engine::resource_cache::get_miss_count() const
+{
+  boost::mutex::scoped_lock lock( m_mutex );
+
+  return m_miss_count;
+} // resource_cache::get_miss_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Removes the least recently used unreferenced entries until the memory
+ *        usage fits in a given budget.
+ * \param budget The memory budget to reach, in bytes.
+ */
+void bear::engine::resource_cache::evict_unused( std::size_t budget )
+{
+  while ( (m_memory_usage > budget) && !m_unused.empty() )
+    {
+      const image_map::iterator it( m_images.find( m_unused.front() ) );
+      CLAW_ASSERT( it != m_images.end(), "Unused entry is not in the cache." );
+      CLAW_ASSERT( it->second.references == 0, "Evicting a used entry." );
+
+      claw::logger << claw::log_verbose << "evicting image '" << it->first
+                   << "' from the resource cache." << std::endl;
+
+      m_memory_usage -= it->second.memory;
+      m_images.erase( it );
+      m_unused.pop_front();
+    }
+} // resource_cache::evict_unused()
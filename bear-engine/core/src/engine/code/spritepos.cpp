@@ -50,6 +50,15 @@ bear::engine::spritepos::sprite_entry::get_clip() const
 
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build a spritepos without entries.
+ */
+bear::engine::spritepos::spritepos()
+{
+
+} // spritepos::spritepos()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Build a spritepos by reading the entries from a stream.
@@ -86,12 +95,31 @@ bear::engine::spritepos::const_iterator bear::engine::spritepos::end() const
 bear::engine::spritepos::const_iterator
 bear::engine::spritepos::find( const std::string& name ) const
 {
-  for ( const_iterator it=m_entries.begin(); it!=m_entries.end(); ++it )
-    if ( it->get_name() == name )
-      return it;
+  const entry_index::const_iterator it( m_index.find( name ) );
 
-  return end();
-} // spritepos::end()
+  if ( it == m_index.end() )
+    return end();
+  else
+    return m_entries.begin() + it->second;
+} // spritepos::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if there is no entry in the spritepos.
+ */
+bool bear::engine::spritepos::empty() const
+{
+  return m_entries.empty();
+} // spritepos::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of entries in the spritepos.
+ */
+std::size_t bear::engine::spritepos::size() const
+{
+  return m_entries.size();
+} // spritepos::size()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -122,6 +150,10 @@ void bear::engine::spritepos::load( std::istream& f )
           sprite_entry::rectangle_type r;
 
           if ( iss >> r.position.x >> r.position.y >> r.width >> r.height )
-            m_entries.push_back( sprite_entry( n, r ) );
+            {
+              // Only the first entry with a given name can be found.
+              m_index.insert( entry_index::value_type(n, m_entries.size()) );
+              m_entries.push_back( sprite_entry( n, r ) );
+            }
         }
 } // spritepos::load()
@@ -111,6 +111,18 @@ bear::engine::world::living_items_end() const
   return m_population.end();
 } // world::living_items_end()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of living items whose class has a given name.
+ * \param c The symbol of the name of the class, as returned by
+ *        base_item::get_class_symbol().
+ */
+std::size_t
+bear::engine::world::count_living_items( base_item::symbol_type c ) const
+{
+  return m_population.count_instances(c);
+} // world::count_living_items()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Add a permanent and fixed item in the world.
@@ -17,6 +17,7 @@
 
 #include "expr/base_boolean_expression.hpp"
 #include "engine/expr/collision_in_expression.hpp"
+#include "text_interface/symbol_table.hpp"
 
 #include "engine/class_export.hpp"
 
@@ -36,6 +37,8 @@ namespace bear
       public expr::base_boolean_expression
     {
     public:
+      check_item_class();
+
       void set_class_name( const std::string& class_name );
       const std::string& get_class_name() const;
 
@@ -51,6 +54,9 @@ namespace bear
       /** \brief The name of the class. */
       std::string m_class_name;
 
+      /** \brief The symbol of the name of the class. */
+      text_interface::symbol_table::symbol_type m_class_symbol;
+
       /** \brief The data on the colliding item. */
       collision_in_expression m_collision;
 
@@ -15,6 +15,17 @@
 
 #include "engine/base_item.hpp"
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::check_item_class::check_item_class()
+  : m_class_symbol
+    ( text_interface::symbol_table::get_symbol(m_class_name) )
+{
+
+} // check_item_class::check_item_class()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set the name of the class.
@@ -24,6 +35,7 @@ void bear::engine::check_item_class::set_class_name
 ( const std::string& class_name )
 {
   m_class_name = class_name;
+  m_class_symbol = text_interface::symbol_table::get_symbol(class_name);
 } // check_item_class::set_class_name()
 
 /*----------------------------------------------------------------------------*/
@@ -75,7 +87,7 @@ bool bear::engine::check_item_class::evaluate() const
   if ( m_collision == NULL )
     return false;
   else
-    return m_collision->get_class_name() == m_class_name;
+    return m_collision->get_class_symbol() == m_class_symbol;
 } // check_item_class::evaluate()
 
 /*----------------------------------------------------------------------------*/
@@ -20,8 +20,9 @@
  * \brief Constructor.
  */
 bear::engine::count_items_by_class_name::count_items_by_class_name()
+  : m_class_symbol( text_interface::symbol_table::get_symbol(std::string()) )
 {
-  // nothing to do
+
 } // count_items_by_class_name::count_items_by_class_name()
 
 /*----------------------------------------------------------------------------*/
@@ -32,7 +33,8 @@ bear::engine::count_items_by_class_name::count_items_by_class_name()
  */
 bear::engine::count_items_by_class_name::count_items_by_class_name
 ( const base_item& w, const std::string& c )
-  : m_world_proxy(w), m_class_name(c)
+  : m_world_proxy(w),
+    m_class_symbol( text_interface::symbol_table::get_symbol(c) )
 {
 
 } // count_items_by_class_name::count_items_by_class_name()
@@ -57,7 +59,7 @@ void bear::engine::count_items_by_class_name::set_world_through
 void
 bear::engine::count_items_by_class_name::set_class_name( const std::string& c )
 {
-  m_class_name = c;
+  m_class_symbol = text_interface::symbol_table::get_symbol(c);
 } // count_items_by_class_name::set_class_name()
 
 /*----------------------------------------------------------------------------*/
@@ -79,20 +81,11 @@ double bear::engine::count_items_by_class_name::evaluate() const
   std::size_t result(0);
 
   if ( m_world_proxy == (base_item*)NULL )
-    {
-      claw::logger << claw::log_warning
-                   << "count_items_by_class_name: the item is NULL, the "
-        "evaluation is zero." << std::endl;
-
-      return result;
-    }
-
-  world::const_item_iterator it;
-  const world& w( m_world_proxy->get_world() );
-
-  for ( it=w.living_items_begin(); it!=w.living_items_end(); ++it )
-    if ( it->get_class_name() == m_class_name )
-      ++result;
+    claw::logger << claw::log_warning
+                 << "count_items_by_class_name: the item is NULL, the "
+      "evaluation is zero." << std::endl;
+  else
+    result = m_world_proxy->get_world().count_living_items( m_class_symbol );
 
   return result;
 } // count_items_by_class_name::evaluate()
@@ -57,8 +57,9 @@ namespace bear
       /** \brief An item in the world in which the items are searched. */
       item_handle m_world_proxy;
 
-      /** \brief The name of the class of the items to count. */
-      std::string m_class_name;
+      /** \brief The symbol of the name of the class of the items to
+          count. */
+      base_item::symbol_type m_class_symbol;
 
     }; // class count_items_by_class_name
 
@@ -0,0 +1,114 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Waits for the dates of the iterations of the game and measures the
+ *        regularity of the frames.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_FRAME_PACING_HPP__
+#define __ENGINE_FRAME_PACING_HPP__
+
+#include "engine/class_export.hpp"
+
+#include "time/time.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief Waits for the dates of the iterations of the game and measures
+     *        the regularity of the frames.
+     *
+     * The waits are done by sleeping until shortly before the expected date,
+     * then by yielding the processor until the date is reached. The duration
+     * of the second part is adjusted according to how late the process wakes
+     * up from the sleeps.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT frame_pacing
+    {
+    public:
+      frame_pacing();
+
+      void set_spin_enabled( bool e );
+
+      void wait_until( systime::microseconds_type date );
+      void add_frame( systime::microseconds_type date );
+
+      void print_statistics( std::ostream& os ) const;
+
+    private:
+      systime::microseconds_type get_interval_percentile( double p ) const;
+
+    private:
+      /** \brief Tell if the end of the waits is done by yielding the
+          processor. */
+      bool m_spin_enabled;
+
+      /** \brief The duration of the end of the waits, during which the
+          processor is yielded instead of sleeping. */
+      systime::microseconds_type m_spin_duration;
+
+      /** \brief The date of the last frame. */
+      systime::microseconds_type m_last_frame;
+
+      /** \brief The interval between the last two frames. */
+      systime::microseconds_type m_last_interval;
+
+      /** \brief The number of intervals measured between the frames. */
+      std::size_t m_interval_count;
+
+      /** \brief The sum of the intervals between the frames. */
+      double m_interval_sum;
+
+      /** \brief The sum of the squares of the intervals between the
+          frames. */
+      double m_interval_square_sum;
+
+      /** \brief The sum of the differences between two successive
+          intervals. */
+      double m_jitter_sum;
+
+      /** \brief The longest interval between two frames. */
+      systime::microseconds_type m_max_interval;
+
+      /** \brief The number of intervals in each range of
+          s_histogram_step microseconds. */
+      std::vector<std::size_t> m_interval_histogram;
+
+      /** \brief The number of waits. */
+      std::size_t m_wait_count;
+
+      /** \brief The sum of the delays between the end of the waits and the
+          expected dates. */
+      double m_wait_delay_sum;
+
+      /** \brief The longest delay between the end of a wait and the expected
+          date. */
+      systime::microseconds_type m_max_wait_delay;
+
+      /** \brief The width of the ranges of the histogram of the
+          intervals. */
+      static const systime::microseconds_type s_histogram_step;
+
+      /** \brief The longest duration of the end of the waits during which the
+          processor is yielded. */
+      static const systime::microseconds_type s_max_spin_duration;
+
+    }; // class frame_pacing
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_FRAME_PACING_HPP__
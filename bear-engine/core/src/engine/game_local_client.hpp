@@ -18,11 +18,14 @@
 #include <queue>
 
 #include "engine/class_export.hpp"
+#include "engine/frame_pacing.hpp"
 #include "engine/game_description.hpp"
 #include "engine/game_network.hpp"
 #include "engine/game_stats.hpp"
 #include "engine/i18n/translator.hpp"
+#include "engine/input_record.hpp"
 #include "engine/libraries_pool.hpp"
+#include "engine/render_interpolation.hpp"
 #include "engine/stat_variable.hpp"
 #include "engine/system/base_system_event_manager.hpp"
 #include "engine/system/game_filesystem.hpp"
@@ -48,6 +51,7 @@ namespace bear
     class game_action_set_current_level;
     class game_action_set_current_level;
     class level;
+    class level_state;
 
     /**
      * \brief The class managing the levels and the development of the game.
@@ -188,23 +192,28 @@ namespace bear
 
       std::string get_formatted_game_name() const;
 
+      systime::microseconds_type get_date() const;
       void set_last_progress_date();
 
       void run_level();
       void one_step_beyond();
+      void fast_forward();
 
       bool synchronize_network();
+      bool roll_back();
+      void clear_rollback_state();
 
       bear::universe::time_type synchronous_progress( universe::time_type dt );
       bear::universe::time_type asynchronous_progress
-        ( universe::time_type dt, systime::milliseconds_type current_time,
+        ( universe::time_type dt, systime::microseconds_type current_time,
           universe::time_type time_range );
 
       void progress
-        ( systime::milliseconds_type current_time, universe::time_type dt,
+        ( systime::microseconds_type current_time, universe::time_type dt,
           universe::time_type time_range, universe::time_type time_scale );
       void progress( universe::time_type elapsed_time );
       void render();
+      double get_interpolation_ratio() const;
 
       void update_inputs();
 
@@ -286,15 +295,37 @@ namespace bear
       /** \brief The expected number of frames per seconds. */
       std::size_t m_frames_per_second;
 
-      /** \brief The date of the last render. */
-      systime::milliseconds_type m_last_render;
+      /** \brief The date of the last render, in microseconds. */
+      systime::microseconds_type m_last_render;
 
-      /** \brief The date of the last call to progress. */
-      systime::milliseconds_type m_last_progress;
+      /** \brief The date of the last call to progress, in microseconds, minus
+          the time not consumed by the progress. */
+      systime::microseconds_type m_last_progress;
 
       /** \brief Tell to do one render for each progress. */
       bool m_synchronized_render;
 
+      /** \brief Tell to render the items between their positions of the last
+          two progresses, and to render between the progresses. */
+      bool m_interpolated_render;
+
+      /** \brief Tell to measure the time in milliseconds and to wait without
+          yielding the processor, as did the previous versions of the
+          engine. */
+      bool m_millisecond_scheduler;
+
+      /** \brief Tell to print the statistics of the frame pacing at the end of
+          the game. */
+      bool m_print_frame_pacing;
+
+      /** \brief The waits between the iterations and the measures of their
+          regularity. */
+      frame_pacing m_frame_pacing;
+
+      /** \brief The positions of the items for the interpolated
+          renderings. */
+      render_interpolation m_render_interpolation;
+
       /** \brief The statistics sent at the end of the game. */
       game_stats m_stats;
 
@@ -305,6 +336,19 @@ namespace bear
           of the network. */
       bool m_level_paused_sync;
 
+      /** \brief The state of the current level before the first iteration
+          played with predicted network messages, NULL if there is no such
+          iteration. */
+      level_state* m_rollback_state;
+
+      /** \brief Tell if the state of the items of the level is set according
+          to the snapshots received from the network. */
+      bool m_network_spectator;
+
+      /** \brief The recording of the inputs of the session, or the recording
+          being replayed. */
+      input_record m_input_record;
+
       /** \brief The translator for the plugins. */
       translator m_translator;
 
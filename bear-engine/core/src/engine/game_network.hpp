@@ -16,11 +16,14 @@
 
 #include "engine/network/client_future.hpp"
 #include "engine/network/client_observer.hpp"
+#include "engine/network/world_snapshot_state.hpp"
 #include "engine/class_export.hpp"
 
 #include "net/client.hpp"
+#include "net/io_thread.hpp"
 #include "net/server.hpp"
 
+#include <deque>
 #include <map>
 #include <set>
 
@@ -29,9 +32,36 @@ namespace bear
   namespace engine
   {
     class client_connection;
+    class level;
 
     /**
      * \brief The class managing the access to the network used by the game.
+     *
+     * The games connected through the network progress in lockstep: the
+     * messages dispatched by a game during an iteration are processed by the
+     * clients a given number of iterations later, called the input delay. The
+     * input delay is adjusted between the minimum and the maximum horizons
+     * according to the round trip time measured on the connections of the
+     * servers.
+     *
+     * When a client has not received the messages of the current iteration,
+     * the game waits for them. If rollback is enabled, the game can instead
+     * continue for a few iterations, predicting that the messages did not
+     * contain anything but the sync message. When the actual messages arrive
+     * and differ from the prediction, the level must be restored to its state
+     * before the first prediction and the iterations must be replayed: see
+     * get_rollback_length(), replay() and end_rollback(). The messages
+     * dispatched by the game must then depend only on the local inputs, since
+     * the messages sent during the predicted iterations can't be retracted.
+     *
+     * The game can also send periodically the state of its level to its
+     * clients, for spectators or for games joining a running session. A new
+     * client first receives the complete state, then the changes since the
+     * previous snapshot. The complete state is also sent periodically, such
+     * that a client missing a snapshot resumes at the next complete state. The
+     * snapshots received from the servers are kept apart from the messages of
+     * the lockstep and are applied to the level on demand.
+     *
      * \author Julien Jorge
      */
     class ENGINE_EXPORT game_network
@@ -48,6 +78,34 @@ namespace bear
           client. */
       typedef std::map<client_connection*, client_future> client_future_map;
 
+      /** \brief The messages given to a client during an iteration. */
+      struct client_messages
+      {
+        /** \brief The messages. */
+        client_future::message_list messages;
+
+        /** \brief Tell if the messages are predicted, in which case they
+            are replaced by the actual messages when they arrive. */
+        bool predicted;
+
+      }; // struct client_messages
+
+      /** \brief The messages given to the clients during an iteration played
+          since the last state of the level saved for a rollback. */
+      struct iteration
+      {
+        /** \brief The identifier of the sync messages of the iteration. */
+        std::size_t id;
+
+        /** \brief The messages given to each client. */
+        std::map<client_connection*, client_messages> clients;
+
+      }; // struct iteration
+
+      /** \brief The iterations played since the last state of the level saved
+          for a rollback. */
+      typedef std::deque<iteration> iteration_history;
+
     public:
       game_network();
       ~game_network();
@@ -60,6 +118,25 @@ namespace bear
       std::size_t get_horizon() const;
       std::size_t get_min_horizon() const;
       void set_min_horizon( std::size_t m );
+      std::size_t get_max_horizon() const;
+      void set_max_horizon( std::size_t m );
+
+      std::size_t get_input_delay() const;
+      void adjust_input_delay( double iteration_duration );
+
+      std::size_t get_max_rollback() const;
+      void set_max_rollback( std::size_t n );
+
+      bool has_prediction() const;
+      void suspend_prediction();
+      std::size_t get_rollback_length() const;
+      bool replay( std::size_t i );
+      void end_rollback();
+
+      std::size_t get_snapshot_period() const;
+      void set_snapshot_period( std::size_t n );
+      void send_snapshot( const level& lvl );
+      std::size_t apply_snapshots( level& lvl );
 
       void send_message
         ( const std::string& service_name, net::message& m ) const;
@@ -80,9 +157,22 @@ namespace bear
       bool prepare_clients();
       bool set_client_messages();
 
+      bool predict_client_messages();
+      void confirm_predictions();
+      void set_iteration_messages( const iteration& it ) const;
+
+      bool is_ready( client_connection* c );
+      static bool is_confirmed( const iteration& it );
+
+      void dispatch_synchronization( std::size_t id ) const;
+
       void on_new_client( net::server* s, std::size_t client_id );
 
     private:
+      /** \brief The thread in which the sockets of the servers and the
+          clients are processed. It must be destroyed after them. */
+      net::io_thread m_io;
+
       /** \brief The services provided by the local game. */
       server_map m_server;
 
@@ -96,9 +186,65 @@ namespace bear
       std::size_t m_sync_id;
 
       /** \brief The minimum horizon to consider the synchronization
-          successful. */
+          successful. It is also the minimum input delay. */
       std::size_t m_min_horizon;
 
+      /** \brief The maximum input delay. */
+      std::size_t m_max_horizon;
+
+      /** \brief The number of iterations between the dispatch of the messages
+          and their processing by the clients. */
+      std::size_t m_input_delay;
+
+      /** \brief The input delay required by the measured round trip
+          times. */
+      std::size_t m_target_delay;
+
+      /** \brief How long the round trip times have required an input delay
+          lower than m_target_delay, in milliseconds. */
+      double m_lower_delay_duration;
+
+      /** \brief The maximum number of iterations played with predicted
+          messages. Zero disables the rollback. */
+      std::size_t m_max_rollback;
+
+      /** \brief The iterations played since the last state of the level saved
+          for a rollback, the current one included. */
+      iteration_history m_history;
+
+      /** \brief Tell if some predicted messages were not the actual ones. */
+      bool m_misprediction;
+
+      /** \brief Tell if the game must wait for the actual messages until the
+          predictions of the past iterations are confirmed. */
+      bool m_prediction_suspended;
+
+      /** \brief Tell if the iterations are being replayed. */
+      bool m_replaying;
+
+      /** \brief The number of iterations between two snapshots of the level.
+          Zero disables the snapshots. */
+      std::size_t m_snapshot_period;
+
+      /** \brief The number of iterations before the next snapshot. */
+      std::size_t m_snapshot_countdown;
+
+      /** \brief The number of snapshots before the next one containing the
+          complete state of the level. */
+      std::size_t m_keyframe_countdown;
+
+      /** \brief The state of the level in the last snapshot sent to the
+          clients of the servers. */
+      world_snapshot_state m_snapshot;
+
+      /** \brief The state of the level of the server of each client, as
+          received in the snapshots. */
+      std::map<client_connection*, world_snapshot_state> m_remote_snapshot;
+
+      /** \brief The clients whose snapshot has been updated since the last
+          call to apply_snapshots(). */
+      std::set<client_connection*> m_updated_snapshots;
+
       /** \brief The clients for which we are waiting to have enough
           messages. */
       std::set<client_connection*> m_filling;
@@ -107,6 +253,14 @@ namespace bear
           the messages for the active iteration. */
       bool m_active;
 
+      /** \brief How long the round trip times must require a lower input
+          delay before the input delay is decreased, in milliseconds. */
+      static const double s_delay_decrease_duration;
+
+      /** \brief The number of snapshots between two snapshots containing the
+          complete state of the level. */
+      static const std::size_t s_keyframe_period;
+
     }; // class game_network
   } // namespace engine
 } // namespace bear
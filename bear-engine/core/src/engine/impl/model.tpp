@@ -621,14 +621,14 @@ void bear::engine::model<Base>::progress_to_snapshot
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Execute a function associated with a snapshot.
- * \param name The name of the function.
+ * \brief Execute the function associated with a snapshot.
+ * \param s The snapshot.
  */
 template<class Base>
-void bear::engine::model<Base>::execute_function( const std::string& name )
+void bear::engine::model<Base>::execute_function( const model_snapshot& s )
 {
-  if ( !name.empty() )
-    this->execute(name);
+  if ( !s.get_function().empty() )
+    this->execute( s.get_function_symbol() );
 } // model::execute_function()
 
 /*----------------------------------------------------------------------------*/
@@ -931,7 +931,7 @@ void bear::engine::model<Base>::execute_snapshot()
 
   update_bounding_box();
   update_mark_items();
-  execute_function( m_snapshot->get_function() );
+  execute_function( *m_snapshot );
 } // model::execute_snapshot()
 
 /*----------------------------------------------------------------------------*/
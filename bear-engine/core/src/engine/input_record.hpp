@@ -0,0 +1,115 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The recording of the inputs of a game session, tick by tick.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_INPUT_RECORD_HPP__
+#define __ENGINE_INPUT_RECORD_HPP__
+
+#include "engine/network/world_snapshot_state.hpp"
+
+#include "engine/class_export.hpp"
+
+#include "time/time.hpp"
+
+#include <claw/non_copyable.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace bear
+{
+  namespace engine
+  {
+    class level;
+
+    /**
+     * \brief The recording of the inputs of a game session, tick by tick.
+     *
+     * When recording, the state of the controllers is written in a file at
+     * each progress of the level, after it has been read from the devices.
+     * When replaying, the state is read from the file instead of the devices,
+     * such that the game goes through the same iterations.
+     *
+     * A checksum of the state of the items of the level is recorded
+     * periodically. The replay compares it with the state of its own level to
+     * detect a divergence of the simulation.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT input_record:
+      private claw::pattern::non_copyable
+    {
+    public:
+      input_record();
+      ~input_record();
+
+      bool start_recording
+      ( const std::string& path, systime::milliseconds_type time_step,
+        unsigned int seed );
+      bool start_replay( const std::string& path );
+      void stop();
+
+      bool is_recording() const;
+      bool is_replaying() const;
+
+      systime::milliseconds_type get_time_step() const;
+      unsigned int get_seed() const;
+
+      void record( const level& lvl );
+      bool replay( const level& lvl );
+
+    private:
+      std::size_t get_checksum( const level& lvl );
+
+      void print_replay_report() const;
+
+    private:
+      /** \brief The file receiving the recording. */
+      std::ofstream m_output;
+
+      /** \brief The file from which the recording is replayed. */
+      std::ifstream m_input;
+
+      /** \brief The duration of the ticks of the recording. */
+      systime::milliseconds_type m_time_step;
+
+      /** \brief The seed of the random number generator during the
+          recording. */
+      unsigned int m_seed;
+
+      /** \brief The number of ticks recorded or replayed. */
+      std::size_t m_tick;
+
+      /** \brief The number of ticks whose checksum has been verified. */
+      std::size_t m_checked_ticks;
+
+      /** \brief The number of ticks whose checksum differs from the
+          recording. */
+      std::size_t m_mismatch_count;
+
+      /** \brief The date of the first replayed tick. */
+      systime::milliseconds_type m_start_date;
+
+      /** \brief The state of the items, used to compute the checksums. */
+      world_snapshot_state m_state;
+
+      /** \brief The number of ticks between two checksums. */
+      static const std::size_t s_checksum_period;
+
+      /** \brief The string at the beginning of the files. */
+      static const std::string s_file_header;
+
+    }; // class input_record
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_INPUT_RECORD_HPP__
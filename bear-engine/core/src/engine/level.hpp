@@ -36,6 +36,7 @@ namespace bear
   {
     class base_variable;
     class level_globals;
+    class level_state;
     class level_loader;
 
     /**
@@ -135,6 +136,9 @@ namespace bear
       void set_level_variable( const base_variable& val );
       bool level_variable_exists( const base_variable& val ) const;
 
+      void save_state( level_state& s ) const;
+      bool restore_state( const level_state& s );
+
     private:
       void render_layers( visual::screen& screen ) const;
       void render_layers
@@ -20,6 +20,11 @@
 #include "visual/font/font_manager.hpp"
 #include "communication/post_office.hpp"
 #include "engine/model/model_actor.hpp"
+#include "engine/spritepos.hpp"
+
+#include <set>
+#include <unordered_map>
+#include <claw/smart_ptr.hpp>
 
 #include "engine/class_export.hpp"
 
@@ -35,19 +40,28 @@ namespace bear
     class ENGINE_EXPORT level_globals
     {
     private:
+      /** \brief The type of the map storing the spritepos files associated
+          with the images. */
+      typedef std::unordered_map<std::string, spritepos> spritepos_cache;
+
       /** \brief The type of the key identifying a sprite loaded from a
           spritepos file. */
       typedef std::pair<std::string, std::string> spritepos_entry;
 
-      /** \brief The type of the map storing the sprites loaded from the
-          spritepos files. */
-      typedef std::map<spritepos_entry, visual::sprite> auto_sprite_cache;
+      /** \brief The type of the pointers to the models loaded in the level. */
+      typedef claw::memory::smart_ptr<model_actor> model_pointer;
+
+    public:
+      /** \brief The type of the map in which the sprites of a spritepos file
+          are returned, indexed by their names. */
+      typedef std::unordered_map<std::string, visual::sprite> sprite_map;
 
     public:
       level_globals();
       level_globals
         ( const level_globals* shared,
           const level_globals* temporary_resources );
+      ~level_globals();
 
       void add_image
         ( const std::string& file_name, const bear::visual::image& image );
@@ -78,8 +92,10 @@ namespace bear
         ( const std::string& name ) const;
 
       std::string get_spritepos_path( const std::string& image_name ) const;
+      const spritepos& get_spritepos( const std::string& image_name );
       visual::sprite auto_sprite
       ( const std::string& image_name, const std::string& sprite_name );
+      void auto_sprites( const std::string& image_name, sprite_map& sprites );
 
       void play_sound( const std::string& name );
       void play_sound
@@ -122,6 +138,11 @@ namespace bear
       void release_item( communication::messageable& item );
       bool send_message
       ( const std::string& target, communication::message& msg ) const;
+      bool send_message
+      ( const communication::post_office::address& target,
+        communication::message& msg ) const;
+      communication::post_office::address
+      get_address( const std::string& name ) const;
 
       void set_ears_position
         ( const claw::math::coordinate_2d<double>& position );
@@ -147,6 +168,9 @@ namespace bear
 
       void constructor_default();
 
+      static std::string
+      get_spritepos_name( const std::string& image_name );
+
     private:
       /** \brief Another level_globals from which we can take the resources
           instead of building new ones. */
@@ -168,14 +192,22 @@ namespace bear
       /** \brief The post office in the level. */
       communication::post_office m_post_office;
 
+      /** \brief The names of the images referenced in the resource_cache by
+          this instance. */
+      std::vector<std::string> m_cached_images;
+
       /** \brief The models of the items in the level. */
-      std::map<std::string, model_actor> m_model;
+      std::map<std::string, model_pointer> m_model;
 
       /** \brief The animations in the level. */
       std::map<std::string, visual::animation> m_animation;
 
-      /** \brief This map stores the sprites read from spritepos files. */
-      auto_sprite_cache m_auto_sprite_cache;
+      /** \brief This map stores the spritepos files read for the images. */
+      spritepos_cache m_spritepos_cache;
+
+      /** \brief The sprites requested to auto_sprite() but not found in the
+          spritepos files. They are reported only once. */
+      std::set<spritepos_entry> m_missing_sprites;
 
       /** \brief Tells if no more resources are supposed to be created. */
       bool m_frozen;
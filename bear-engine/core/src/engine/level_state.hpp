@@ -0,0 +1,89 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The state of a level at a given time, from which the level can be
+ *        restored.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_LEVEL_STATE_HPP__
+#define __ENGINE_LEVEL_STATE_HPP__
+
+#include "engine/base_item.hpp"
+#include "engine/variable/var_map.hpp"
+
+#include "engine/class_export.hpp"
+
+#include "universe/derived_item_handle.hpp"
+#include "universe/physical_item_state.hpp"
+
+#include <vector>
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief The state of a level at a given time, from which the level can
+     *        be restored.
+     *
+     * The state is made of the level variables and, for each living item of
+     * the layers, of its physical state and of the variables the item saves
+     * in base_item::save_state(). It is filled by level::save_state() and
+     * applied by level::restore_state(). The state can't be applied once an
+     * item it contains has been killed, since the item can't be revived.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT level_state
+    {
+      friend class level;
+
+    private:
+      /** \brief The state of an item. */
+      struct item_state
+      {
+        /** \brief The item. */
+        universe::derived_item_handle<base_item> item;
+
+        /** \brief The identifier of the item. */
+        base_item::id_type id;
+
+        /** \brief The physical state of the item. */
+        universe::physical_item_state physical_state;
+
+        /** \brief The variables saved by the item. */
+        var_map variables;
+
+      }; // struct item_state
+
+      /** \brief The states of the items of a layer, sorted by identifier. */
+      typedef std::vector<item_state> layer_state;
+
+    public:
+      void clear();
+      bool is_complete() const;
+
+    private:
+      bool has_item( std::size_t layer, base_item::id_type id ) const;
+
+      static bool is_before( const item_state& s, base_item::id_type id );
+
+    private:
+      /** \brief The level variables. */
+      var_map m_level_variables;
+
+      /** \brief The states of the items of each layer. */
+      std::vector<layer_state> m_layers;
+
+    }; // class level_state
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_LEVEL_STATE_HPP__
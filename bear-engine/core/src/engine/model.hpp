@@ -112,7 +112,7 @@ namespace bear
       ( universe::time_type initial_time, universe::time_type elapsed_time,
         const model_action::const_snapshot_iterator& eit );
 
-      void execute_function( const std::string& name );
+      void execute_function( const model_snapshot& s );
 
       scene_visual get_mark_visual
       ( const model_mark& mark, const model_mark_placement& p ) const;
@@ -64,6 +64,10 @@ bear::engine::model_action::model_action( const model_action& that )
   for ( std::size_t i=0; i!=that.m_mark.size(); ++i )
     m_mark[i] = new model_mark(that.get_mark(i));
 
+  // The snapshots of \a that may not have been loaded yet. In this case we
+  // share its source, which reads the snapshots once for all the copies.
+  m_snapshot_source = that.m_snapshot_source;
+
   snapshot_map::const_iterator it;
 
   for ( it=that.m_snapshot.begin(); it!=that.m_snapshot.end(); ++it )
@@ -106,6 +110,7 @@ void bear::engine::model_action::swap( model_action& that ) throw()
 {
   std::swap(m_mark, that.m_mark);
   std::swap(m_snapshot, that.m_snapshot);
+  std::swap(m_snapshot_source, that.m_snapshot_source);
   std::swap(m_duration, that.m_duration);
   std::swap(m_next, that.m_next);
   std::swap(m_sound_name, that.m_sound_name);
@@ -183,11 +188,25 @@ bear::universe::time_type bear::engine::model_action::get_duration() const
  */
 void bear::engine::model_action::add_snapshot( const model_snapshot& s )
 {
+  load_snapshots();
+
   CLAW_PRECOND( m_snapshot.find(s.get_date()) == m_snapshot.end() );
 
   m_snapshot[s.get_date()] = new model_snapshot(s);
 } // model_action::add_snapshot()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells where to find the snapshots of the action. They will be loaded
+ *        the first time they are needed.
+ * \param source The location of the snapshots.
+ */
+void bear::engine::model_action::set_snapshot_source
+( const model_snapshot_source& source )
+{
+  m_snapshot_source = new model_snapshot_source(source);
+} // model_action::set_snapshot_source()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the snapshot of a given date (or the one before the date).
@@ -206,6 +225,8 @@ bear::engine::model_action::get_snapshot_at( universe::time_type t ) const
 bear::engine::model_action::const_snapshot_iterator
 bear::engine::model_action::snapshot_begin() const
 {
+  load_snapshots();
+
   return m_snapshot.begin();
 } // model_action::snapshot_begin()
 
@@ -216,6 +237,8 @@ bear::engine::model_action::snapshot_begin() const
 bear::engine::model_action::const_snapshot_iterator
 bear::engine::model_action::snapshot_end() const
 {
+  load_snapshots();
+
   return m_snapshot.end();
 } // model_action::snapshot_end()
 
@@ -226,6 +249,8 @@ bear::engine::model_action::snapshot_end() const
 bear::engine::model_action::snapshot_iterator
 bear::engine::model_action::snapshot_begin()
 {
+  load_snapshots();
+
   return m_snapshot.begin();
 } // model_action::snapshot_begin()
 
@@ -236,6 +261,8 @@ bear::engine::model_action::snapshot_begin()
 bear::engine::model_action::snapshot_iterator
 bear::engine::model_action::snapshot_end()
 {
+  load_snapshots();
+
   return m_snapshot.end();
 } // model_action::snapshot_end()
 
@@ -275,6 +302,8 @@ bool bear::engine::model_action::sound_is_global() const
 void bear::engine::model_action::get_max_size
 ( double& width, double& height ) const
 {
+  load_snapshots();
+
   snapshot_map::const_iterator it(m_snapshot.begin());
   snapshot_map::const_iterator eit(m_snapshot.end());
 
@@ -380,6 +409,8 @@ bear::engine::model_action::snapshot_map::const_iterator
 bear::engine::model_action::get_snapshot_const_iterator_at
 ( universe::time_type t ) const
 {
+  load_snapshots();
+
   if ( claw::real_number<universe::time_type>(t) > get_duration() )
     return m_snapshot.end();
   else if ( m_snapshot.empty() )
@@ -398,6 +429,29 @@ bear::engine::model_action::get_snapshot_const_iterator_at
     }
 } // model_action::get_snapshot_const_iterator_at()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Loads the snapshots of the action if it has not been done yet.
+ */
+void bear::engine::model_action::load_snapshots() const
+{
+  if ( m_snapshot_source == NULL )
+    return;
+
+  const model_snapshot_source::snapshot_list& snapshots
+    ( m_snapshot_source->get_snapshots() );
+
+  for ( std::size_t i=0; i!=snapshots.size(); ++i )
+    {
+      CLAW_PRECOND
+        ( m_snapshot.find(snapshots[i].get_date()) == m_snapshot.end() );
+
+      m_snapshot[snapshots[i].get_date()] = new model_snapshot(snapshots[i]);
+    }
+
+  m_snapshot_source = NULL;
+} // model_action::load_snapshots()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Swap two actions.
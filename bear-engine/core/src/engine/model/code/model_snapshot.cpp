@@ -69,8 +69,9 @@ bear::engine::model_snapshot::vertical_alignment::from_string
 bear::engine::model_snapshot::model_snapshot
 ( universe::time_type d, std::size_t n, std::string func,
   std::vector<std::string> sounds, bool glob )
-  : m_date(d), m_placement(n), m_function(func), m_sound_name(sounds),
-    m_sound_is_global(glob)
+  : m_date(d), m_placement(n), m_function(func),
+    m_function_symbol( text_interface::symbol_table::get_symbol(func) ),
+    m_sound_name(sounds), m_sound_is_global(glob)
 {
 
 } // model_snapshot::model_snapshot()
@@ -119,11 +120,22 @@ std::size_t bear::engine::model_snapshot::get_mark_placements_count() const
 /**
  * \brief Get the function to call when passing on the snapshot.
  */
-std::string bear::engine::model_snapshot::get_function() const
+const std::string& bear::engine::model_snapshot::get_function() const
 {
   return m_function;
 } // model_snapshot::get_function()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the symbol of the name of the function to call when passing on
+ *        the snapshot.
+ */
+bear::text_interface::symbol_table::symbol_type
+bear::engine::model_snapshot::get_function_symbol() const
+{
+  return m_function_symbol;
+} // model_snapshot::get_function_symbol()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the name of the sound to play when passing on this snapshot.
@@ -0,0 +1,59 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::model_snapshot_source class.
+ * \author Julien Jorge
+ */
+#include "engine/model/model_snapshot_source.hpp"
+
+#include "engine/model_loader.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param content The part of the model file describing the snapshots of the
+ *        action, beginning with their count.
+ * \param marks_count The number of marks of the action.
+ * \param major_version The major version number of the model file.
+ * \param minor_version The minor version number of the model file.
+ * \param release_version The release version number of the model file.
+ */
+bear::engine::model_snapshot_source::model_snapshot_source
+( const content_pointer& content, std::size_t marks_count,
+  unsigned int major_version, unsigned int minor_version,
+  unsigned int release_version )
+  : m_content(content), m_marks_count(marks_count),
+    m_major_version(major_version), m_minor_version(minor_version),
+    m_release_version(release_version), m_loaded(false)
+{
+
+} // model_snapshot_source::model_snapshot_source()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the snapshots of the action, reading them from the file the
+ *        first time.
+ */
+const bear::engine::model_snapshot_source::snapshot_list&
+bear::engine::model_snapshot_source::get_snapshots()
+{
+  if ( !m_loaded )
+    {
+      model_loader ldr
+        ( m_content, m_major_version, m_minor_version, m_release_version );
+
+      ldr.load_snapshots( m_marks_count, m_snapshots );
+
+      m_loaded = true;
+      m_content = content_pointer();
+    }
+
+  return m_snapshots;
+} // model_snapshot_source::get_snapshots()
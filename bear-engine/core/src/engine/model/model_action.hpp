@@ -15,6 +15,7 @@
 #define __ENGINE_MODEL_ACTION_HPP__
 
 #include "engine/model/model_mark.hpp"
+#include "engine/model/model_snapshot_source.hpp"
 
 #include "engine/class_export.hpp"
 
@@ -83,6 +84,7 @@ namespace bear
 
       universe::time_type get_duration() const;
       void add_snapshot( const model_snapshot& s );
+      void set_snapshot_source( const model_snapshot_source& source );
 
       const_snapshot_iterator get_snapshot_at( universe::time_type t ) const;
       const_snapshot_iterator snapshot_begin() const;
@@ -107,6 +109,8 @@ namespace bear
       snapshot_map::const_iterator
         get_snapshot_const_iterator_at( universe::time_type t ) const;
 
+      void load_snapshots() const;
+
     public:
       /** \brief An invalid mark identifier. */
       static const std::size_t not_an_id;
@@ -116,7 +120,11 @@ namespace bear
       std::vector<model_mark*> m_mark;
 
       /** \brief The snapshots in the action. */
-      snapshot_map m_snapshot;
+      mutable snapshot_map m_snapshot;
+
+      /** \brief Where to find the snapshots if they have not been loaded
+          yet. */
+      mutable claw::memory::smart_ptr<model_snapshot_source> m_snapshot_source;
 
       /** \brief The duration of the action. */
       universe::time_type m_duration;
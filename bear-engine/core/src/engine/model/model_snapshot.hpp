@@ -16,6 +16,7 @@
 
 #include "engine/model/model_mark_placement.hpp"
 #include "engine/class_export.hpp"
+#include "text_interface/symbol_table.hpp"
 
 #include <vector>
 #include <string>
@@ -73,7 +74,8 @@ namespace bear
       const model_mark_placement& get_mark_placement( std::size_t i ) const;
       std::size_t get_mark_placements_count() const;
 
-      std::string get_function() const;
+      const std::string& get_function() const;
+      text_interface::symbol_table::symbol_type get_function_symbol() const;
       std::string get_random_sound_name() const;
       bool sound_is_global() const;
 
@@ -105,6 +107,9 @@ namespace bear
           snapshot. */
       std::string m_function;
 
+      /** \brief The symbol of the name of the function to call. */
+      text_interface::symbol_table::symbol_type m_function_symbol;
+
       /**
        * \brief The name of the sound to play when passing on this
        *        snapshot. One of them will be randomly picked.
@@ -0,0 +1,86 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The snapshots of an action in a model file, kept unparsed until
+ *        they are needed.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_MODEL_SNAPSHOT_SOURCE_HPP__
+#define __ENGINE_MODEL_SNAPSHOT_SOURCE_HPP__
+
+#include "engine/model/model_snapshot.hpp"
+
+#include "engine/class_export.hpp"
+
+#include <string>
+#include <vector>
+#include <claw/smart_ptr.hpp>
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief The snapshots of an action in a model file, kept unparsed until
+     *        the first time the action is played.
+     *
+     * The source keeps only the part of the model file describing the
+     * snapshots of its action. The source itself is shared by the copies of an
+     * action, such that the snapshots are parsed only once, then copied in
+     * each action.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT model_snapshot_source
+    {
+    public:
+      /** \brief The type of the pointer to the part of the model file
+          describing the snapshots. */
+      typedef claw::memory::smart_ptr<std::string> content_pointer;
+
+      /** \brief The type of the list of the snapshots of the action. */
+      typedef std::vector<model_snapshot> snapshot_list;
+
+    public:
+      model_snapshot_source
+      ( const content_pointer& content, std::size_t marks_count,
+        unsigned int major_version, unsigned int minor_version,
+        unsigned int release_version );
+
+      const snapshot_list& get_snapshots();
+
+    private:
+      /** \brief The part of the model file describing the snapshots,
+          released once they are loaded. */
+      content_pointer m_content;
+
+      /** \brief The number of marks of the action. */
+      std::size_t m_marks_count;
+
+      /** \brief The major version number of the model file. */
+      unsigned int m_major_version;
+
+      /** \brief The minor version number of the model file. */
+      unsigned int m_minor_version;
+
+      /** \brief The release version number of the model file. */
+      unsigned int m_release_version;
+
+      /** \brief Tell if the snapshots have been read from the file. */
+      bool m_loaded;
+
+      /** \brief The snapshots of the action. */
+      snapshot_list m_snapshots;
+
+    }; // class model_snapshot_source
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_MODEL_SNAPSHOT_SOURCE_HPP__
@@ -16,9 +16,12 @@
 
 #include "engine/compiled_file.hpp"
 #include "engine/model/model_animation.hpp"
+#include "engine/model/model_snapshot_source.hpp"
 
 #include "engine/class_export.hpp"
 
+#include <streambuf>
+
 namespace bear
 {
   namespace engine
@@ -30,21 +33,56 @@ namespace bear
 
     /**
      * \brief This class loads a model_actor.
+     *
+     * The snapshots of the actions are not built by run(). The part of the
+     * file describing them is skipped value by value and kept in the actions,
+     * which parse it the first time they are needed. The sounds of the
+     * snapshots are nevertheless loaded by run().
+     *
      * \author Julien Jorge
      */
     class ENGINE_EXPORT model_loader
     {
+      friend class model_snapshot_source;
+
     private:
       /** \brief The type of the map containing all the animations of the
           model. */
       typedef std::vector<model_animation> anim_map_type;
 
+      /** \brief The type of the pointer to the content of the model file. */
+      typedef model_snapshot_source::content_pointer content_pointer;
+
+      /** \brief The type of the list of the snapshots of an action. */
+      typedef model_snapshot_source::snapshot_list snapshot_list;
+
+      /**
+       * \brief A stream buffer reading the content of the model file from
+       *        memory.
+       */
+      class content_buffer:
+        public std::streambuf
+      {
+      public:
+        explicit content_buffer( const std::string& content );
+
+      protected:
+        pos_type seekoff
+        ( off_type off, std::ios_base::seekdir dir,
+          std::ios_base::openmode which );
+
+      }; // class content_buffer
+
     public:
       model_loader( std::istream& f, level_globals& glob );
 
       model_actor* run();
 
     private:
+      model_loader
+      ( const content_pointer& content, unsigned int major_version,
+        unsigned int minor_version, unsigned int release_version );
+
       bool model_version_greater_or_equal
         ( unsigned int major, unsigned int minor, unsigned int release ) const;
 
@@ -52,19 +90,40 @@ namespace bear
       void load_action( model_actor& m, const anim_map_type& anim_map );
       void load_sound( std::vector<std::string>& sound_name, bool& glob );
       void load_marks( model_action& a, const anim_map_type& anim_map );
-      void load_snapshots( model_action& a );
-      void load_snapshot( model_action& a );
+      void
+      load_snapshots( std::size_t marks_count, snapshot_list& snapshots );
+      void skip_snapshots( model_action& a );
+      void skip_values( std::size_t n );
+      void load_snapshot( std::size_t marks_count, snapshot_list& snapshots );
       void load_mark_placements( model_snapshot& s );
       void load_mark_placement( model_snapshot& s );
 
       void load_animations( anim_map_type& anim_map );
 
     private:
+      /** \brief The number of values describing a snapshot before its
+          sounds, as read by load_snapshot(). */
+      static const std::size_t s_snapshot_header_size = 8;
+
+      /** \brief The number of values describing a mark placement, as read by
+          load_mark_placement(). */
+      static const std::size_t s_mark_placement_size = 19;
+
+      /** \brief The content of the file from which we load the model. */
+      content_pointer m_content;
+
+      /** \brief The buffer reading m_content. */
+      content_buffer m_buffer;
+
+      /** \brief The stream reading m_buffer. */
+      std::istream m_stream;
+
       /** \brief The file from which we load the model. */
       compiled_file m_file;
 
-      /** \brief The level_globals in which we load the resources. */
-      level_globals& m_level_globals;
+      /** \brief The level_globals in which we load the resources, NULL when
+          loading the snapshots of an action on demand. */
+      level_globals* m_level_globals;
 
       /** \brief The major version number in the model file. */
       unsigned int m_major_version;
@@ -39,7 +39,8 @@ namespace bear
       typedef std::list<net::message_handle> message_list;
 
     public:
-      client_connection( const std::string& host, unsigned int port );
+      client_connection
+      ( net::io_thread& io, const std::string& host, unsigned int port );
 
       const std::string& get_host() const;
       unsigned int get_port() const;
@@ -18,13 +18,14 @@
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
+ * \param io The thread in which the connection is processed.
  * \param h The host to which the client is connected.
  * \param p The port through which the client is connected.
  */
 bear::engine::client_connection::client_connection
-( const std::string& host, unsigned int port )
+( net::io_thread& io, const std::string& host, unsigned int port )
   : m_host(host), m_port(port),
-    m_client(host, port, message_factory::get_instance())
+    m_client(io, host, port, message_factory::get_instance())
 {
 
 } // client_connection::client_connection()
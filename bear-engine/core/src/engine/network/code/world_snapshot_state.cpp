@@ -0,0 +1,343 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::world_snapshot_state class.
+ * \author Julien Jorge
+ */
+#include "engine/network/world_snapshot_state.hpp"
+
+#include "engine/level.hpp"
+#include "engine/world.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/*----------------------------------------------------------------------------*/
+const double bear::engine::world_snapshot_state::s_position_scale = 64;
+const double bear::engine::world_snapshot_state::s_speed_scale = 64;
+const double bear::engine::world_snapshot_state::s_angle_scale = 4096;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::world_snapshot_state::world_snapshot_state()
+  : m_id(0)
+{
+
+} // world_snapshot_state::world_snapshot_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of the snapshot giving this state.
+ */
+std::size_t bear::engine::world_snapshot_state::get_id() const
+{
+  return m_id;
+} // world_snapshot_state::get_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of items in the state.
+ */
+std::size_t bear::engine::world_snapshot_state::get_item_count() const
+{
+  return m_items.size();
+} // world_snapshot_state::get_item_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a hash of the identifiers and the values of the items. Two states
+ *        with the same items have the same checksum.
+ */
+std::size_t bear::engine::world_snapshot_state::get_checksum() const
+{
+  std::size_t result( m_items.size() );
+
+  for ( item_map::const_iterator it=m_items.begin(); it!=m_items.end(); ++it )
+    {
+      boost::hash_combine( result, it->first );
+      boost::hash_range
+        ( result, it->second.values,
+          it->second.values + world_snapshot::field_count );
+    }
+
+  return result;
+} // world_snapshot_state::get_checksum()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the state of the living items of a level.
+ * \param id The identifier of the snapshot that will carry this state.
+ * \param lvl The level.
+ */
+void bear::engine::world_snapshot_state::capture
+( std::size_t id, const level& lvl )
+{
+  m_id = id;
+  m_items.clear();
+
+  for ( level::const_layer_iterator it=lvl.layer_begin(); it!=lvl.layer_end();
+        ++it )
+    if ( it->has_world() )
+      {
+        const world& w( it->get_world() );
+
+        for ( world::const_item_iterator item=w.living_items_begin();
+              item!=w.living_items_end(); ++item )
+          quantize( *item, m_items[item->get_id()] );
+      }
+} // world_snapshot_state::capture()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the state of the items of a level having the identifiers of the
+ *        items of this state.
+ * \param lvl The level.
+ * \return The number of items of the level that have been updated.
+ *
+ * The items of this state missing in the level are ignored: the snapshots
+ * do not tell the class and the fields of the items, thus the items can't be
+ * created here. They must be created by the level of the receiver, for
+ * example by the same messages as on the sender.
+ */
+std::size_t bear::engine::world_snapshot_state::apply( level& lvl ) const
+{
+  std::size_t result(0);
+
+  for ( level::layer_iterator it=lvl.layer_begin(); it!=lvl.layer_end(); ++it )
+    if ( it->has_world() )
+      {
+        const world& w( it->get_world() );
+
+        for ( world::const_item_iterator item=w.living_items_begin();
+              item!=w.living_items_end(); ++item )
+          {
+            const item_map::const_iterator s( m_items.find( item->get_id() ) );
+
+            if ( s != m_items.end() )
+              {
+                dequantize( s->second, *item );
+                ++result;
+              }
+          }
+      }
+
+  return result;
+} // world_snapshot_state::apply()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build a snapshot containing all the items of this state.
+ * \param s (out) The snapshot.
+ */
+void
+bear::engine::world_snapshot_state::make_keyframe( world_snapshot& s ) const
+{
+  s = world_snapshot( m_id, 0, true );
+
+  for ( item_map::const_iterator it=m_items.begin(); it!=m_items.end(); ++it )
+    s.add_item
+      ( it->first,
+        world_snapshot::all_fields | world_snapshot::absolute_values,
+        it->second.values );
+} // world_snapshot_state::make_keyframe()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build a snapshot containing the changes from a previous state to
+ *        this one.
+ * \param base The previous state.
+ * \param s (out) The snapshot.
+ */
+void bear::engine::world_snapshot_state::make_delta
+( const world_snapshot_state& base, world_snapshot& s ) const
+{
+  s = world_snapshot( m_id, base.m_id, false );
+
+  item_map::const_iterator it( m_items.begin() );
+  item_map::const_iterator b( base.m_items.begin() );
+
+  while ( (it != m_items.end()) || (b != base.m_items.end()) )
+    if ( (b == base.m_items.end())
+         || ((it != m_items.end()) && (it->first < b->first)) )
+      {
+        s.add_item
+          ( it->first,
+            world_snapshot::all_fields | world_snapshot::absolute_values,
+            it->second.values );
+        ++it;
+      }
+    else if ( (it == m_items.end()) || (b->first < it->first) )
+      {
+        s.add_removed_item( b->first );
+        ++b;
+      }
+    else
+      {
+        world_snapshot::value_type delta[world_snapshot::field_count];
+        unsigned int fields(0);
+        std::size_t n(0);
+
+        for ( std::size_t f=0; f!=world_snapshot::field_count; ++f )
+          if ( it->second.values[f] != b->second.values[f] )
+            {
+              fields |= 1 << f;
+              delta[n] = it->second.values[f] - b->second.values[f];
+              ++n;
+            }
+
+        if ( fields != 0 )
+          s.add_item( it->first, fields, delta );
+
+        ++it;
+        ++b;
+      }
+} // world_snapshot_state::make_delta()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update this state with a snapshot.
+ * \param s The snapshot.
+ * \return false if the snapshot is a delta against an other state than this
+ *         one. The state is then cleared until the next keyframe.
+ */
+bool bear::engine::world_snapshot_state::update( const world_snapshot& s )
+{
+  if ( s.is_keyframe() )
+    m_items.clear();
+  else if ( s.get_base_id() != m_id )
+    {
+      clear();
+      return false;
+    }
+
+  for ( std::size_t i=0; i!=s.get_removed_items().size(); ++i )
+    m_items.erase( s.get_removed_items()[i] );
+
+  for ( std::size_t i=0; i!=s.get_item_count(); ++i )
+    {
+      const unsigned int fields( s.get_item_fields(i) );
+
+      if ( fields & world_snapshot::absolute_values )
+        {
+          item_values& item( m_items[ s.get_item_id(i) ] );
+          std::fill
+            ( item.values, item.values + world_snapshot::field_count, 0 );
+          update_item( item, fields, s.get_item_values(i) );
+        }
+      else
+        {
+          const item_map::iterator it( m_items.find( s.get_item_id(i) ) );
+
+          if ( it == m_items.end() )
+            {
+              clear();
+              return false;
+            }
+
+          update_item( it->second, fields, s.get_item_values(i) );
+        }
+    }
+
+  m_id = s.get_id();
+
+  return true;
+} // world_snapshot_state::update()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove all the items from the state.
+ */
+void bear::engine::world_snapshot_state::clear()
+{
+  m_id = 0;
+  m_items.clear();
+} // world_snapshot_state::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the values of an item.
+ * \param item The values to update.
+ * \param fields The fields to update, and the absolute_values flag.
+ * \param values The new values if the absolute_values flag is set, the
+ *        differences with the current values otherwise.
+ */
+void bear::engine::world_snapshot_state::update_item
+( item_values& item, unsigned int fields,
+  const world_snapshot::value_type* values )
+{
+  const bool absolute( fields & world_snapshot::absolute_values );
+  std::size_t n(0);
+
+  for ( std::size_t f=0; f!=world_snapshot::field_count; ++f )
+    if ( fields & (1 << f) )
+      {
+        if ( absolute )
+          item.values[f] = values[n];
+        else
+          item.values[f] += values[n];
+
+        ++n;
+      }
+} // world_snapshot_state::update_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the quantized values of the physical state of an item.
+ * \param s The physical state.
+ * \param v (out) The quantized values.
+ */
+void bear::engine::world_snapshot_state::quantize
+( const universe::physical_item_state& s, item_values& v )
+{
+  v.values[world_snapshot::field_left] =
+    std::floor( s.get_left() * s_position_scale + 0.5 );
+  v.values[world_snapshot::field_bottom] =
+    std::floor( s.get_bottom() * s_position_scale + 0.5 );
+  v.values[world_snapshot::field_width] =
+    std::floor( s.get_width() * s_position_scale + 0.5 );
+  v.values[world_snapshot::field_height] =
+    std::floor( s.get_height() * s_position_scale + 0.5 );
+  v.values[world_snapshot::field_speed_x] =
+    std::floor( s.get_speed().x * s_speed_scale + 0.5 );
+  v.values[world_snapshot::field_speed_y] =
+    std::floor( s.get_speed().y * s_speed_scale + 0.5 );
+  v.values[world_snapshot::field_system_angle] =
+    std::floor( s.get_system_angle() * s_angle_scale + 0.5 );
+  v.values[world_snapshot::field_angular_speed] =
+    std::floor( s.get_angular_speed() * s_angle_scale + 0.5 );
+} // world_snapshot_state::quantize()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the physical state of an item from its quantized values.
+ * \param v The quantized values.
+ * \param s (out) The physical state.
+ */
+void bear::engine::world_snapshot_state::dequantize
+( const item_values& v, universe::physical_item_state& s )
+{
+  s.set_size
+    ( v.values[world_snapshot::field_width] / s_position_scale,
+      v.values[world_snapshot::field_height] / s_position_scale );
+  s.set_bottom_left
+    ( v.values[world_snapshot::field_left] / s_position_scale,
+      v.values[world_snapshot::field_bottom] / s_position_scale );
+  s.set_speed
+    ( v.values[world_snapshot::field_speed_x] / s_speed_scale,
+      v.values[world_snapshot::field_speed_y] / s_speed_scale );
+  s.set_system_angle
+    ( v.values[world_snapshot::field_system_angle] / s_angle_scale );
+  s.set_angular_speed
+    ( v.values[world_snapshot::field_angular_speed] / s_angle_scale );
+} // world_snapshot_state::dequantize()
@@ -13,6 +13,9 @@
  */
 #include "engine/network/message/sync.hpp"
 
+#include "net/binary_input.hpp"
+#include "net/binary_output.hpp"
+
 #include <iostream>
 
 MESSAGE_EXPORT( sync, bear::engine )
@@ -77,3 +80,25 @@ std::istream& bear::engine::sync::formatted_input( std::istream& is )
 {
   return is >> m_id >> m_active_sync;
 } // sync::formatted_input()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a binary representation of this message in a buffer.
+ * \param os The buffer in which we write.
+ */
+bear::net::binary_output&
+bear::engine::sync::formatted_output( net::binary_output& os ) const
+{
+  return os << m_id << m_active_sync;
+} // sync::formatted_output()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a binary representation of this message from a buffer.
+ * \param is The buffer from which we read.
+ */
+bear::net::binary_input&
+bear::engine::sync::formatted_input( net::binary_input& is )
+{
+  return is >> m_id >> m_active_sync;
+} // sync::formatted_input()
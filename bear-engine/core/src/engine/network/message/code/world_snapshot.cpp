@@ -0,0 +1,389 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::world_snapshot class.
+ * \author Julien Jorge
+ */
+#include "engine/network/message/world_snapshot.hpp"
+
+#include "net/binary_input.hpp"
+#include "net/binary_output.hpp"
+
+#include <claw/assert.hpp>
+#include <iostream>
+
+MESSAGE_EXPORT( world_snapshot, bear::engine )
+
+/*----------------------------------------------------------------------------*/
+const unsigned int bear::engine::world_snapshot::all_fields;
+const unsigned int bear::engine::world_snapshot::absolute_values;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::world_snapshot::world_snapshot()
+  : m_id(0), m_base_id(0), m_keyframe(true)
+{
+
+} // world_snapshot::world_snapshot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param id The identifier of the snapshot.
+ * \param base_id The identifier of the snapshot against which the values are
+ *        given. Ignored for a keyframe.
+ * \param keyframe Tell if the snapshot contains all the items.
+ */
+bear::engine::world_snapshot::world_snapshot
+( std::size_t id, std::size_t base_id, bool keyframe )
+  : m_id(id), m_base_id(keyframe ? 0 : base_id), m_keyframe(keyframe)
+{
+
+} // world_snapshot::world_snapshot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of the snapshot.
+ */
+std::size_t bear::engine::world_snapshot::get_id() const
+{
+  return m_id;
+} // world_snapshot::get_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of the snapshot against which the values are
+ *        given.
+ */
+std::size_t bear::engine::world_snapshot::get_base_id() const
+{
+  return m_base_id;
+} // world_snapshot::get_base_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the snapshot contains all the items.
+ */
+bool bear::engine::world_snapshot::is_keyframe() const
+{
+  return m_keyframe;
+} // world_snapshot::is_keyframe()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an item in the snapshot.
+ * \param id The identifier of the item. It must be greater than the
+ *        identifiers of the items already added.
+ * \param fields The fields given in values, and the absolute_values flag.
+ * \param values The values of the fields, in the order of the fields.
+ */
+void bear::engine::world_snapshot::add_item
+( base_item::id_type id, unsigned int fields, const value_type* values )
+{
+  CLAW_PRECOND( m_items.empty() || (m_items.back().id < id) );
+  CLAW_PRECOND( (fields & ~(all_fields | absolute_values)) == 0 );
+
+  item_entry entry;
+  entry.id = id;
+  entry.fields = fields;
+  entry.first_value = m_values.size();
+
+  m_items.push_back( entry );
+  m_values.insert( m_values.end(), values, values + get_field_count(fields) );
+} // world_snapshot::add_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell that an item has been removed since the base snapshot.
+ * \param id The identifier of the item. It must be greater than the
+ *        identifiers of the removed items already added.
+ */
+void bear::engine::world_snapshot::add_removed_item( base_item::id_type id )
+{
+  CLAW_PRECOND( m_removed.empty() || (m_removed.back() < id) );
+
+  m_removed.push_back( id );
+} // world_snapshot::add_removed_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of items listed in the snapshot.
+ */
+std::size_t bear::engine::world_snapshot::get_item_count() const
+{
+  return m_items.size();
+} // world_snapshot::get_item_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of an item listed in the snapshot.
+ * \param i The index of the item.
+ */
+bear::engine::base_item::id_type
+bear::engine::world_snapshot::get_item_id( std::size_t i ) const
+{
+  CLAW_PRECOND( i < m_items.size() );
+  return m_items[i].id;
+} // world_snapshot::get_item_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the fields given for an item listed in the snapshot, and the
+ *        absolute_values flag.
+ * \param i The index of the item.
+ */
+unsigned int
+bear::engine::world_snapshot::get_item_fields( std::size_t i ) const
+{
+  CLAW_PRECOND( i < m_items.size() );
+  return m_items[i].fields;
+} // world_snapshot::get_item_fields()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the values of the fields given for an item listed in the
+ *        snapshot.
+ * \param i The index of the item.
+ */
+const bear::engine::world_snapshot::value_type*
+bear::engine::world_snapshot::get_item_values( std::size_t i ) const
+{
+  CLAW_PRECOND( i < m_items.size() );
+
+  if ( m_values.empty() )
+    return NULL;
+  else
+    return &m_values[0] + m_items[i].first_value;
+} // world_snapshot::get_item_values()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifiers of the items removed since the base snapshot.
+ */
+const std::vector<bear::engine::base_item::id_type>&
+bear::engine::world_snapshot::get_removed_items() const
+{
+  return m_removed;
+} // world_snapshot::get_removed_items()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of values given for a mask of fields.
+ * \param fields The mask of the fields.
+ */
+std::size_t
+bear::engine::world_snapshot::get_field_count( unsigned int fields )
+{
+  std::size_t result(0);
+
+  for ( fields &= all_fields; fields != 0; fields &= fields - 1 )
+    ++result;
+
+  return result;
+} // world_snapshot::get_field_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a formatted representation of this message in a stream.
+ * \param os The stream in which we write.
+ */
+std::ostream&
+bear::engine::world_snapshot::formatted_output( std::ostream& os ) const
+{
+  os << m_id << ' ' << m_keyframe << ' ' << m_base_id << ' ' << m_items.size();
+
+  for ( std::size_t i=0; i!=m_items.size(); ++i )
+    {
+      os << ' ' << m_items[i].id << ' ' << m_items[i].fields;
+
+      const value_type* const values( get_item_values(i) );
+
+      for ( std::size_t j=0; j!=get_field_count(m_items[i].fields); ++j )
+        os << ' ' << values[j];
+    }
+
+  os << ' ' << m_removed.size();
+
+  for ( std::size_t i=0; i!=m_removed.size(); ++i )
+    os << ' ' << m_removed[i];
+
+  return os;
+} // world_snapshot::formatted_output()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a formatted representation of this message from a stream.
+ * \param is The stream from which we read.
+ */
+std::istream& bear::engine::world_snapshot::formatted_input( std::istream& is )
+{
+  clear();
+
+  std::size_t count(0);
+  is >> m_id >> m_keyframe >> m_base_id >> count;
+
+  for ( std::size_t i=0; is && (i!=count); ++i )
+    {
+      item_entry entry;
+
+      if ( (is >> entry.id >> entry.fields)
+           && ((entry.fields & ~(all_fields | absolute_values)) != 0) )
+        is.setstate( std::ios::failbit );
+
+      entry.first_value = m_values.size();
+      const std::size_t n( get_field_count(entry.fields) );
+
+      for ( std::size_t j=0; is && (j!=n); ++j )
+        {
+          value_type v;
+          if ( is >> v )
+            m_values.push_back(v);
+        }
+
+      if ( is && (m_values.size() == entry.first_value + n) )
+        m_items.push_back( entry );
+    }
+
+  is >> count;
+
+  for ( std::size_t i=0; is && (i!=count); ++i )
+    {
+      base_item::id_type id;
+
+      if ( is >> id )
+        m_removed.push_back(id);
+    }
+
+  if ( !is )
+    clear();
+
+  return is;
+} // world_snapshot::formatted_input()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a binary representation of this message in a buffer.
+ * \param os The buffer in which we write.
+ */
+bear::net::binary_output&
+bear::engine::world_snapshot::formatted_output( net::binary_output& os ) const
+{
+  os << m_id << m_keyframe;
+
+  if ( !m_keyframe )
+    os << m_base_id;
+
+  os << m_items.size();
+
+  base_item::id_type previous(0);
+
+  for ( std::size_t i=0; i!=m_items.size(); ++i )
+    {
+      os << (m_items[i].id - previous) << m_items[i].fields;
+      previous = m_items[i].id;
+
+      const value_type* const values( get_item_values(i) );
+
+      for ( std::size_t j=0; j!=get_field_count(m_items[i].fields); ++j )
+        os << values[j];
+    }
+
+  os << m_removed.size();
+  previous = 0;
+
+  for ( std::size_t i=0; i!=m_removed.size(); ++i )
+    {
+      os << (m_removed[i] - previous);
+      previous = m_removed[i];
+    }
+
+  return os;
+} // world_snapshot::formatted_output()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a binary representation of this message from a buffer.
+ * \param is The buffer from which we read.
+ */
+bear::net::binary_input&
+bear::engine::world_snapshot::formatted_input( net::binary_input& is )
+{
+  clear();
+
+  is >> m_id >> m_keyframe;
+
+  if ( !m_keyframe )
+    is >> m_base_id;
+
+  std::size_t count(0);
+  is >> count;
+
+  base_item::id_type previous(0);
+
+  for ( std::size_t i=0; !is.fail() && (i!=count); ++i )
+    {
+      item_entry entry;
+
+      if ( !(is >> entry.id >> entry.fields).fail()
+           && ((entry.fields & ~(all_fields | absolute_values)) != 0) )
+        is.set_fail();
+
+      entry.id += previous;
+      previous = entry.id;
+      entry.first_value = m_values.size();
+      const std::size_t n( get_field_count(entry.fields) );
+
+      for ( std::size_t j=0; !is.fail() && (j!=n); ++j )
+        {
+          value_type v(0);
+
+          if ( !(is >> v).fail() )
+            m_values.push_back(v);
+        }
+
+      if ( !is.fail() && (m_values.size() == entry.first_value + n) )
+        m_items.push_back( entry );
+    }
+
+  count = 0;
+  is >> count;
+  previous = 0;
+
+  for ( std::size_t i=0; !is.fail() && (i!=count); ++i )
+    {
+      base_item::id_type id(0);
+
+      if ( !(is >> id).fail() )
+        {
+          previous += id;
+          m_removed.push_back( previous );
+        }
+    }
+
+  // The items of a partial snapshot would be applied with missing values.
+  if ( is.fail() )
+    clear();
+
+  return is;
+} // world_snapshot::formatted_input()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the items and the values of the snapshot.
+ */
+void bear::engine::world_snapshot::clear()
+{
+  m_base_id = 0;
+  m_items.clear();
+  m_values.clear();
+  m_removed.clear();
+} // world_snapshot::clear()
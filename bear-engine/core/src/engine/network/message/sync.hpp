@@ -47,6 +47,9 @@ namespace bear
     private:
       virtual std::ostream& formatted_output( std::ostream& os ) const;
       virtual std::istream& formatted_input( std::istream& is );
+      virtual net::binary_output&
+      formatted_output( net::binary_output& os ) const;
+      virtual net::binary_input& formatted_input( net::binary_input& is );
 
     private:
       /** \brief An identifier associated with the sync message to not confuse
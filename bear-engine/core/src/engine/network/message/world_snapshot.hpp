@@ -0,0 +1,153 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The world_snapshot message carries the physical state of the items
+ *        of a level, or its changes since a previous snapshot.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_WORLD_SNAPSHOT_HPP__
+#define __ENGINE_WORLD_SNAPSHOT_HPP__
+
+#include "net/message/message.hpp"
+
+#include "engine/base_item.hpp"
+#include "engine/network/message/message_export.hpp"
+#include "engine/class_export.hpp"
+
+#include <vector>
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief The world_snapshot message carries the physical state of the
+     *        items of a level, or its changes since a previous snapshot.
+     *
+     * The values of the state are quantized integers. A keyframe contains the
+     * values of all the items. Otherwise, the snapshot is a delta against a
+     * base snapshot: an item is listed only if some of its values have
+     * changed, with a mask of the changed fields followed by the differences
+     * with the values of the base. The new items come with their absolute
+     * values and the items removed since the base are listed by identifier.
+     *
+     * In the binary representation, the items are sorted by identifier and
+     * each identifier is written as the difference with the previous one.
+     * The integers are written as variable length integers, such that
+     * everything fits in a few bytes per item.
+     *
+     * A message whose items are incomplete, or whose masks contain unknown
+     * fields, is rejected as a whole: the reading fails and the snapshot is
+     * left empty.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT world_snapshot:
+      public net::message
+    {
+      DECLARE_MESSAGE(world_snapshot);
+
+    public:
+      /** \brief The fields of the state of an item. */
+      enum field
+        {
+          field_left,
+          field_bottom,
+          field_width,
+          field_height,
+          field_speed_x,
+          field_speed_y,
+          field_system_angle,
+          field_angular_speed,
+          field_count
+        }; // enum field
+
+      /** \brief The type of the quantized value of a field. */
+      typedef long long value_type;
+
+      /** \brief The mask of all the fields. */
+      static const unsigned int all_fields = (1 << field_count) - 1;
+
+      /** \brief The flag telling that the values of an item are absolute
+          instead of differences with the base snapshot. */
+      static const unsigned int absolute_values = 1 << field_count;
+
+    private:
+      /** \brief An item listed in the snapshot. */
+      struct item_entry
+      {
+        /** \brief The identifier of the item. */
+        base_item::id_type id;
+
+        /** \brief The fields in the values, and the absolute_values flag. */
+        unsigned int fields;
+
+        /** \brief The index of the first value of the item in m_values. */
+        std::size_t first_value;
+
+      }; // struct item_entry
+
+    public:
+      world_snapshot();
+      world_snapshot( std::size_t id, std::size_t base_id, bool keyframe );
+
+      std::size_t get_id() const;
+      std::size_t get_base_id() const;
+      bool is_keyframe() const;
+
+      void add_item
+      ( base_item::id_type id, unsigned int fields, const value_type* values );
+      void add_removed_item( base_item::id_type id );
+
+      std::size_t get_item_count() const;
+      base_item::id_type get_item_id( std::size_t i ) const;
+      unsigned int get_item_fields( std::size_t i ) const;
+      const value_type* get_item_values( std::size_t i ) const;
+
+      const std::vector<base_item::id_type>& get_removed_items() const;
+
+      static std::size_t get_field_count( unsigned int fields );
+
+    private:
+      virtual std::ostream& formatted_output( std::ostream& os ) const;
+      virtual std::istream& formatted_input( std::istream& is );
+      virtual net::binary_output&
+      formatted_output( net::binary_output& os ) const;
+      virtual net::binary_input& formatted_input( net::binary_input& is );
+
+      void clear();
+
+    private:
+      /** \brief The identifier of the snapshot. */
+      std::size_t m_id;
+
+      /** \brief The identifier of the snapshot against which the values are
+          given, if this is not a keyframe. */
+      std::size_t m_base_id;
+
+      /** \brief Tell if the snapshot contains all the items. */
+      bool m_keyframe;
+
+      /** \brief The items listed in the snapshot, sorted by identifier. */
+      std::vector<item_entry> m_items;
+
+      /** \brief The values of the fields of the items. */
+      std::vector<value_type> m_values;
+
+      /** \brief The identifiers of the items removed since the base snapshot,
+          sorted by identifier. */
+      std::vector<base_item::id_type> m_removed;
+
+    }; // class world_snapshot
+
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_WORLD_SNAPSHOT_HPP__
@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The quantized physical state of the items of a level, as exchanged
+ *        in the world_snapshot messages.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_WORLD_SNAPSHOT_STATE_HPP__
+#define __ENGINE_WORLD_SNAPSHOT_STATE_HPP__
+
+#include "engine/network/message/world_snapshot.hpp"
+
+#include "engine/class_export.hpp"
+
+#include <map>
+
+namespace bear
+{
+  namespace universe
+  {
+    class physical_item_state;
+  } // namespace universe
+
+  namespace engine
+  {
+    class level;
+
+    /**
+     * \brief The quantized physical state of the items of a level, as
+     *        exchanged in the world_snapshot messages.
+     *
+     * The sender captures the state of its level at each snapshot and sends
+     * the difference with the previously sent state. The receiver updates its
+     * copy of the state with the snapshots and applies it to the items of its
+     * level having the same identifiers. The items are neither created nor
+     * killed by the snapshots, only their physical state is transmitted.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT world_snapshot_state
+    {
+    private:
+      /** \brief The quantized values of the fields of an item. */
+      struct item_values
+      {
+        /** \brief The values, indexed by world_snapshot::field. */
+        world_snapshot::value_type values[world_snapshot::field_count];
+
+      }; // struct item_values
+
+      /** \brief The states of the items, sorted by identifier. */
+      typedef std::map<base_item::id_type, item_values> item_map;
+
+    public:
+      world_snapshot_state();
+
+      std::size_t get_id() const;
+      std::size_t get_item_count() const;
+      std::size_t get_checksum() const;
+
+      void capture( std::size_t id, const level& lvl );
+      std::size_t apply( level& lvl ) const;
+
+      void make_keyframe( world_snapshot& s ) const;
+      void
+      make_delta( const world_snapshot_state& base, world_snapshot& s ) const;
+      bool update( const world_snapshot& s );
+
+      void clear();
+
+    private:
+      static void update_item
+      ( item_values& item, unsigned int fields,
+        const world_snapshot::value_type* values );
+
+      static void
+      quantize( const universe::physical_item_state& s, item_values& v );
+      static void
+      dequantize( const item_values& v, universe::physical_item_state& s );
+
+    private:
+      /** \brief The identifier of the snapshot giving this state. Zero if the
+          state does not come from a snapshot. */
+      std::size_t m_id;
+
+      /** \brief The states of the items. */
+      item_map m_items;
+
+      /** \brief The number of steps per unit in the quantized positions and
+          sizes. */
+      static const double s_position_scale;
+
+      /** \brief The number of steps per unit in the quantized speeds. */
+      static const double s_speed_scale;
+
+      /** \brief The number of steps per radian in the quantized angles and
+          angular speeds. */
+      static const double s_angle_scale;
+
+    }; // class world_snapshot_state
+
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_WORLD_SNAPSHOT_STATE_HPP__
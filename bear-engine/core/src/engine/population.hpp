@@ -16,6 +16,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <claw/functional.hpp>
 #include <claw/iterator.hpp>
 
@@ -36,6 +37,16 @@ namespace bear
       /** brief The type of the map containing the items. */
       typedef std::map<base_item::id_type, base_item*> item_map;
 
+      /** \brief The type of the map associating the symbols of the names of
+          the classes with the identifiers of their instances. */
+      typedef std::unordered_map
+      < base_item::symbol_type, std::set<base_item::id_type> > class_map;
+
+      /** \brief The type of the map associating the identifiers of the items
+          with the symbols of the names of their classes. */
+      typedef std::unordered_map<base_item::id_type, base_item::symbol_type>
+      item_class_map;
+
     public:
       /** \brief Iterator on the living items. */
       typedef claw::wrapped_iterator
@@ -46,6 +57,10 @@ namespace bear
             claw::const_pair_second<item_map::value_type> > >
       ::iterator_type const_iterator;
 
+      /** \brief The type of the set of the identifiers of the instances of a
+          class. */
+      typedef std::set<base_item::id_type> id_set;
+
     public:
       ~population();
 
@@ -55,12 +70,19 @@ namespace bear
 
       bool exists( base_item::id_type id ) const;
 
+      std::size_t count_instances( base_item::symbol_type c ) const;
+      const id_set& get_instances( base_item::symbol_type c ) const;
+
       void remove_dead_items();
       void clear();
 
       const_iterator begin() const;
       const_iterator end() const;
 
+    private:
+      void index_item( const base_item& item );
+      void unindex_item( base_item::id_type id );
+
     private:
       /** \brief All items currently in the game. */
       item_map m_items;
@@ -73,6 +95,18 @@ namespace bear
           remove_dead_items(). */
       std::set<base_item::id_type> m_dropped_items;
 
+      /** \brief The identifiers of the items in m_items, by symbol of the name
+          of their class. */
+      class_map m_instances;
+
+      /** \brief The symbol of the name of the class of each item in
+          m_items. */
+      item_class_map m_item_classes;
+
+      /** \brief The set returned by get_instances() for the classes without
+          any instance. */
+      static const id_set s_no_instance;
+
     }; // class population
   } // namespace engine
 } // namespace bear
@@ -0,0 +1,94 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Places the items of a level between their positions of the last two
+ *        progresses, for the rendering.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_RENDER_INTERPOLATION_HPP__
+#define __ENGINE_RENDER_INTERPOLATION_HPP__
+
+#include "engine/base_item.hpp"
+
+#include "engine/class_export.hpp"
+
+#include "universe/types.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace bear
+{
+  namespace engine
+  {
+    class level;
+
+    /**
+     * \brief Places the items of a level between their positions of the last
+     *        two progresses, for the rendering.
+     *
+     * The positions of the items are saved before each progress of the
+     * level. Before a rendering, the items are moved between these positions
+     * and their current positions, according to the time elapsed since the
+     * last progress. Then they are moved back to their current positions, such
+     * that the simulation is not altered.
+     *
+     * The items created during the last progress are not moved.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT render_interpolation
+    {
+    private:
+      /** \brief The position of an item. */
+      struct item_position
+      {
+        /** \brief The position of the bottom left corner. */
+        universe::position_type bottom_left;
+
+        /** \brief The angle of the item. */
+        double system_angle;
+
+      }; // struct item_position
+
+      /** \brief An item moved for the rendering. */
+      struct moved_item
+      {
+        /** \brief The item. */
+        base_item* item;
+
+        /** \brief The current position of the item. */
+        item_position position;
+
+      }; // struct moved_item
+
+      /** \brief The type of the map associating the identifiers of the items
+          with their previous positions. */
+      typedef std::unordered_map<base_item::id_type, item_position>
+      position_map;
+
+    public:
+      void save_positions( const level& lvl );
+      void interpolate( const level& lvl, double ratio );
+      void restore();
+      void clear();
+
+    private:
+      /** \brief The positions of the items before the last progress. */
+      position_map m_previous;
+
+      /** \brief The items moved by interpolate(). */
+      std::vector<moved_item> m_moved;
+
+    }; // class render_interpolation
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_RENDER_INTERPOLATION_HPP__
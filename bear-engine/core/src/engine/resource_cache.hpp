@@ -0,0 +1,138 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A process-wide cache of the decoded resources, shared by all the
+ *        level_globals.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_RESOURCE_CACHE_HPP__
+#define __ENGINE_RESOURCE_CACHE_HPP__
+
+#include "visual/image.hpp"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include <boost/thread/mutex.hpp>
+#include <claw/basic_singleton.hpp>
+
+#include "engine/class_export.hpp"
+
+namespace bear
+{
+  namespace engine
+  {
+    /**
+     * \brief The resource cache keeps the decoded images alive between the
+     *        levels, such that pushing, popping or restarting a level does not
+     *        decode the same files again.
+     *
+     * Each entry is reference counted by the level_globals using it. When an
+     * entry is not referenced anymore, it is kept in the cache as long as the
+     * memory budget allows it. The least recently used unreferenced entries
+     * are evicted first.
+     *
+     * The images hold the textures of the screen, thus the cache must be
+     * cleared before the screen is released.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT resource_cache :
+      public claw::pattern::basic_singleton<resource_cache>
+    {
+    private:
+      /** \brief The type of the parent class. */
+      typedef claw::pattern::basic_singleton<resource_cache> super;
+
+      /** \brief The type of the list of the names of the unreferenced
+          entries, ordered from the least recently used to the most recently
+          used. */
+      typedef std::list<std::string> lru_list;
+
+      /** \brief An entry of the cache. */
+      struct image_entry
+      {
+        /** \brief The cached image. */
+        visual::image image;
+
+        /** \brief How many level_globals use this image. */
+        std::size_t references;
+
+        /** \brief The estimated memory used by the image, in bytes. */
+        std::size_t memory;
+
+        /** \brief The position of the entry in the list of unreferenced
+            entries, valid only if references == 0. */
+        lru_list::iterator lru_position;
+
+      }; // struct image_entry
+
+      /** \brief The type of the map associating the entries with the names of
+          the resources. */
+      typedef std::unordered_map<std::string, image_entry> image_map;
+
+    public:
+      /** \brief The default memory budget of the cache, in bytes. */
+      static const std::size_t default_memory_budget;
+
+    public:
+      // Must be redefined to work correctly with dynamic libraries.
+      // At least under Windows with MinGW.
+      static resource_cache& get_instance();
+
+      resource_cache();
+
+      bool acquire_image( const std::string& name, visual::image& img );
+      void store_image( const std::string& name, const visual::image& img );
+      void release_image( const std::string& name );
+
+      void clear_unused();
+      void clear();
+
+      void set_memory_budget( std::size_t bytes );
+      std::size_t get_memory_budget() const;
+      std::size_t get_memory_usage() const;
+
+      std::size_t get_hit_count() const;
+      std::size_t get_miss_count() const;
+
+    private:
+      void evict_unused( std::size_t budget );
+
+    private:
+      /** \brief The images in the cache. */
+      image_map m_images;
+
+      /** \brief The names of the unreferenced images, the least recently used
+          first. */
+      lru_list m_unused;
+
+      /** \brief The maximum memory used by the cached entries, in bytes. */
+      std::size_t m_memory_budget;
+
+      /** \brief The estimated memory used by the cached entries, in bytes. */
+      std::size_t m_memory_usage;
+
+      /** \brief How many resources have been found in the cache. */
+      std::size_t m_hit_count;
+
+      /** \brief How many resources have not been found in the cache. */
+      std::size_t m_miss_count;
+
+      /** \brief The mutex preventing simultaneous accesses to the cache from
+          the threads loading the levels. */
+      mutable boost::mutex m_mutex;
+
+    }; // class resource_cache
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_RESOURCE_CACHE_HPP__
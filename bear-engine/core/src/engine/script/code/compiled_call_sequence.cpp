@@ -0,0 +1,198 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::engine::compiled_call_sequence class.
+ * \author Julien Jorge
+ */
+#include "engine/script/compiled_call_sequence.hpp"
+
+#include "engine/base_item.hpp"
+#include "text_interface/bound_method_call.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+#include <stdexcept>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::compiled_call_sequence::compiled_call::compiled_call()
+  : actor(NULL), call(NULL)
+{
+
+} // compiled_call_sequence::compiled_call::compiled_call()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::engine::compiled_call_sequence::compiled_call_sequence()
+  : m_compiled(false)
+{
+
+} // compiled_call_sequence::compiled_call_sequence()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy constructor.
+ * \param that The instance to copy from.
+ * \remark The calls are not copied since they refer to the actors of the
+ *         context of \a that. The new sequence must be compiled again.
+ */
+bear::engine::compiled_call_sequence::compiled_call_sequence
+( const compiled_call_sequence& that )
+  : m_compiled(false)
+{
+
+} // compiled_call_sequence::compiled_call_sequence()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::engine::compiled_call_sequence::~compiled_call_sequence()
+{
+  clear();
+} // compiled_call_sequence::~compiled_call_sequence()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Assignment.
+ * \param that The instance to copy from.
+ * \remark The calls are not copied since they refer to the actors of the
+ *         context of \a that. The sequence must be compiled again.
+ */
+bear::engine::compiled_call_sequence&
+bear::engine::compiled_call_sequence::operator=
+( const compiled_call_sequence& that )
+{
+  clear();
+  return *this;
+} // compiled_call_sequence::operator=()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Resolve the actors, the methods and the arguments of the calls of a
+ *        sequence.
+ * \param s The sequence to compile.
+ * \param c The context in which the sequence is executed.
+ */
+void bear::engine::compiled_call_sequence::compile
+( const call_sequence& s, const script_context& c )
+{
+  clear();
+
+  m_calls.reserve( s.size() );
+
+  for ( call_sequence::const_iterator it=s.begin(); it!=s.end(); ++it )
+    m_calls.push_back( compile_call(*it, c) );
+
+  m_compiled = true;
+} // compiled_call_sequence::compile()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the compiled calls.
+ */
+void bear::engine::compiled_call_sequence::clear()
+{
+  for ( std::size_t i=0; i!=m_calls.size(); ++i )
+    delete m_calls[i].call;
+
+  m_calls.clear();
+  m_compiled = false;
+} // compiled_call_sequence::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the calls have been compiled since the last call to clear().
+ */
+bool bear::engine::compiled_call_sequence::is_compiled() const
+{
+  return m_compiled;
+} // compiled_call_sequence::is_compiled()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute a call of the sequence.
+ * \param i The index of the call in the compiled sequence.
+ * \param c The context in which the sequence is executed.
+ * \return false if the call could not be resolved or if its actor does not
+ *         exist anymore. Then the call must be executed from its description.
+ */
+bool bear::engine::compiled_call_sequence::execute
+( std::size_t i, const script_context& c ) const
+{
+  CLAW_PRECOND( m_compiled );
+  CLAW_PRECOND( i < m_calls.size() );
+
+  const compiled_call& call( m_calls[i] );
+
+  if ( call.call == NULL )
+    return false;
+
+  text_interface::base_exportable* actor( call.actor );
+
+  if ( actor == NULL )
+    actor = call.actor_item.get();
+
+  if ( actor == NULL )
+    return false;
+
+  call.call->execute( actor, c );
+  return true;
+} // compiled_call_sequence::execute()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Resolve the actor, the method and the arguments of a call.
+ * \param info The call to resolve.
+ * \param c The context in which the sequence is executed.
+ */
+bear::engine::compiled_call_sequence::compiled_call
+bear::engine::compiled_call_sequence::compile_call
+( const call_sequence::call_info& info, const script_context& c ) const
+{
+  compiled_call result;
+
+  const std::string& name( info.call.get_actor_name() );
+  text_interface::base_exportable* const actor( c.get_actor(name) );
+
+  if ( actor == NULL )
+    return result;
+
+  // The actors inheriting from base_item are kept with a handle, since they
+  // may die before the call.
+  base_item* const item( c.get_actor_item(name) );
+
+  if ( (item != NULL) && (script_context::handle_type(item) == actor) )
+    result.actor_item = item;
+  else
+    result.actor = actor;
+
+  try
+    {
+      result.call =
+        actor->bind
+        ( info.call.get_method_name(), info.call.get_arguments(), c );
+    }
+  catch( const std::exception& e )
+    {
+      // The call will be executed from its description, where the error will
+      // be reported.
+      claw::logger << claw::log_verbose << "Can't bind the call to '" << name
+                   << '.' << info.call.get_method_name() << "' at date "
+                   << info.date << ": " << e.what() << std::endl;
+    }
+
+  return result;
+} // compiled_call_sequence::compile_call()
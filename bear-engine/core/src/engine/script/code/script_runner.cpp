@@ -29,6 +29,7 @@ void bear::engine::script_runner::set_actor_item
 ( const std::string& name, base_item* item )
 {
   m_context.set_actor_item(name, item);
+  m_compiled_sequence.clear();
 } // script_runner::set_actor_item()
 
 /*----------------------------------------------------------------------------*/
@@ -42,6 +43,7 @@ void bear::engine::script_runner::set_actor
 ( const std::string& name, text_interface::base_exportable* item )
 {
   m_context.set_actor(name, item);
+  m_compiled_sequence.clear();
 } // script_runner::set_actor()
 
 /*----------------------------------------------------------------------------*/
@@ -56,6 +58,7 @@ bool bear::engine::script_runner::load_script( const std::string& s )
   reset();
 
   m_context.set_actor("script", this);
+  m_compiled_sequence.compile( m_sequence, m_context );
 
   return result;
 } // script_runner::load_script()
@@ -161,17 +164,29 @@ void bear::engine::script_runner::end()
  */
 void bear::engine::script_runner::play_action()
 {
-  text_interface::base_exportable* actor =
-    m_context.get_actor( m_current_call->call.get_actor_name() );
+  if ( !m_compiled_sequence.is_compiled() )
+    m_compiled_sequence.compile( m_sequence, m_context );
 
-  if ( actor == NULL )
-    claw::logger << claw::log_error << "Unknown actor '"
-                 << m_current_call->call.get_actor_name() << "' at date "
-                 << m_current_call->date << std::endl;
-  else
-    actor->execute
-      ( m_current_call->call.get_method_name(),
-        m_current_call->call.get_arguments(), m_context );
+  const bool done
+    ( m_compiled_sequence.execute
+      ( m_current_call - m_sequence.begin(), m_context ) );
+
+  if ( !done )
+    {
+      // The call could not be resolved in advance, we do it from its
+      // description.
+      text_interface::base_exportable* actor =
+        m_context.get_actor( m_current_call->call.get_actor_name() );
+
+      if ( actor == NULL )
+        claw::logger << claw::log_error << "Unknown actor '"
+                     << m_current_call->call.get_actor_name() << "' at date "
+                     << m_current_call->date << std::endl;
+      else
+        actor->execute
+          ( m_current_call->call.get_method_name(),
+            m_current_call->call.get_arguments(), m_context );
+    }
 } // script_runner::play_action()
 
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,104 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A sequence of calls whose actors, methods and arguments have been
+ *        resolved in advance.
+ * \author Julien Jorge
+ */
+#ifndef __ENGINE_COMPILED_CALL_SEQUENCE_HPP__
+#define __ENGINE_COMPILED_CALL_SEQUENCE_HPP__
+
+#include "engine/script/call_sequence.hpp"
+#include "engine/script/script_context.hpp"
+
+#include "engine/class_export.hpp"
+
+#include <vector>
+
+namespace bear
+{
+  namespace text_interface
+  {
+    class bound_method_call;
+  } // namespace text_interface
+
+  namespace engine
+  {
+    /**
+     * \brief A sequence of calls whose actors, methods and arguments have been
+     *        resolved in advance.
+     *
+     * The calls of a call_sequence are compiled once in a flat array, in the
+     * same order, where each entry keeps the actor and the call bound with
+     * text_interface::base_exportable::bind(). Executing an entry then
+     * requires neither a search by name nor a conversion of the constant
+     * arguments.
+     *
+     * The compiled form refers to the actors of the context, thus it must be
+     * compiled again when an actor is changed. It is not copied with the
+     * sequence.
+     *
+     * \author Julien Jorge
+     */
+    class ENGINE_EXPORT compiled_call_sequence
+    {
+    private:
+      /** \brief A call of the sequence, resolved in advance. */
+      struct compiled_call
+      {
+      public:
+        compiled_call();
+
+      public:
+        /** \brief The actor on which the method is called, if it does not
+            inherit from base_item. */
+        text_interface::base_exportable* actor;
+
+        /** \brief The actor on which the method is called, if it inherits
+            from base_item. */
+        script_context::handle_type actor_item;
+
+        /** \brief The call to do, NULL if it could not be bound. */
+        text_interface::bound_method_call* call;
+
+      }; // struct compiled_call
+
+    public:
+      compiled_call_sequence();
+      compiled_call_sequence( const compiled_call_sequence& that );
+      ~compiled_call_sequence();
+
+      compiled_call_sequence& operator=( const compiled_call_sequence& that );
+
+      void compile( const call_sequence& s, const script_context& c );
+      void clear();
+
+      bool is_compiled() const;
+      bool execute( std::size_t i, const script_context& c ) const;
+
+    private:
+      compiled_call
+      compile_call
+      ( const call_sequence::call_info& info, const script_context& c ) const;
+
+    private:
+      /** \brief The calls, in the order of the compiled sequence. */
+      std::vector<compiled_call> m_calls;
+
+      /** \brief Tell if the calls have been compiled since the last call to
+          clear(). */
+      bool m_compiled;
+
+    }; // class compiled_call_sequence
+
+  } // namespace engine
+} // namespace bear
+
+#endif // __ENGINE_COMPILED_CALL_SEQUENCE_HPP__
@@ -36,13 +36,12 @@ namespace bear
     class ENGINE_EXPORT script_context:
       public text_interface::argument_converter
     {
-    private:
+    public:
       /** \brief Handle on the actor. */
       typedef
       universe::derived_item_handle
       <text_interface::base_exportable, base_item> handle_type;
 
-    public:
       /** \brief The type of the container in which we store the actors
           inheriting from base_item. */
       typedef std::map<std::string, handle_type> actor_item_map_type;
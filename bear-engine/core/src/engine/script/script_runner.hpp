@@ -16,6 +16,7 @@
 
 #include "engine/base_item.hpp"
 #include "engine/script/call_sequence.hpp"
+#include "engine/script/compiled_call_sequence.hpp"
 #include "engine/script/script_context.hpp"
 
 #include "engine/class_export.hpp"
@@ -68,6 +69,9 @@ namespace bear
       /** \brief The context in which the script is executed. */
       script_context m_context;
 
+      /** \brief The calls of the script, resolved in the context. */
+      compiled_call_sequence m_compiled_sequence;
+
       /** \brief The elapsed time since the beginning of the script. */
       universe::time_type m_date;
 
@@ -15,7 +15,9 @@
 #define __ENGINE_SPRITEPOS_HPP__
 
 #include <claw/rectangle.hpp>
-#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "engine/class_export.hpp"
 
@@ -58,20 +60,28 @@ namespace bear
     private:
       /** \brief The type of the container in which the sprite entries are
           stored. */
-      typedef std::list<sprite_entry> entry_list;
+      typedef std::vector<sprite_entry> entry_list;
+
+      /** \brief The type of the map associating the names of the entries with
+          their index in the entry_list. */
+      typedef std::unordered_map<std::string, std::size_t> entry_index;
 
     public:
       /** \brief The type of the iterator on non modifiable entries. */
       typedef entry_list::const_iterator const_iterator;
 
     public:
-      spritepos( std::istream& f );
+      spritepos();
+      explicit spritepos( std::istream& f );
 
       const_iterator begin() const;
       const_iterator end() const;
 
       const_iterator find( const std::string& name ) const;
 
+      bool empty() const;
+      std::size_t size() const;
+
     private:
       void load( std::istream& f );
 
@@ -79,6 +89,9 @@ namespace bear
       /** \brief The entries of the spritepos file. */
       entry_list m_entries;
 
+      /** \brief The index of the first entry having a given name. */
+      entry_index m_index;
+
     }; // class spritepos
   } // namespace engine
 } // namespace bear
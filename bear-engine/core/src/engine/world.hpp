@@ -53,6 +53,8 @@ namespace bear
       const_item_iterator living_items_begin() const;
       const_item_iterator living_items_end() const;
 
+      std::size_t count_living_items( base_item::symbol_type c ) const;
+
       void add_static( base_item* const& who );
 
       void register_item( base_item* const& who );
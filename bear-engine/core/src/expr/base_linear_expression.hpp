@@ -17,6 +17,7 @@
 #include <string>
 
 #include "expr/class_export.hpp"
+#include "expr/expression_program.hpp"
 
 namespace bear
 {
@@ -38,6 +39,14 @@ namespace bear
       virtual base_linear_expression* clone() const = 0;
       virtual result_type evaluate() const = 0;
 
+      /**
+       * \brief Add the instructions computing this expression in a program.
+       *        By default, the program calls evaluate().
+       * \param p The program.
+       */
+      virtual void compile( expression_program& p ) const
+      { p.push_call(*this); }
+
       std::string formatted_string() const { return ""; }
 
     }; // class base_linear_expression
@@ -50,6 +50,7 @@ namespace bear
 
       Base* clone() const;
       result_type evaluate() const;
+      void compile( expression_program& p ) const;
 
       std::string formatted_string() const;
 
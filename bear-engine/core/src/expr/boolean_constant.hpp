@@ -32,6 +32,7 @@ namespace bear
 
       base_boolean_expression* clone() const;
       bool evaluate() const;
+      void compile( expression_program& p ) const;
 
       std::string formatted_string() const;
 
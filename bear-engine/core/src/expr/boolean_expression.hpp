@@ -16,6 +16,8 @@
 
 #include <string>
 
+#include <boost/shared_ptr.hpp>
+
 #include "expr/class_export.hpp"
 
 namespace bear
@@ -23,6 +25,7 @@ namespace bear
   namespace expr
   {
     class base_boolean_expression;
+    class expression_program;
 
     /**
      * \brief A boolean expression.
@@ -41,6 +44,7 @@ namespace bear
       ~boolean_expression();
 
       bool evaluate() const;
+      void compile( expression_program& p ) const;
       operator bool() const;
 
       boolean_expression& operator=( const boolean_expression& that );
@@ -54,8 +58,13 @@ namespace bear
       std::string formatted_string() const;
 
     private:
-      /** \brief The implemented expression. */
-      base_boolean_expression* m_expr;
+      /** \brief The implemented expression. It is never modified, thus it is
+          shared by the copies of this expression. */
+      boost::shared_ptr<const base_boolean_expression> m_expr;
+
+      /** \brief The program computing m_expr, built on the first
+          evaluation. */
+      mutable boost::shared_ptr<const expression_program> m_program;
 
     }; // class boolean_expression
 
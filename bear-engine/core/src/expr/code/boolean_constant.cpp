@@ -43,6 +43,16 @@ bool bear::expr::boolean_constant::evaluate() const
   return m_value;
 } // boolean_constant::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::boolean_constant::compile( expression_program& p ) const
+{
+  p.push_constant( m_value ? 1 : 0 );
+} // boolean_constant::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets a formatted and human readable representation of this expression.
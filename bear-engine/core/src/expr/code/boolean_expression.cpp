@@ -15,11 +15,10 @@
 
 #include "expr/binary_boolean_expression.hpp"
 #include "expr/boolean_constant.hpp"
+#include "expr/expression_program.hpp"
 #include "expr/logical_not.hpp"
 #include "expr/logical_xor.hpp"
 
-#include <algorithm>
-
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Contructor.
@@ -49,7 +48,7 @@ bear::expr::boolean_expression::boolean_expression
  */
 bear::expr::boolean_expression::boolean_expression
 ( const boolean_expression& that )
-  : m_expr( that.m_expr->clone() )
+  : m_expr( that.m_expr ), m_program( that.m_program )
 {
 
 } // boolean_expression::boolean_expression()
@@ -60,7 +59,7 @@ bear::expr::boolean_expression::boolean_expression
  */
 bear::expr::boolean_expression::~boolean_expression()
 {
-  delete m_expr;
+  // nothing to do
 } // boolean_expression::~boolean_expression()
 
 /*----------------------------------------------------------------------------*/
@@ -69,9 +68,26 @@ bear::expr::boolean_expression::~boolean_expression()
  */
 bool bear::expr::boolean_expression::evaluate() const
 {
-  return m_expr->evaluate();
+  if ( !m_program )
+    {
+      expression_program* const p( new expression_program );
+      m_program.reset(p);
+      compile(*p);
+    }
+
+  return m_program->evaluate() != 0;
 } // boolean_expression::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::boolean_expression::compile( expression_program& p ) const
+{
+  m_expr->compile(p);
+} // boolean_expression::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Evaluate the expression.
@@ -89,9 +105,8 @@ bear::expr::boolean_expression::operator bool() const
 bear::expr::boolean_expression&
 bear::expr::boolean_expression::operator=( const boolean_expression& that )
 {
-  boolean_expression tmp(that);
-
-  std::swap(tmp.m_expr, m_expr);
+  m_expr = that.m_expr;
+  m_program = that.m_program;
 
   return *this;
 } // boolean_expression::operator=()
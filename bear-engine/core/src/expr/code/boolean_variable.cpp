@@ -46,6 +46,16 @@ bool bear::expr::boolean_variable::evaluate() const
   return m_value;
 } // boolean_variable::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::boolean_variable::compile( expression_program& p ) const
+{
+  p.push_variable( m_value );
+} // boolean_variable::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets a formatted and human readable representation of this expression.
@@ -0,0 +1,272 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::expr::expression_program class.
+ * \author Julien Jorge.
+ */
+#include "expr/expression_program.hpp"
+
+#include "expr/base_boolean_expression.hpp"
+#include "expr/base_linear_expression.hpp"
+
+#include <claw/assert.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::expr::expression_program::expression_program()
+  : m_depth(0), m_stack_size(0)
+{
+
+} // expression_program::expression_program()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an instruction pushing a constant value on the stack.
+ * \param v The value to push.
+ */
+void bear::expr::expression_program::push_constant( double v )
+{
+  instruction i;
+  i.code = op_constant;
+  i.argument.constant = v;
+
+  push_instruction(i);
+} // expression_program::push_constant()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an instruction pushing the value of a linear variable on the
+ *        stack.
+ * \param v The variable to push.
+ * \remark \a v must live longer than \a this.
+ */
+void bear::expr::expression_program::push_variable( const double& v )
+{
+  instruction i;
+  i.code = op_linear_variable;
+  i.argument.linear_variable = &v;
+
+  push_instruction(i);
+} // expression_program::push_variable()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an instruction pushing the value of a boolean variable on the
+ *        stack.
+ * \param v The variable to push.
+ * \remark \a v must live longer than \a this.
+ */
+void bear::expr::expression_program::push_variable( const bool& v )
+{
+  instruction i;
+  i.code = op_boolean_variable;
+  i.argument.boolean_variable = &v;
+
+  push_instruction(i);
+} // expression_program::push_variable()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an instruction pushing the evaluation of a linear expression on
+ *        the stack.
+ * \param e The expression to evaluate.
+ * \remark \a e must live longer than \a this.
+ */
+void
+bear::expr::expression_program::push_call( const base_linear_expression& e )
+{
+  instruction i;
+  i.code = op_linear_call;
+  i.argument.linear_call = &e;
+
+  push_instruction(i);
+} // expression_program::push_call()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an instruction pushing the evaluation of a boolean expression on
+ *        the stack.
+ * \param e The expression to evaluate.
+ * \remark \a e must live longer than \a this.
+ */
+void
+bear::expr::expression_program::push_call( const base_boolean_expression& e )
+{
+  instruction i;
+  i.code = op_boolean_call;
+  i.argument.boolean_call = &e;
+
+  push_instruction(i);
+} // expression_program::push_call()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an instruction replacing the values on the top of the stack with
+ *        the result of an operation on them. If these values are constants,
+ *        the operation is computed immediately.
+ * \param op The operation. It must be op_logical_not or a binary operation.
+ */
+void bear::expr::expression_program::push_operation( operation_code op )
+{
+  CLAW_PRECOND( op >= op_logical_not );
+
+  const std::size_t n( m_code.size() );
+
+  if ( op == op_logical_not )
+    {
+      CLAW_PRECOND( m_depth >= 1 );
+
+      if ( m_code[n - 1].code == op_constant )
+        m_code[n - 1].argument.constant =
+          ( m_code[n - 1].argument.constant == 0 ) ? 1 : 0;
+      else
+        {
+          instruction i;
+          i.code = op;
+          m_code.push_back(i);
+        }
+    }
+  else
+    {
+      CLAW_PRECOND( m_depth >= 2 );
+
+      if ( ( m_code[n - 2].code == op_constant )
+           && ( m_code[n - 1].code == op_constant ) )
+        {
+          m_code[n - 2].argument.constant =
+            apply
+            ( op, m_code[n - 2].argument.constant,
+              m_code[n - 1].argument.constant );
+          m_code.pop_back();
+        }
+      else
+        {
+          instruction i;
+          i.code = op;
+          m_code.push_back(i);
+        }
+
+      --m_depth;
+    }
+} // expression_program::push_operation()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Evaluate the program.
+ * \return The value on the top of the stack at the end of the program. The
+ *         booleans are returned as zero and one.
+ */
+double bear::expr::expression_program::evaluate() const
+{
+  CLAW_PRECOND( m_depth == 1 );
+
+  double local_stack[s_local_stack_size];
+  std::vector<double> heap_stack;
+  double* stack(local_stack);
+
+  if ( m_stack_size > s_local_stack_size )
+    {
+      heap_stack.resize( m_stack_size );
+      stack = &heap_stack[0];
+    }
+
+  std::size_t top(0);
+  const instruction* it( &m_code[0] );
+  const instruction* const eit( it + m_code.size() );
+
+  for ( ; it != eit; ++it )
+    switch ( it->code )
+      {
+      case op_constant:
+        stack[top] = it->argument.constant;
+        ++top;
+        break;
+      case op_linear_variable:
+        stack[top] = *it->argument.linear_variable;
+        ++top;
+        break;
+      case op_boolean_variable:
+        stack[top] = *it->argument.boolean_variable ? 1 : 0;
+        ++top;
+        break;
+      case op_linear_call:
+        stack[top] = it->argument.linear_call->evaluate();
+        ++top;
+        break;
+      case op_boolean_call:
+        stack[top] = it->argument.boolean_call->evaluate() ? 1 : 0;
+        ++top;
+        break;
+      case op_logical_not:
+        stack[top - 1] = ( stack[top - 1] == 0 ) ? 1 : 0;
+        break;
+      default:
+        --top;
+        stack[top - 1] = apply( it->code, stack[top - 1], stack[top] );
+      }
+
+  return stack[0];
+} // expression_program::evaluate()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an instruction pushing a value on the stack.
+ * \param i The instruction.
+ */
+void bear::expr::expression_program::push_instruction( const instruction& i )
+{
+  m_code.push_back(i);
+  ++m_depth;
+
+  if ( m_depth > m_stack_size )
+    m_stack_size = m_depth;
+} // expression_program::push_instruction()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compute the result of a binary operation.
+ * \param op The operation.
+ * \param left The left operand.
+ * \param right The right operand.
+ */
+double bear::expr::expression_program::apply
+( operation_code op, double left, double right )
+{
+  double result(0);
+
+  switch ( op )
+    {
+    case op_plus:          result = left + right; break;
+    case op_minus:         result = left - right; break;
+    case op_multiplies:    result = left * right; break;
+    case op_divides:       result = left / right; break;
+    case op_equal_to:      result = ( left == right ) ? 1 : 0; break;
+    case op_not_equal_to:  result = ( left != right ) ? 1 : 0; break;
+    case op_less:          result = ( left < right ) ? 1 : 0; break;
+    case op_less_equal:    result = ( left <= right ) ? 1 : 0; break;
+    case op_greater:       result = ( left > right ) ? 1 : 0; break;
+    case op_greater_equal: result = ( left >= right ) ? 1 : 0; break;
+    case op_logical_and:
+      result = ( ( left != 0 ) && ( right != 0 ) ) ? 1 : 0;
+      break;
+    case op_logical_or:
+      result = ( ( left != 0 ) || ( right != 0 ) ) ? 1 : 0;
+      break;
+    case op_logical_xor:
+      result = ( ( left != 0 ) != ( right != 0 ) ) ? 1 : 0;
+      break;
+    default:
+      CLAW_FAIL( "Not a binary operation." );
+    }
+
+  return result;
+} // expression_program::apply()
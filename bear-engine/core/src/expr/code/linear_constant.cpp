@@ -43,6 +43,16 @@ double bear::expr::linear_constant::evaluate() const
   return m_value;
 } // linear_constant::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::linear_constant::compile( expression_program& p ) const
+{
+  p.push_constant( m_value );
+} // linear_constant::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set the value of the constant.
@@ -15,8 +15,7 @@
 
 #include "expr/linear_constant.hpp"
 #include "expr/binary_linear_expression.hpp"
-
-#include <algorithm>
+#include "expr/expression_program.hpp"
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -48,7 +47,7 @@ bear::expr::linear_expression::linear_expression
  */
 bear::expr::linear_expression::linear_expression
 ( const linear_expression& that )
-  : m_expr( that.m_expr->clone() )
+  : m_expr( that.m_expr ), m_program( that.m_program )
 {
 
 } // linear_expression::linear_expression()
@@ -59,7 +58,7 @@ bear::expr::linear_expression::linear_expression
  */
 bear::expr::linear_expression::~linear_expression()
 {
-  delete m_expr;
+  // nothing to do
 } // linear_expression::~linear_expression()
 
 /*----------------------------------------------------------------------------*/
@@ -68,9 +67,26 @@ bear::expr::linear_expression::~linear_expression()
  */
 double bear::expr::linear_expression::evaluate() const
 {
-  return m_expr->evaluate();
+  if ( !m_program )
+    {
+      expression_program* const p( new expression_program );
+      m_program.reset(p);
+      compile(*p);
+    }
+
+  return m_program->evaluate();
 } // linear_expression::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::linear_expression::compile( expression_program& p ) const
+{
+  m_expr->compile(p);
+} // linear_expression::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Assignment.
@@ -79,9 +95,8 @@ double bear::expr::linear_expression::evaluate() const
 bear::expr::linear_expression&
 bear::expr::linear_expression::operator=( const linear_expression& that )
 {
-  linear_expression tmp(that);
-
-  std::swap(tmp.m_expr, m_expr);
+  m_expr = that.m_expr;
+  m_program = that.m_program;
 
   return *this;
 } // linear_expression::operator=()
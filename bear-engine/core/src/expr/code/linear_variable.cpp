@@ -43,3 +43,13 @@ double bear::expr::linear_variable::evaluate() const
 {
   return m_value;
 } // linear_variable::evaluate()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::linear_variable::compile( expression_program& p ) const
+{
+  p.push_variable( m_value );
+} // linear_variable::compile()
@@ -71,6 +71,17 @@ bool bear::expr::logical_not::evaluate() const
   return !m_operand.evaluate();
 } // logical_not::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::logical_not::compile( expression_program& p ) const
+{
+  m_operand.compile(p);
+  p.push_operation( expression_program::op_logical_not );
+} // logical_not::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets a formatted and human readable representation of this expression.
@@ -44,6 +44,18 @@ bool bear::expr::logical_xor::evaluate() const
   return m_left.evaluate() ^ m_right.evaluate();
 } // logical_xor::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+void bear::expr::logical_xor::compile( expression_program& p ) const
+{
+  m_left.compile(p);
+  m_right.compile(p);
+  p.push_operation( expression_program::op_logical_xor );
+} // logical_xor::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets a formatted and human readable representation of this expression.
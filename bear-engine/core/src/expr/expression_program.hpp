@@ -0,0 +1,197 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A linear or boolean expression compiled in a sequence of postfix
+ *        instructions.
+ * \author Julien Jorge
+ */
+#ifndef __EXPR_EXPRESSION_PROGRAM_HPP__
+#define __EXPR_EXPRESSION_PROGRAM_HPP__
+
+#include "expr/class_export.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace bear
+{
+  namespace expr
+  {
+    class base_boolean_expression;
+    class base_linear_expression;
+
+    /**
+     * \brief A linear or boolean expression compiled in a sequence of postfix
+     *        instructions.
+     *
+     * The program is built by the compile() method of the nodes of the
+     * expression tree, in postfix order: the operands are pushed before the
+     * operation. The operations whose operands are all constants are computed
+     * when they are pushed, so the program contains only their result. The
+     * nodes without a known compilation are called as a whole during the
+     * evaluation.
+     *
+     * The evaluation runs the instructions on a stack of doubles, where the
+     * booleans are represented by zero and one.
+     *
+     * \author Julien Jorge
+     */
+    class EXPR_EXPORT expression_program
+    {
+    public:
+      /** \brief The operations done by the instructions. */
+      enum operation_code
+        {
+          op_constant,
+          op_linear_variable,
+          op_boolean_variable,
+          op_linear_call,
+          op_boolean_call,
+          op_logical_not,
+          op_plus,
+          op_minus,
+          op_multiplies,
+          op_divides,
+          op_equal_to,
+          op_not_equal_to,
+          op_less,
+          op_less_equal,
+          op_greater,
+          op_greater_equal,
+          op_logical_and,
+          op_logical_or,
+          op_logical_xor
+        }; // enum operation_code
+
+    private:
+      /**
+       * \brief An instruction of the program.
+       */
+      struct instruction
+      {
+        /** \brief The operation done by the instruction. */
+        operation_code code;
+
+        /** \brief The argument of the operation, if any. */
+        union
+        {
+          /** \brief The value pushed by op_constant. */
+          double constant;
+
+          /** \brief The variable pushed by op_linear_variable. */
+          const double* linear_variable;
+
+          /** \brief The variable pushed by op_boolean_variable. */
+          const bool* boolean_variable;
+
+          /** \brief The expression evaluated by op_linear_call. */
+          const base_linear_expression* linear_call;
+
+          /** \brief The expression evaluated by op_boolean_call. */
+          const base_boolean_expression* boolean_call;
+
+        } argument;
+
+      }; // struct instruction
+
+    public:
+      expression_program();
+
+      void push_constant( double v );
+      void push_variable( const double& v );
+      void push_variable( const bool& v );
+      void push_call( const base_linear_expression& e );
+      void push_call( const base_boolean_expression& e );
+      void push_operation( operation_code op );
+
+      double evaluate() const;
+
+    private:
+      void push_instruction( const instruction& i );
+
+      static double apply( operation_code op, double left, double right );
+
+    private:
+      /** \brief The instructions of the program. */
+      std::vector<instruction> m_code;
+
+      /** \brief The number of values on the stack at the end of the
+          instructions. */
+      std::size_t m_depth;
+
+      /** \brief The maximum number of values on the stack during the
+          evaluation. */
+      std::size_t m_stack_size;
+
+      /** \brief The size of the stack allocated locally by evaluate(). The
+          larger programs allocate their stack on the heap. */
+      static const std::size_t s_local_stack_size = 32;
+
+    }; // class expression_program
+
+    /**
+     * \brief The operation code of the binary functions of the expressions.
+     *
+     * The specializations tell the code of the functions known by the
+     * expression_program. For the other functions, \a known is false and the
+     * expression is called as a whole.
+     *
+     * \author Julien Jorge
+     */
+    template<typename Function>
+    class binary_operation_code
+    {
+    public:
+      /** \brief Tell if the function has an operation code. */
+      static const bool known = false;
+
+      /** \brief The code of the function. */
+      static const expression_program::operation_code code =
+        expression_program::op_constant;
+
+    }; // class binary_operation_code
+
+/**
+ * \brief Declares the operation code of a binary function.
+ * \param function The type of the function.
+ * \param op The operation code of the function.
+ */
+#define EXPR_BINARY_OPERATION_CODE( function, op )                      \
+  template<>                                                            \
+  class binary_operation_code< function >                               \
+  {                                                                     \
+  public:                                                               \
+    static const bool known = true;                                     \
+    static const expression_program::operation_code code =              \
+      expression_program::op;                                           \
+  }
+
+    EXPR_BINARY_OPERATION_CODE( std::plus<double>, op_plus );
+    EXPR_BINARY_OPERATION_CODE( std::minus<double>, op_minus );
+    EXPR_BINARY_OPERATION_CODE( std::multiplies<double>, op_multiplies );
+    EXPR_BINARY_OPERATION_CODE( std::divides<double>, op_divides );
+    EXPR_BINARY_OPERATION_CODE( std::equal_to<double>, op_equal_to );
+    EXPR_BINARY_OPERATION_CODE( std::not_equal_to<double>, op_not_equal_to );
+    EXPR_BINARY_OPERATION_CODE( std::less<double>, op_less );
+    EXPR_BINARY_OPERATION_CODE( std::less_equal<double>, op_less_equal );
+    EXPR_BINARY_OPERATION_CODE( std::greater<double>, op_greater );
+    EXPR_BINARY_OPERATION_CODE( std::greater_equal<double>, op_greater_equal );
+    EXPR_BINARY_OPERATION_CODE( std::equal_to<bool>, op_equal_to );
+    EXPR_BINARY_OPERATION_CODE( std::not_equal_to<bool>, op_not_equal_to );
+    EXPR_BINARY_OPERATION_CODE( std::logical_and<bool>, op_logical_and );
+    EXPR_BINARY_OPERATION_CODE( std::logical_or<bool>, op_logical_or );
+
+#undef EXPR_BINARY_OPERATION_CODE
+
+  } // namespace expr
+} // namespace bear
+
+#endif // __EXPR_EXPRESSION_PROGRAM_HPP__
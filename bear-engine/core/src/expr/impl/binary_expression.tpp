@@ -122,6 +122,27 @@ bear::expr::binary_expression<Base, Operand, Function>::evaluate() const
   return f(get_left_operand().evaluate(), get_right_operand().evaluate());
 } // binary_expression::evaluate()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the instructions computing this expression in a program.
+ * \param p The program.
+ */
+template<typename Base, typename Operand, typename Function>
+void bear::expr::binary_expression<Base, Operand, Function>::compile
+( expression_program& p ) const
+{
+  typedef binary_operation_code<Function> operation;
+
+  if ( operation::known )
+    {
+      m_left.compile(p);
+      m_right.compile(p);
+      p.push_operation( operation::code );
+    }
+  else
+    p.push_call( static_cast<const Base&>(*this) );
+} // binary_expression::compile()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Gets a formatted and human readable representation of this expression.
@@ -21,6 +21,7 @@ namespace bear
   namespace expr
   {
     class base_linear_expression;
+    class expression_program;
 
     /**
      * \brief A linear expression.
@@ -39,6 +40,7 @@ namespace bear
       ~linear_expression();
 
       double evaluate() const;
+      void compile( expression_program& p ) const;
 
       linear_expression& operator=( const linear_expression& that );
 
@@ -63,8 +65,13 @@ namespace bear
       std::string formatted_string() const;
 
     private:
-      /** \brief The implemented expression. */
-      base_linear_expression* m_expr;
+      /** \brief The implemented expression. It is never modified, thus it is
+          shared by the copies of this expression. */
+      boost::shared_ptr<const base_linear_expression> m_expr;
+
+      /** \brief The program computing m_expr, built on the first
+          evaluation. */
+      mutable boost::shared_ptr<const expression_program> m_program;
 
     }; // class linear_expression
 
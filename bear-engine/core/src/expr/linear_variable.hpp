@@ -32,6 +32,7 @@ namespace bear
 
       base_linear_expression* clone() const;
       double evaluate() const;
+      void compile( expression_program& p ) const;
 
     private:
       /** \brief The value of the variable. */
@@ -63,6 +63,65 @@ void bear::input::finger::refresh()
     }
 } // finger::refresh()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the last events in a stream, to be read later with
+ *        read_state().
+ * \param os The stream in which the state is written.
+ */
+void bear::input::finger::write_state( std::ostream& os ) const
+{
+  os << m_events.size();
+
+  for ( event_list::const_iterator it=m_events.begin(); it!=m_events.end();
+        ++it )
+    os << ' ' << (unsigned int)it->get_type() << ' ' << it->get_finger_id()
+       << ' ' << it->get_position().x << ' ' << it->get_position().y
+       << ' ' << it->get_distance().x << ' ' << it->get_distance().y;
+} // finger::write_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the last events from a stream written by write_state().
+ * \param is The stream from which the state is read.
+ */
+void bear::input::finger::read_state( std::istream& is )
+{
+  m_events.clear();
+
+  std::size_t count(0);
+  is >> count;
+
+  for ( std::size_t i=0; is && (i!=count); ++i )
+    {
+      unsigned int type;
+      int finger_id;
+      position_type position;
+      position_type distance;
+
+      if ( !(is >> type >> finger_id >> position.x >> position.y
+             >> distance.x >> distance.y) )
+        break;
+
+      switch ( type )
+        {
+        case finger_event::finger_event_pressed:
+          m_events.push_back
+            ( finger_event::create_pressed_event( position, finger_id ) );
+          break;
+        case finger_event::finger_event_released:
+          m_events.push_back
+            ( finger_event::create_released_event( position, finger_id ) );
+          break;
+        case finger_event::finger_event_motion:
+          m_events.push_back
+            ( finger_event::create_motion_event
+              ( position, finger_id, distance ) );
+          break;
+        }
+    }
+} // finger::read_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Converts SDL's finger position into the coordinates of the engine.
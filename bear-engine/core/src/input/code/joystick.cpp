@@ -191,6 +191,42 @@ void bear::input::joystick::refresh()
         m_pressed_buttons.push_back( sdl_button_to_local(button) );
 } // joystick::refresh()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the pressed buttons in a stream, to be read later with
+ *        read_state().
+ * \param os The stream in which the state is written.
+ */
+void bear::input::joystick::write_state( std::ostream& os ) const
+{
+  os << m_pressed_buttons.size();
+
+  for ( const_iterator it=m_pressed_buttons.begin();
+        it!=m_pressed_buttons.end(); ++it )
+    os << ' ' << *it;
+} // joystick::write_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the pressed buttons from a stream written by write_state().
+ * \param is The stream from which the state is read.
+ */
+void bear::input::joystick::read_state( std::istream& is )
+{
+  m_pressed_buttons.clear();
+
+  std::size_t count(0);
+  is >> count;
+
+  for ( std::size_t i=0; is && (i!=count); ++i )
+    {
+      joy_code b;
+
+      if ( is >> b )
+        m_pressed_buttons.push_back( b );
+    }
+} // joystick::read_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the currently pressed axis.
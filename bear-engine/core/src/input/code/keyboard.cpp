@@ -278,6 +278,68 @@ void bear::input::keyboard::refresh()
   refresh_keys();
 } // keyboard::refresh()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the pressed keys and the last events in a stream, to be read
+ *        later with read_state().
+ * \param os The stream in which the state is written.
+ */
+void bear::input::keyboard::write_state( std::ostream& os ) const
+{
+  os << m_pressed_keys.size();
+
+  for ( const_iterator it=m_pressed_keys.begin(); it!=m_pressed_keys.end();
+        ++it )
+    os << ' ' << *it;
+
+  os << ' ' << m_key_events.size();
+
+  for ( event_list::const_iterator it=m_key_events.begin();
+        it!=m_key_events.end(); ++it )
+    os << ' ' << (unsigned int)it->get_type() << ' '
+       << it->get_info().get_code() << ' '
+       << (unsigned int)it->get_info().get_symbol();
+} // keyboard::write_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the pressed keys and the last events from a stream written by
+ *        write_state().
+ * \param is The stream from which the state is read.
+ */
+void bear::input::keyboard::read_state( std::istream& is )
+{
+  m_pressed_keys.clear();
+  m_key_events.clear();
+
+  std::size_t count(0);
+  is >> count;
+
+  for ( std::size_t i=0; is && (i!=count); ++i )
+    {
+      key_code k;
+
+      if ( is >> k )
+        m_pressed_keys.push_back( k );
+    }
+
+  count = 0;
+  is >> count;
+
+  for ( std::size_t i=0; is && (i!=count); ++i )
+    {
+      unsigned int type;
+      key_code k;
+      unsigned int symbol;
+
+      if ( is >> type >> k >> symbol )
+        m_key_events.push_back
+          ( key_event
+            ( (key_event::event_type)type,
+              key_info( k, (charset::char_type)symbol ) ) );
+    }
+} // keyboard::read_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get all keyboard events.
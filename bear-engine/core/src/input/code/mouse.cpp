@@ -158,6 +158,43 @@ void bear::input::mouse::refresh()
 #endif
 } // mouse::refresh()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the pressed buttons and the position of the cursor in a
+ *        stream, to be read later with read_state().
+ * \param os The stream in which the state is written.
+ */
+void bear::input::mouse::write_state( std::ostream& os ) const
+{
+  os << m_position.x << ' ' << m_position.y << ' ' << m_current_state.size();
+
+  for ( const_iterator it=m_current_state.begin(); it!=m_current_state.end();
+        ++it )
+    os << ' ' << (unsigned int)*it;
+} // mouse::write_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the pressed buttons and the position of the cursor from a stream
+ *        written by write_state().
+ * \param is The stream from which the state is read.
+ */
+void bear::input::mouse::read_state( std::istream& is )
+{
+  m_current_state.clear();
+
+  std::size_t count(0);
+  is >> m_position.x >> m_position.y >> count;
+
+  for ( std::size_t i=0; is && (i!=count); ++i )
+    {
+      unsigned int b;
+
+      if ( is >> b )
+        m_current_state.insert( (mouse_code)b );
+    }
+} // mouse::read_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Adds a button in m_pressed_buttons in response to a mouse button down
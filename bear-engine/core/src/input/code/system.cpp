@@ -21,6 +21,7 @@
 #include <SDL2/SDL.h>
 #include <claw/exception.hpp>
 #include <claw/assert.hpp>
+#include <sstream>
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -84,6 +85,70 @@ void bear::input::system::refresh()
   refresh_alone();
 } // system::refresh()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the state of the controllers on a single line of a stream, to
+ *        be read later with read_state().
+ * \param os The stream in which the state is written.
+ */
+void bear::input::system::write_state( std::ostream& os ) const
+{
+  m_keyboard->write_state( os );
+  os << ' ';
+  m_mouse->write_state( os );
+  os << ' ' << m_joystick.size();
+
+  for (unsigned int i=0; i!=m_joystick.size(); ++i)
+    {
+      os << ' ';
+      m_joystick[i]->write_state( os );
+    }
+
+  os << ' ';
+  m_finger->write_state( os );
+  os << '\n';
+} // system::write_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the state of the controllers from a line written by
+ *        write_state(), instead of reading the actual devices.
+ * \param is The stream from which the state is read.
+ * \return false if the line cannot be read.
+ *
+ * The joysticks recorded but not available on this system are ignored.
+ */
+bool bear::input::system::read_state( std::istream& is )
+{
+  m_keyboard->read_state( is );
+  m_mouse->read_state( is );
+
+  std::size_t count(0);
+  is >> count;
+
+  for (std::size_t i=0; is && (i!=count); ++i)
+    if ( i < m_joystick.size() )
+      m_joystick[i]->read_state( is );
+    else
+      {
+        std::size_t buttons(0);
+        unsigned int b;
+
+        for ( is >> buttons; is && (buttons != 0); --buttons )
+          is >> b;
+      }
+
+  for (std::size_t i=count; i<m_joystick.size(); ++i)
+    {
+      std::istringstream no_button( "0" );
+      m_joystick[i]->read_state( no_button );
+    }
+
+  m_finger->read_state( is );
+
+  return !is.fail();
+} // system::read_state()
+
 void bear::input::system::set_display( const display_projection& display )
 {
   m_mouse->set_display( display );
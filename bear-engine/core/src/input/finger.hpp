@@ -17,6 +17,7 @@
 #include "input/display_projection.hpp"
 #include "input/finger_event.hpp"
 
+#include <iostream>
 #include <vector>
 
 #include "input/class_export.hpp"
@@ -40,6 +41,8 @@ namespace bear
 
       // only for input::system
       void refresh();
+      void write_state( std::ostream& os ) const;
+      void read_state( std::istream& is );
 
     private:
       position_type convert_position( double x, double y ) const;
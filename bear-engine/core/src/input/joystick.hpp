@@ -14,6 +14,7 @@
 #ifndef __INPUT_JOYSTICK_HPP__
 #define __INPUT_JOYSTICK_HPP__
 
+#include <iostream>
 #include <string>
 #include <vector>
 #include <list>
@@ -59,6 +60,8 @@ namespace bear
 
       // only for input::system
       void refresh();
+      void write_state( std::ostream& os ) const;
+      void read_state( std::istream& is );
 
     private:
       joy_code get_pressed_axis() const;
@@ -14,6 +14,7 @@
 #ifndef __INPUT_KEYBOARD_HPP__
 #define __INPUT_KEYBOARD_HPP__
 
+#include <iostream>
 #include <string>
 #include <vector>
 #include <list>
@@ -50,6 +51,8 @@ namespace bear
 
       // only for input::system
       void refresh();
+      void write_state( std::ostream& os ) const;
+      void read_state( std::istream& is );
 
     private:
       void refresh_events();
@@ -17,6 +17,7 @@
 #include "input/class_export.hpp"
 #include "input/display_projection.hpp"
 
+#include <iostream>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -57,6 +58,8 @@ namespace bear
 
       // only for input::system
       void refresh();
+      void write_state( std::ostream& os ) const;
+      void read_state( std::istream& is );
 
     public:
 #include "input/mouse_codes.hpp"
@@ -16,6 +16,7 @@
 #define __INPUT_SYSTEM_HPP__
 
 #include <claw/basic_singleton.hpp>
+#include <iostream>
 #include <vector>
 
 #include "input/class_export.hpp"
@@ -52,6 +53,9 @@ namespace bear
 
       void refresh();
 
+      void write_state( std::ostream& os ) const;
+      bool read_state( std::istream& is );
+
       void set_display( const display_projection& display );
       
       finger& get_finger();
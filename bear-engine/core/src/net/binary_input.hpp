@@ -0,0 +1,82 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Read the values written by a bear::net::binary_output.
+ * \author Julien Jorge
+ */
+#ifndef __NET_BINARY_INPUT_HPP__
+#define __NET_BINARY_INPUT_HPP__
+
+#include "net/class_export.hpp"
+
+#include <string>
+
+namespace bear
+{
+  namespace net
+  {
+    /**
+     * \brief Read the values written by a bear::net::binary_output.
+     *
+     * As with the standard streams, a failed reading puts the input in a
+     * failure state in which the next readings do nothing.
+     *
+     * \author Julien Jorge
+     */
+    class NET_EXPORT binary_input
+    {
+    public:
+      binary_input( const char* first, const char* last );
+
+      binary_input& operator>>( bool& v );
+      binary_input& operator>>( short& v );
+      binary_input& operator>>( unsigned short& v );
+      binary_input& operator>>( int& v );
+      binary_input& operator>>( unsigned int& v );
+      binary_input& operator>>( long& v );
+      binary_input& operator>>( unsigned long& v );
+      binary_input& operator>>( long long& v );
+      binary_input& operator>>( unsigned long long& v );
+      binary_input& operator>>( float& v );
+      binary_input& operator>>( double& v );
+      binary_input& operator>>( std::string& v );
+
+      bool read_unsigned( unsigned long long& v );
+      bool read_signed( long long& v );
+      bool read( char* data, std::size_t size );
+
+      bool fail() const;
+      void set_fail();
+      std::size_t get_remaining_size() const;
+      const char* get_position() const;
+
+    private:
+      template<typename T>
+      binary_input& read_unsigned_value( T& v );
+
+      template<typename T>
+      binary_input& read_signed_value( T& v );
+
+    private:
+      /** \brief The next byte to read. */
+      const char* m_position;
+
+      /** \brief The end of the bytes to read. */
+      const char* const m_end;
+
+      /** \brief Tell if a reading has failed. */
+      bool m_fail;
+
+    }; // class binary_input
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_BINARY_INPUT_HPP__
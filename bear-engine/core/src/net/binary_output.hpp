@@ -0,0 +1,73 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A compact binary representation of some values, written in a
+ *        buffer.
+ * \author Julien Jorge
+ */
+#ifndef __NET_BINARY_OUTPUT_HPP__
+#define __NET_BINARY_OUTPUT_HPP__
+
+#include "net/class_export.hpp"
+
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace net
+  {
+    /**
+     * \brief A compact binary representation of some values, written in a
+     *        buffer.
+     *
+     * The integers are written with a variable number of bytes, seven bits per
+     * byte, the signed ones being zigzag encoded such that the small negative
+     * values remain short. The floating point values are written in the little
+     * endian order of their IEEE 754 representation and the strings are
+     * prefixed with their length.
+     *
+     * \author Julien Jorge
+     */
+    class NET_EXPORT binary_output
+    {
+    public:
+      explicit binary_output( std::vector<char>& buffer );
+
+      binary_output& operator<<( bool v );
+      binary_output& operator<<( short v );
+      binary_output& operator<<( unsigned short v );
+      binary_output& operator<<( int v );
+      binary_output& operator<<( unsigned int v );
+      binary_output& operator<<( long v );
+      binary_output& operator<<( unsigned long v );
+      binary_output& operator<<( long long v );
+      binary_output& operator<<( unsigned long long v );
+      binary_output& operator<<( float v );
+      binary_output& operator<<( double v );
+      binary_output& operator<<( const char* v );
+      binary_output& operator<<( const std::string& v );
+
+      void write_unsigned( unsigned long long v );
+      void write_signed( long long v );
+      void write( const char* data, std::size_t size );
+
+      static std::size_t get_unsigned_size( unsigned long long v );
+
+    private:
+      /** \brief The buffer at the end of which the values are written. */
+      std::vector<char>& m_buffer;
+
+    }; // class binary_output
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_BINARY_OUTPUT_HPP__
@@ -0,0 +1,354 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::binary_input class.
+ * \author Julien Jorge
+ */
+#include "net/binary_input.hpp"
+
+#include <cstring>
+#include <limits>
+
+#include <boost/cstdint.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param first The first byte to read.
+ * \param last The end of the bytes to read.
+ */
+bear::net::binary_input::binary_input( const char* first, const char* last )
+  : m_position(first), m_end(last), m_fail(false)
+{
+
+} // binary_input::binary_input()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a boolean.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( bool& v )
+{
+  char c;
+
+  if ( read( &c, 1 ) )
+    v = (c != 0);
+
+  return *this;
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( short& v )
+{
+  return read_signed_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input&
+bear::net::binary_input::operator>>( unsigned short& v )
+{
+  return read_unsigned_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( int& v )
+{
+  return read_signed_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( unsigned int& v )
+{
+  return read_unsigned_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( long& v )
+{
+  return read_signed_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input&
+bear::net::binary_input::operator>>( unsigned long& v )
+{
+  return read_unsigned_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( long long& v )
+{
+  return read_signed_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input&
+bear::net::binary_input::operator>>( unsigned long long& v )
+{
+  return read_unsigned_value( v );
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a floating point value.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( float& v )
+{
+  char bytes[4];
+
+  if ( read( bytes, sizeof(bytes) ) )
+    {
+      boost::uint32_t bits(0);
+
+      for ( std::size_t i(0); i != sizeof(bytes); ++i )
+        bits |= boost::uint32_t( (unsigned char)bytes[i] ) << (8 * i);
+
+      std::memcpy( &v, &bits, sizeof(v) );
+    }
+
+  return *this;
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a floating point value.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( double& v )
+{
+  char bytes[8];
+
+  if ( read( bytes, sizeof(bytes) ) )
+    {
+      boost::uint64_t bits(0);
+
+      for ( std::size_t i(0); i != sizeof(bytes); ++i )
+        bits |= boost::uint64_t( (unsigned char)bytes[i] ) << (8 * i);
+
+      std::memcpy( &v, &bits, sizeof(v) );
+    }
+
+  return *this;
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a string.
+ * \param v (out) The value read.
+ */
+bear::net::binary_input& bear::net::binary_input::operator>>( std::string& v )
+{
+  unsigned long long length;
+
+  if ( read_unsigned( length ) )
+    {
+      if ( length > get_remaining_size() )
+        m_fail = true;
+      else
+        {
+          v.assign( m_position, length );
+          m_position += length;
+        }
+    }
+
+  return *this;
+} // binary_input::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an unsigned integer written by binary_output::write_unsigned().
+ * \param v (out) The value read.
+ * \return false if the value could not be read.
+ */
+bool bear::net::binary_input::read_unsigned( unsigned long long& v )
+{
+  if ( m_fail )
+    return false;
+
+  unsigned long long result(0);
+  std::size_t shift(0);
+  const char* p( m_position );
+
+  while ( (p != m_end) && (shift < 64) )
+    {
+      const unsigned char c( *p );
+      ++p;
+
+      result |= (unsigned long long)(c & 0x7F) << shift;
+
+      if ( (c & 0x80) == 0 )
+        {
+          m_position = p;
+          v = result;
+          return true;
+        }
+
+      shift += 7;
+    }
+
+  m_fail = true;
+  return false;
+} // binary_input::read_unsigned()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a signed integer written by binary_output::write_signed().
+ * \param v (out) The value read.
+ * \return false if the value could not be read.
+ */
+bool bear::net::binary_input::read_signed( long long& v )
+{
+  unsigned long long u;
+
+  if ( !read_unsigned( u ) )
+    return false;
+
+  if ( (u & 1) == 0 )
+    v = u >> 1;
+  else
+    v = ~(u >> 1);
+
+  return true;
+} // binary_input::read_signed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read some bytes as is.
+ * \param data (out) The bytes read.
+ * \param size The number of bytes to read.
+ * \return false if the bytes could not be read.
+ */
+bool bear::net::binary_input::read( char* data, std::size_t size )
+{
+  if ( m_fail || (size > get_remaining_size()) )
+    {
+      m_fail = true;
+      return false;
+    }
+
+  std::memcpy( data, m_position, size );
+  m_position += size;
+
+  return true;
+} // binary_input::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a reading has failed.
+ */
+bool bear::net::binary_input::fail() const
+{
+  return m_fail;
+} // binary_input::fail()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Put the input in the failure state, for example when a value read is
+ *        not valid.
+ */
+void bear::net::binary_input::set_fail()
+{
+  m_fail = true;
+} // binary_input::set_fail()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of bytes not read yet.
+ */
+std::size_t bear::net::binary_input::get_remaining_size() const
+{
+  return m_end - m_position;
+} // binary_input::get_remaining_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the position of the next byte to read.
+ */
+const char* bear::net::binary_input::get_position() const
+{
+  return m_position;
+} // binary_input::get_position()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an unsigned integer and check that it fits in its type.
+ * \param v (out) The value read.
+ */
+template<typename T>
+bear::net::binary_input& bear::net::binary_input::read_unsigned_value( T& v )
+{
+  unsigned long long u;
+
+  if ( read_unsigned( u ) )
+    {
+      if ( u > (unsigned long long)std::numeric_limits<T>::max() )
+        m_fail = true;
+      else
+        v = u;
+    }
+
+  return *this;
+} // binary_input::read_unsigned_value()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a signed integer and check that it fits in its type.
+ * \param v (out) The value read.
+ */
+template<typename T>
+bear::net::binary_input& bear::net::binary_input::read_signed_value( T& v )
+{
+  long long s;
+
+  if ( read_signed( s ) )
+    {
+      if ( (s > (long long)std::numeric_limits<T>::max())
+           || (s < (long long)std::numeric_limits<T>::min()) )
+        m_fail = true;
+      else
+        v = s;
+    }
+
+  return *this;
+} // binary_input::read_signed_value()
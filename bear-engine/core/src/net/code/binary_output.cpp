@@ -0,0 +1,251 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::binary_output class.
+ * \author Julien Jorge
+ */
+#include "net/binary_output.hpp"
+
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param buffer The buffer at the end of which the values are written.
+ */
+bear::net::binary_output::binary_output( std::vector<char>& buffer )
+  : m_buffer(buffer)
+{
+
+} // binary_output::binary_output()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a boolean.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( bool v )
+{
+  m_buffer.push_back( v ? 1 : 0 );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( short v )
+{
+  write_signed( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output&
+bear::net::binary_output::operator<<( unsigned short v )
+{
+  write_unsigned( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( int v )
+{
+  write_signed( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( unsigned int v )
+{
+  write_unsigned( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( long v )
+{
+  write_signed( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output&
+bear::net::binary_output::operator<<( unsigned long v )
+{
+  write_unsigned( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( long long v )
+{
+  write_signed( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an integer.
+ * \param v The value to write.
+ */
+bear::net::binary_output&
+bear::net::binary_output::operator<<( unsigned long long v )
+{
+  write_unsigned( v );
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a floating point value.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( float v )
+{
+  boost::uint32_t bits;
+  std::memcpy( &bits, &v, sizeof(bits) );
+
+  for ( std::size_t i(0); i != sizeof(bits); ++i )
+    m_buffer.push_back( (bits >> (8 * i)) & 0xFF );
+
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a floating point value.
+ * \param v The value to write.
+ */
+bear::net::binary_output& bear::net::binary_output::operator<<( double v )
+{
+  boost::uint64_t bits;
+  std::memcpy( &bits, &v, sizeof(bits) );
+
+  for ( std::size_t i(0); i != sizeof(bits); ++i )
+    m_buffer.push_back( (bits >> (8 * i)) & 0xFF );
+
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a string.
+ * \param v The value to write.
+ */
+bear::net::binary_output&
+bear::net::binary_output::operator<<( const char* v )
+{
+  const std::size_t length( std::strlen(v) );
+
+  write_unsigned( length );
+  write( v, length );
+
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a string.
+ * \param v The value to write.
+ */
+bear::net::binary_output&
+bear::net::binary_output::operator<<( const std::string& v )
+{
+  write_unsigned( v.size() );
+  write( v.data(), v.size() );
+
+  return *this;
+} // binary_output::operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an unsigned integer on as few bytes as possible.
+ * \param v The value to write.
+ */
+void bear::net::binary_output::write_unsigned( unsigned long long v )
+{
+  while ( v >= 0x80 )
+    {
+      m_buffer.push_back( (v & 0x7F) | 0x80 );
+      v >>= 7;
+    }
+
+  m_buffer.push_back( v );
+} // binary_output::write_unsigned()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a signed integer on as few bytes as possible.
+ * \param v The value to write.
+ */
+void bear::net::binary_output::write_signed( long long v )
+{
+  const unsigned long long u( v );
+
+  if ( v < 0 )
+    write_unsigned( ~(u << 1) );
+  else
+    write_unsigned( u << 1 );
+} // binary_output::write_signed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write some bytes as is.
+ * \param data The bytes to write.
+ * \param size The number of bytes to write.
+ */
+void bear::net::binary_output::write( const char* data, std::size_t size )
+{
+  m_buffer.insert( m_buffer.end(), data, data + size );
+} // binary_output::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of bytes written by write_unsigned() for a given
+ *        value.
+ * \param v The value.
+ */
+std::size_t bear::net::binary_output::get_unsigned_size( unsigned long long v )
+{
+  std::size_t result(1);
+
+  for ( v >>= 7; v != 0; v >>= 7 )
+    ++result;
+
+  return result;
+} // binary_output::get_unsigned_size()
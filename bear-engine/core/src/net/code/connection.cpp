@@ -0,0 +1,589 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::connection class.
+ * \author Julien Jorge
+ */
+#include "net/connection.hpp"
+
+#include "net/binary_input.hpp"
+#include "net/binary_output.hpp"
+#include "net/message_encoder.hpp"
+#include "net/message/message.hpp"
+
+#include "debug/performance_counters.hpp"
+
+#include <claw/logger.hpp>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/placeholders.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+
+/*----------------------------------------------------------------------------*/
+const unsigned int bear::net::connection::s_ping_interval = 500;
+const unsigned int bear::net::connection::s_reconnection_delay = 1000;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param service The service processing the socket.
+ * \param f The factory instantiating the received messages. NULL if the
+ *        messages must be ignored.
+ */
+bear::net::connection::connection
+( boost::asio::io_service& service, const message_factory* f )
+  : m_service(service), m_socket(service), m_resolver(service),
+    m_ping_timer(service), m_reconnection_timer(service),
+    m_message_factory(f), m_port(0), m_closed(false), m_session(0),
+    m_read_buffer(4096), m_writing(false),
+    m_status(connection_status_disconnected), m_round_trip_time(0),
+    m_round_trip_time_deviation(0), m_bytes_sent(0), m_bytes_received(0)
+{
+
+} // connection::connection()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::net::connection::~connection()
+{
+  message* m;
+
+  while ( m_incoming.pop(m) )
+    delete m;
+
+  clear_outgoing();
+} // connection::~connection()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to connect to a server. This method is called by the thread of
+ *        the game.
+ * \param host The host to which we connect.
+ * \param port The port through which we connect.
+ */
+void bear::net::connection::connect
+( const std::string& host, unsigned int port )
+{
+  m_host = host;
+  m_port = port;
+  m_status = connection_status_connecting;
+
+  m_service.post( boost::bind( &connection::resolve, shared_from_this() ) );
+} // connection::connect()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the connection and stop trying to connect again. This method is
+ *        called by the thread of the game.
+ */
+void bear::net::connection::close()
+{
+  m_status = connection_status_disconnected;
+  m_service.post( boost::bind( &connection::do_close, shared_from_this() ) );
+} // connection::close()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Send some frames to the peer. This method is called by the thread of
+ *        the game.
+ * \param frames (in/out) The frames to send. The vector is empty after the
+ *        call.
+ */
+void bear::net::connection::send( std::vector<char>& frames )
+{
+  if ( frames.empty() )
+    return;
+
+  std::vector<char>* const buffer( new std::vector<char> );
+  buffer->swap( frames );
+
+  m_outgoing.push( buffer );
+  m_service.post( boost::bind( &connection::write, shared_from_this() ) );
+} // connection::send()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the oldest message received and not pulled yet. This method is
+ *        called by the thread of the game.
+ * \return The message or NULL if there is no message. The caller is
+ *         responsible of deleting the message.
+ */
+bear::net::message* bear::net::connection::pull_message()
+{
+  message* result;
+
+  if ( m_incoming.pop(result) )
+    return result;
+  else
+    return NULL;
+} // connection::pull_message()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the status of the connection.
+ */
+bear::net::connection_status bear::net::connection::get_status() const
+{
+  return m_status;
+} // connection::get_status()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get some measures about the connection.
+ */
+bear::net::connection_statistics bear::net::connection::get_statistics() const
+{
+  connection_statistics result;
+
+  result.round_trip_time = m_round_trip_time / 1000.0;
+  result.round_trip_time_deviation = m_round_trip_time_deviation / 1000.0;
+  result.incoming_queue_size = m_incoming.size();
+  result.outgoing_queue_size = m_outgoing.size();
+  result.bytes_sent = m_bytes_sent;
+  result.bytes_received = m_bytes_received;
+
+  return result;
+} // connection::get_statistics()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the socket connected to the peer, for example to accept a
+ *        connection in it. This method is called by the I/O thread.
+ */
+bear::net::connection::socket_type& bear::net::connection::get_socket()
+{
+  return m_socket;
+} // connection::get_socket()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start the exchanges with the peer once the socket is connected. This
+ *        method is called by the I/O thread.
+ */
+void bear::net::connection::start()
+{
+  ++m_session;
+  m_decoder.clear();
+  m_writing = false;
+  m_control_frames.clear();
+
+  // The frames are small and sent once per iteration of the game, there is
+  // no point in waiting to group them.
+  boost::system::error_code e;
+  m_socket.set_option( boost::asio::ip::tcp::no_delay(true), e );
+
+  m_status = connection_status_connected;
+
+  read();
+  schedule_ping();
+  write();
+} // connection::start()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Resolve the address of the server.
+ */
+void bear::net::connection::resolve()
+{
+  if ( m_closed )
+    return;
+
+  m_status = connection_status_connecting;
+
+  const boost::asio::ip::tcp::resolver::query query
+    ( m_host, boost::lexical_cast<std::string>(m_port) );
+
+  m_resolver.async_resolve
+    ( query,
+      boost::bind
+      ( &connection::on_resolved, shared_from_this(),
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::iterator ) );
+} // connection::resolve()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Connect to the server once its address is resolved.
+ * \param e The error of the resolution.
+ * \param it The addresses of the server.
+ */
+void bear::net::connection::on_resolved
+( const boost::system::error_code& e,
+  boost::asio::ip::tcp::resolver::iterator it )
+{
+  if ( m_closed )
+    return;
+
+  if ( e )
+    schedule_reconnection();
+  else
+    boost::asio::async_connect
+      ( m_socket, it,
+        boost::bind
+        ( &connection::on_connected, shared_from_this(),
+          boost::asio::placeholders::error ) );
+} // connection::on_resolved()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start the exchanges once connected to the server.
+ * \param e The error of the connection.
+ */
+void bear::net::connection::on_connected( const boost::system::error_code& e )
+{
+  if ( m_closed )
+    return;
+
+  if ( e )
+    {
+      boost::system::error_code ignored;
+      m_socket.close( ignored );
+      schedule_reconnection();
+    }
+  else
+    start();
+} // connection::on_connected()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Try to connect again to the server after a short delay.
+ */
+void bear::net::connection::schedule_reconnection()
+{
+  m_status = connection_status_connecting;
+
+  m_reconnection_timer.expires_from_now
+    ( boost::posix_time::milliseconds(s_reconnection_delay) );
+  m_reconnection_timer.async_wait
+    ( boost::bind
+      ( &connection::on_reconnection_timer, shared_from_this(),
+        boost::asio::placeholders::error ) );
+} // connection::schedule_reconnection()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Try to connect again to the server at the end of the delay.
+ * \param e The error of the timer.
+ */
+void bear::net::connection::on_reconnection_timer
+( const boost::system::error_code& e )
+{
+  if ( !e )
+    resolve();
+} // connection::on_reconnection_timer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait for the next bytes from the peer.
+ */
+void bear::net::connection::read()
+{
+  m_socket.async_read_some
+    ( boost::asio::buffer( m_read_buffer ),
+      boost::bind
+      ( &connection::on_read, shared_from_this(), m_session,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred ) );
+} // connection::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode the bytes received from the peer.
+ * \param session The identifier of the connection in which the bytes have been
+ *        read.
+ * \param e The error of the reading.
+ * \param n The number of bytes read.
+ */
+void bear::net::connection::on_read
+( std::size_t session, const boost::system::error_code& e, std::size_t n )
+{
+  if ( session != m_session )
+    return;
+
+  if ( e )
+    disconnect();
+  else
+    {
+      m_bytes_received += n;
+      BEAR_COUNTER_ADD( "net/bytes_received", n );
+      m_decoder.append( &m_read_buffer[0], n );
+
+      if ( !process_frames() )
+        return;
+
+      if ( m_decoder.is_corrupted() )
+        disconnect();
+      else
+        read();
+    }
+} // connection::on_read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Process the frames fully received.
+ * \return false if a frame can not be processed. In this case the connection
+ *         is closed.
+ */
+bool bear::net::connection::process_frames()
+{
+  std::size_t type;
+  const char* first;
+  const char* last;
+
+  try
+    {
+      while ( m_decoder.next_frame( type, first, last ) )
+        if ( type == message_encoder::type_ping )
+          message_encoder::append_frame
+            ( m_control_frames, message_encoder::type_pong, first,
+              last - first );
+        else if ( type == message_encoder::type_pong )
+          pong( first, last );
+        else if ( m_message_factory != NULL )
+          {
+            message* const m
+              ( m_decoder.create_message
+                ( type, first, last, *m_message_factory ) );
+
+            if ( m != NULL )
+              m_incoming.push( m );
+          }
+    }
+  catch( const std::exception& e )
+    {
+      claw::logger << claw::log_warning << "Invalid frame received: "
+                   << e.what() << std::endl;
+      disconnect();
+      return false;
+    }
+
+  write();
+  return true;
+} // connection::process_frames()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the duration of the round trip with the answer to a ping
+ *        frame.
+ * \param first The beginning of the content of the frame.
+ * \param last The end of the content of the frame.
+ */
+void bear::net::connection::pong( const char* first, const char* last )
+{
+  binary_input is( first, last );
+  unsigned long long date;
+
+  if ( (is >> date).fail() )
+    return;
+
+  const unsigned long long now( get_date() );
+
+  if ( now < date )
+    return;
+
+  const unsigned long long sample( now - date );
+  const unsigned long long previous( m_round_trip_time );
+
+  // The estimators are the ones used for the retransmission timer of TCP
+  // (RFC 6298).
+  if ( previous == 0 )
+    {
+      m_round_trip_time = sample;
+      m_round_trip_time_deviation = sample / 2;
+    }
+  else
+    {
+      const unsigned long long error
+        ( (sample > previous) ? sample - previous : previous - sample );
+
+      m_round_trip_time_deviation =
+        (3 * m_round_trip_time_deviation + error) / 4;
+      m_round_trip_time = (7 * previous + sample) / 8;
+    }
+} // connection::pong()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the pending frames in the socket, if it is not already being
+ *        written. The frames sent while the connection is being established
+ *        are kept until start() is called.
+ */
+void bear::net::connection::write()
+{
+  if ( m_status == connection_status_disconnected )
+    {
+      clear_outgoing();
+      return;
+    }
+
+  if ( m_status == connection_status_connecting )
+    return;
+
+  if ( m_writing )
+    return;
+
+  // The control frames are sent first, such that the measure of the round
+  // trip does not include the time spent in the queue.
+  m_write_buffer.clear();
+  m_write_buffer.swap( m_control_frames );
+
+  std::vector<char>* frames;
+
+  while ( m_outgoing.pop(frames) )
+    {
+      m_write_buffer.insert
+        ( m_write_buffer.end(), frames->begin(), frames->end() );
+      delete frames;
+    }
+
+  if ( m_write_buffer.empty() )
+    return;
+
+  m_writing = true;
+
+  boost::asio::async_write
+    ( m_socket, boost::asio::buffer( m_write_buffer ),
+      boost::bind
+      ( &connection::on_written, shared_from_this(), m_session,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred ) );
+} // connection::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Continue with the next frames once some frames are written.
+ * \param session The identifier of the connection in which the frames have
+ *        been written.
+ * \param e The error of the writing.
+ * \param n The number of bytes written.
+ */
+void bear::net::connection::on_written
+( std::size_t session, const boost::system::error_code& e, std::size_t n )
+{
+  if ( session != m_session )
+    return;
+
+  m_writing = false;
+
+  if ( e )
+    disconnect();
+  else
+    {
+      m_bytes_sent += n;
+      BEAR_COUNTER_ADD( "net/bytes_sent", n );
+      write();
+    }
+} // connection::on_written()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Send a ping frame after a delay.
+ */
+void bear::net::connection::schedule_ping()
+{
+  m_ping_timer.expires_from_now
+    ( boost::posix_time::milliseconds(s_ping_interval) );
+  m_ping_timer.async_wait
+    ( boost::bind
+      ( &connection::on_ping_timer, shared_from_this(), m_session,
+        boost::asio::placeholders::error ) );
+} // connection::schedule_ping()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Send a ping frame at the end of the delay.
+ * \param session The identifier of the connection in which the ping has been
+ *        scheduled.
+ * \param e The error of the timer.
+ */
+void bear::net::connection::on_ping_timer
+( std::size_t session, const boost::system::error_code& e )
+{
+  if ( e || (session != m_session)
+       || (m_status != connection_status_connected) )
+    return;
+
+  std::vector<char> payload;
+  binary_output os( payload );
+  os << get_date();
+
+  message_encoder::append_frame
+    ( m_control_frames, message_encoder::type_ping, &payload[0],
+      payload.size() );
+
+  write();
+  schedule_ping();
+} // connection::on_ping_timer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the socket after an error and try to connect again if the
+ *        connection has been created by connect().
+ */
+void bear::net::connection::disconnect()
+{
+  ++m_session;
+  m_writing = false;
+
+  boost::system::error_code ignored;
+  m_ping_timer.cancel( ignored );
+  m_socket.close( ignored );
+
+  clear_outgoing();
+
+  if ( m_host.empty() || m_closed )
+    m_status = connection_status_disconnected;
+  else
+    schedule_reconnection();
+} // connection::disconnect()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the connection definitively.
+ */
+void bear::net::connection::do_close()
+{
+  m_closed = true;
+
+  boost::system::error_code ignored;
+  m_resolver.cancel();
+  m_reconnection_timer.cancel( ignored );
+
+  disconnect();
+} // connection::do_close()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the frames waiting to be sent.
+ */
+void bear::net::connection::clear_outgoing()
+{
+  std::vector<char>* frames;
+
+  while ( m_outgoing.pop(frames) )
+    delete frames;
+} // connection::clear_outgoing()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the current date in microseconds, for the measure of the round
+ *        trips.
+ */
+unsigned long long bear::net::connection::get_date()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>
+    ( std::chrono::steady_clock::now().time_since_epoch() ).count();
+} // connection::get_date()
@@ -0,0 +1,67 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::io_thread class.
+ * \author Julien Jorge
+ */
+#include "net/io_thread.hpp"
+
+#include <claw/logger.hpp>
+
+#include <boost/bind.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::net::io_thread::io_thread()
+  : m_work( new boost::asio::io_service::work(m_service) ),
+    m_thread( boost::bind( &io_thread::run, this ) )
+{
+
+} // io_thread::io_thread()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The pending operations are abandoned.
+ */
+bear::net::io_thread::~io_thread()
+{
+  delete m_work;
+  m_service.stop();
+  m_thread.join();
+} // io_thread::~io_thread()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the service dispatching the events of the sockets.
+ */
+boost::asio::io_service& bear::net::io_thread::get_service()
+{
+  return m_service;
+} // io_thread::get_service()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The loop of the thread.
+ */
+void bear::net::io_thread::run()
+{
+  while ( !m_service.stopped() )
+    try
+      {
+        m_service.run();
+      }
+    catch( const std::exception& e )
+      {
+        claw::logger << claw::log_error << "Network thread: " << e.what()
+                     << std::endl;
+      }
+} // io_thread::run()
@@ -0,0 +1,164 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::listener class.
+ * \author Julien Jorge
+ */
+#include "net/listener.hpp"
+
+#include "net/connection.hpp"
+
+#include <claw/logger.hpp>
+
+#include <boost/asio/placeholders.hpp>
+#include <boost/bind.hpp>
+
+/*----------------------------------------------------------------------------*/
+const unsigned int bear::net::listener::s_accept_retry_delay = 1000;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param service The service processing the sockets.
+ * \param port The port on which the connections are accepted.
+ */
+bear::net::listener::listener
+( boost::asio::io_service& service, unsigned int port )
+  : m_service(service), m_acceptor(service), m_accept_timer(service)
+{
+  const boost::asio::ip::tcp::endpoint endpoint
+    ( boost::asio::ip::tcp::v4(), port );
+  boost::system::error_code e;
+
+  m_acceptor.open( endpoint.protocol(), e );
+
+  if ( !e )
+    m_acceptor.set_option
+      ( boost::asio::ip::tcp::acceptor::reuse_address(true), e );
+
+  if ( !e )
+    m_acceptor.bind( endpoint, e );
+
+  if ( !e )
+    m_acceptor.listen( boost::asio::socket_base::max_connections, e );
+
+  if ( e )
+    claw::logger << claw::log_error << "Can't listen on port " << port << ": "
+                 << e.message() << std::endl;
+} // listener::listener()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start to accept the connections. This method is called by the thread
+ *        of the game.
+ */
+void bear::net::listener::start()
+{
+  m_service.post( boost::bind( &listener::accept, shared_from_this() ) );
+} // listener::start()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop accepting the connections. This method is called by the thread
+ *        of the game.
+ */
+void bear::net::listener::close()
+{
+  m_service.post( boost::bind( &listener::do_close, shared_from_this() ) );
+} // listener::close()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the oldest connection accepted and not pulled yet. This method is
+ *        called by the thread of the game.
+ * \return The connection or NULL if there is no new connection.
+ */
+bear::net::listener::connection_pointer bear::net::listener::pull_connection()
+{
+  connection_pointer result;
+  m_connections.pop(result);
+  return result;
+} // listener::pull_connection()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait for the next connection.
+ */
+void bear::net::listener::accept()
+{
+  if ( !m_acceptor.is_open() )
+    return;
+
+  const connection_pointer c( new connection(m_service, NULL) );
+
+  m_acceptor.async_accept
+    ( c->get_socket(),
+      boost::bind
+      ( &listener::on_accepted, shared_from_this(), c,
+        boost::asio::placeholders::error ) );
+} // listener::accept()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pass a new connection to the thread of the game and wait for the next
+ *        one. If the acceptation failed, the next connection is waited after
+ *        a delay, since the error may last, like when there are too many open
+ *        files.
+ * \param c The new connection.
+ * \param e The error of the acceptation.
+ */
+void bear::net::listener::on_accepted
+( connection_pointer c, const boost::system::error_code& e )
+{
+  if ( e == boost::asio::error::operation_aborted )
+    return;
+
+  if ( !e )
+    {
+      c->start();
+      m_connections.push(c);
+      accept();
+    }
+  else
+    {
+      claw::logger << claw::log_warning << "Can't accept a connection: "
+                   << e.message() << std::endl;
+
+      m_accept_timer.expires_from_now
+        ( boost::posix_time::milliseconds(s_accept_retry_delay) );
+      m_accept_timer.async_wait
+        ( boost::bind
+          ( &listener::on_accept_timer, shared_from_this(),
+            boost::asio::placeholders::error ) );
+    }
+} // listener::on_accepted()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait for the next connection at the end of the delay following an
+ *        error.
+ * \param e The error of the timer.
+ */
+void bear::net::listener::on_accept_timer( const boost::system::error_code& e )
+{
+  if ( !e )
+    accept();
+} // listener::on_accept_timer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the socket accepting the connections.
+ */
+void bear::net::listener::do_close()
+{
+  boost::system::error_code ignored;
+  m_accept_timer.cancel( ignored );
+  m_acceptor.close( ignored );
+} // listener::do_close()
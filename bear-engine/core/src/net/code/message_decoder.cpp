@@ -0,0 +1,234 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::message_decoder class.
+ * \author Julien Jorge
+ */
+#include "net/message_decoder.hpp"
+
+#include "net/binary_input.hpp"
+#include "net/message_encoder.hpp"
+#include "net/message/message.hpp"
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::net::message_decoder::s_max_type_count(4096);
+const std::size_t bear::net::message_decoder::s_max_frame_length(1 << 24);
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::net::message_decoder::message_decoder()
+  : m_position(0), m_corrupted(false)
+{
+
+} // message_decoder::message_decoder()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Forget the received bytes and the declared types, for example when
+ *        the connection is restarted.
+ */
+void bear::net::message_decoder::clear()
+{
+  m_types.clear();
+  m_input.clear();
+  m_position = 0;
+  m_corrupted = false;
+} // message_decoder::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add some received bytes.
+ * \param data The bytes.
+ * \param size The number of bytes.
+ */
+void bear::net::message_decoder::append( const char* data, std::size_t size )
+{
+  if ( m_corrupted )
+    return;
+
+  if ( m_position == m_input.size() )
+    {
+      m_input.clear();
+      m_position = 0;
+    }
+  else if ( m_position >= m_input.size() / 2 )
+    {
+      m_input.erase( m_input.begin(), m_input.begin() + m_position );
+      m_position = 0;
+    }
+
+  m_input.insert( m_input.end(), data, data + size );
+} // message_decoder::append()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the peer has sent a frame exceeding the bounds of the
+ *        protocol. In this case, no more frame is decoded until clear() is
+ *        called.
+ */
+bool bear::net::message_decoder::is_corrupted() const
+{
+  return m_corrupted;
+} // message_decoder::is_corrupted()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the next message whose frame has been fully received. The control
+ *        frames are ignored.
+ * \param f The factory to use to instantiate the message.
+ * \return The message or NULL if there is no complete frame. The caller is
+ *         responsible of deleting the message.
+ */
+bear::net::message*
+bear::net::message_decoder::pull_message( const message_factory& f )
+{
+  message* result(NULL);
+  std::size_t type;
+  const char* first;
+  const char* last;
+
+  while ( (result == NULL) && next_frame( type, first, last ) )
+    result = create_message( type, first, last, f );
+
+  return result;
+} // message_decoder::pull_message()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the next frame fully received, except the ones declaring the
+ *        types of the messages, and consider it as decoded.
+ * \param type (out) The identifier of the type of the content of the frame.
+ * \param first (out) The beginning of the content of the frame.
+ * \param last (out) The end of the content of the frame.
+ * \return false if there is no complete frame.
+ */
+bool bear::net::message_decoder::next_frame
+( std::size_t& type, const char*& first, const char*& last )
+{
+  while ( next_raw_frame( first, last ) )
+    {
+      binary_input is( first, last );
+
+      if ( !(is >> type).fail() )
+        {
+          first = is.get_position();
+
+          if ( type == message_encoder::type_declaration )
+            declare_type( first, last );
+          else
+            return true;
+        }
+    }
+
+  return false;
+} // message_decoder::next_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the message contained in a frame.
+ * \param type The identifier of the type of the message.
+ * \param first The beginning of the content of the frame.
+ * \param last The end of the content of the frame.
+ * \param f The factory to use to instantiate the message.
+ * \return The message or NULL if the type is not a declared type of message
+ *         known by \a f, or if the content of the frame is not a valid
+ *         message. The caller is responsible of deleting the message.
+ */
+bear::net::message* bear::net::message_decoder::create_message
+( std::size_t type, const char* first, const char* last,
+  const message_factory& f ) const
+{
+  if ( type < message_encoder::first_message_type )
+    return NULL;
+
+  const std::size_t index( type - message_encoder::first_message_type );
+
+  if ( (index >= m_types.size()) || m_types[index].empty()
+       || !f.is_known_type( m_types[index] ) )
+    return NULL;
+
+  message* result( f.create( m_types[index] ) );
+  binary_input is( first, last );
+
+  if ( (is >> *result).fail() )
+    {
+      delete result;
+      result = NULL;
+    }
+
+  return result;
+} // message_decoder::create_message()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the next complete frame and consider it as decoded.
+ * \param first (out) The beginning of the content of the frame.
+ * \param last (out) The end of the content of the frame.
+ * \return false if there is no complete frame.
+ */
+bool bear::net::message_decoder::next_raw_frame
+( const char*& first, const char*& last )
+{
+  if ( m_corrupted || (m_position == m_input.size()) )
+    return false;
+
+  binary_input is( &m_input[0] + m_position, &m_input[0] + m_input.size() );
+  std::size_t length;
+
+  if ( (is >> length).fail() )
+    return false;
+
+  if ( length > s_max_frame_length )
+    {
+      m_corrupted = true;
+      return false;
+    }
+
+  if ( is.get_remaining_size() < length )
+    return false;
+
+  first = is.get_position();
+  last = first + length;
+  m_position = last - &m_input[0];
+
+  return true;
+} // message_decoder::next_raw_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the content of a frame declaring the identifier of a type.
+ * \param first The beginning of the content of the frame.
+ * \param last The end of the content of the frame.
+ */
+void bear::net::message_decoder::declare_type
+( const char* first, const char* last )
+{
+  binary_input is( first, last );
+  std::size_t id;
+  std::string name;
+
+  if ( (is >> id >> name).fail() || (id < message_encoder::first_message_type) )
+    return;
+
+  const std::size_t index( id - message_encoder::first_message_type );
+
+  if ( index >= s_max_type_count )
+    {
+      m_corrupted = true;
+      return;
+    }
+
+  if ( m_types.size() <= index )
+    m_types.resize( index + 1 );
+
+  m_types[index] = name;
+} // message_decoder::declare_type()
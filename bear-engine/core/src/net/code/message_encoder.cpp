@@ -0,0 +1,151 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::message_encoder class.
+ * \author Julien Jorge
+ */
+#include "net/message_encoder.hpp"
+
+#include "net/binary_output.hpp"
+#include "net/message/message.hpp"
+
+
+/*----------------------------------------------------------------------------*/
+const std::size_t bear::net::message_encoder::type_declaration = 0;
+const std::size_t bear::net::message_encoder::type_ping = 1;
+const std::size_t bear::net::message_encoder::type_pong = 2;
+const std::size_t bear::net::message_encoder::first_message_type = 3;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+bear::net::message_encoder::message_encoder()
+{
+
+} // message_encoder::message_encoder()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a message in the frames to send.
+ * \param m The message to send.
+ */
+void bear::net::message_encoder::push( const message& m )
+{
+  m_payload.clear();
+  encode( m, m_payload );
+  push( m.get_name(), m_payload );
+} // message_encoder::push()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an encoded message in the frames to send.
+ * \param name The name of the type of the message.
+ * \param payload The message, as encoded by encode().
+ */
+void bear::net::message_encoder::push
+( const std::string& name, const std::vector<char>& payload )
+{
+  const std::size_t type( get_type_id( name ) );
+
+  if ( payload.empty() )
+    push_frame( type, NULL, 0 );
+  else
+    push_frame( type, &payload[0], payload.size() );
+} // message_encoder::push()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if there is no frame to write.
+ */
+bool bear::net::message_encoder::empty() const
+{
+  return m_frames.empty();
+} // message_encoder::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Exchange the pending frames with the content of a buffer.
+ * \param frames (in/out) The buffer receiving the frames. The pending frames
+ *        are replaced by its content, thus it is expected to be empty.
+ */
+void bear::net::message_encoder::swap_frames( std::vector<char>& frames )
+{
+  m_frames.swap( frames );
+} // message_encoder::swap_frames()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the binary representation of a message.
+ * \param m The message to encode.
+ * \param payload (out) The buffer at the end of which the message is written.
+ */
+void bear::net::message_encoder::encode
+( const message& m, std::vector<char>& payload )
+{
+  binary_output os( payload );
+  os << m;
+} // message_encoder::encode()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a frame in a buffer.
+ * \param output The buffer at the end of which the frame is written.
+ * \param type The identifier of the type of the content of the frame.
+ * \param payload The content of the frame.
+ * \param size The size of the payload.
+ */
+void bear::net::message_encoder::append_frame
+( std::vector<char>& output, std::size_t type, const char* payload,
+  std::size_t size )
+{
+  binary_output os( output );
+  os.write_unsigned( binary_output::get_unsigned_size( type ) + size );
+  os.write_unsigned( type );
+  os.write( payload, size );
+} // message_encoder::append_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of the type of a message, declaring it if needed.
+ * \param name The name of the type of the message.
+ */
+std::size_t bear::net::message_encoder::get_type_id( const std::string& name )
+{
+  const std::map<std::string, std::size_t>::const_iterator it
+    ( m_types.find(name) );
+
+  if ( it != m_types.end() )
+    return it->second;
+
+  const std::size_t result( m_types.size() + first_message_type );
+  m_types[name] = result;
+
+  std::vector<char> declaration;
+  binary_output os( declaration );
+  os << result << name;
+
+  push_frame( type_declaration, &declaration[0], declaration.size() );
+
+  return result;
+} // message_encoder::get_type_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a frame in the frames to send.
+ * \param type The identifier of the type of the message in the frame.
+ * \param payload The content of the frame.
+ * \param size The size of the payload.
+ */
+void bear::net::message_encoder::push_frame
+( std::size_t type, const char* payload, std::size_t size )
+{
+  append_frame( m_frames, type, payload, size );
+} // message_encoder::push_frame()
@@ -13,18 +13,23 @@
  */
 #include "net/server.hpp"
 
+#include "net/connection.hpp"
+#include "net/io_thread.hpp"
+#include "net/listener.hpp"
 #include "net/message/message.hpp"
 
+#include <claw/assert.hpp>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
+ * \param io The thread in which the connections are processed.
  * \param port The port on which the server listens.
- * \param client_read_time_limit How long do we wait when asking a client for
- *        its content.
  */
-bear::net::server::server( unsigned int port, int client_read_time_limit )
-  : m_server(port), m_client_read_time_limit(client_read_time_limit)
+bear::net::server::server( io_thread& io, unsigned int port )
+  : m_listener( new listener( io.get_service(), port ) )
 {
+  m_listener->start();
 
 } // server::server()
 
@@ -34,9 +39,14 @@ bear::net::server::server( unsigned int port, int client_read_time_limit )
  */
 bear::net::server::~server()
 {
+  m_listener->close();
+
   for ( client_list::const_iterator it=m_clients.begin(); it!=m_clients.end();
         ++it )
-    delete *it;
+    {
+      (*it)->peer->close();
+      delete *it;
+    }
 } // server::~server()
 
 /*----------------------------------------------------------------------------*/
@@ -50,18 +60,42 @@ std::size_t bear::net::server::get_connection_count() const
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Dispatch a message to the clients.
+ * \brief Get some measures about the connection with a client.
+ * \param client_id The identifier of the client.
+ */
+bear::net::connection_statistics
+bear::net::server::get_statistics( std::size_t client_id ) const
+{
+  CLAW_PRECOND( client_id < m_clients.size() );
+
+  client_list::const_iterator it=m_clients.begin();
+  std::advance(it, client_id);
+
+  return (*it)->peer->get_statistics();
+} // server::get_statistics()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Dispatch a message to the clients. The message is actually sent at
+ *        the next call to flush().
  * \param m The message to dispatch.
  */
 void bear::net::server::dispatch_message( const message& m )
 {
-  for ( std::size_t i=0; i!=get_connection_count(); ++i )
-    send_message( i, m );
+  m_payload.clear();
+  message_encoder::encode( m, m_payload );
+
+  const std::string name( m.get_name() );
+
+  for ( client_list::const_iterator it=m_clients.begin(); it!=m_clients.end();
+        ++it )
+    (*it)->encoder.push( name, m_payload );
 } // server::dispatch_message()
       
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Send a message to one client.
+ * \brief Send a message to one client. The message is actually sent at the
+ *        next call to flush().
  * \param client_id The identifier of the client to which the message is sent.
  * \param m The message to send.
  */
@@ -72,9 +106,24 @@ void bear::net::server::send_message( std::size_t client_id, const message& m )
   client_list::const_iterator it=m_clients.begin();
   std::advance(it, client_id);
 
-  client_type& client = **it;
-  client << m.get_name() << '\n' << m << std::endl;
+  (*it)->encoder.push( m );
 } // server::send_message()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pass the pending messages to the thread sending them to the clients.
+ */
+void bear::net::server::flush()
+{
+  for ( client_list::const_iterator it=m_clients.begin(); it!=m_clients.end();
+        ++it )
+    if ( !(*it)->encoder.empty() )
+      {
+        m_payload.clear();
+        (*it)->encoder.swap_frames( m_payload );
+        (*it)->peer->send( m_payload );
+      }
+} // server::flush()
       
 /*----------------------------------------------------------------------------*/
 /**
@@ -82,21 +131,13 @@ void bear::net::server::send_message( std::size_t client_id, const message& m )
  */
 void bear::net::server::check_for_new_clients()
 {
-  bool check_client = true;
-  while (check_client)
+  for ( boost::shared_ptr<connection> peer = m_listener->pull_connection();
+        peer; peer = m_listener->pull_connection() )
     {
-      client_pointer c = new client_type(m_client_read_time_limit);
-      m_server.accept( *c, 0 );
-
-      if ( c->is_open() )
-        {
-          m_clients.push_back(c);
-          on_new_client(m_clients.size() - 1);
-        }
-      else
-        {
-          delete c;
-          check_client = false;
-        }
+      client_pointer c = new client_type;
+      c->peer = peer;
+
+      m_clients.push_back(c);
+      on_new_client(m_clients.size() - 1);
     }
 } // server::check_for_new_clients()
@@ -0,0 +1,201 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A connection exchanges the frames of the messages with a peer.
+ * \author Julien Jorge
+ */
+#ifndef __NET_CONNECTION_HPP__
+#define __NET_CONNECTION_HPP__
+
+#include "net/class_export.hpp"
+
+#include "net/connection_statistics.hpp"
+#include "net/connection_status.hpp"
+#include "net/message_decoder.hpp"
+#include "net/message_factory.hpp"
+#include "net/spsc_queue.hpp"
+
+#include <claw/non_copyable.hpp>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/enable_shared_from_this.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace net
+  {
+    class message;
+
+    /**
+     * \brief A connection exchanges the frames of the messages with a peer.
+     *
+     * The socket is processed in the thread of an io_thread. The messages
+     * received are decoded in this thread then passed to the thread of the
+     * game through a lock-free queue, and the frames to send come the other
+     * way through another queue. The methods documented as called by the
+     * thread of the game are the only ones that can be called from outside
+     * the io_thread.
+     *
+     * The connection periodically sends a ping frame to its peer, which
+     * answers with a pong frame, in order to measure the duration of a round
+     * trip.
+     *
+     * A connection created by connect() tries to connect again when the
+     * connection is lost, until close() is called.
+     *
+     * \author Julien Jorge
+     */
+    class NET_EXPORT connection:
+      public boost::enable_shared_from_this<connection>,
+      private claw::pattern::non_copyable
+    {
+    public:
+      /** \brief The type of the socket of the connection. */
+      typedef boost::asio::ip::tcp::socket socket_type;
+
+    public:
+      connection
+      ( boost::asio::io_service& service, const message_factory* f );
+      ~connection();
+
+      void connect( const std::string& host, unsigned int port );
+      void close();
+
+      void send( std::vector<char>& frames );
+      message* pull_message();
+
+      connection_status get_status() const;
+      connection_statistics get_statistics() const;
+
+      socket_type& get_socket();
+      void start();
+
+    private:
+      void resolve();
+      void on_resolved
+      ( const boost::system::error_code& e,
+        boost::asio::ip::tcp::resolver::iterator it );
+      void on_connected( const boost::system::error_code& e );
+      void schedule_reconnection();
+      void on_reconnection_timer( const boost::system::error_code& e );
+
+      void read();
+      void on_read
+      ( std::size_t session, const boost::system::error_code& e,
+        std::size_t n );
+      bool process_frames();
+      void pong( const char* first, const char* last );
+
+      void write();
+      void on_written
+      ( std::size_t session, const boost::system::error_code& e,
+        std::size_t n );
+
+      void schedule_ping();
+      void on_ping_timer
+      ( std::size_t session, const boost::system::error_code& e );
+
+      void disconnect();
+      void do_close();
+      void clear_outgoing();
+
+      static unsigned long long get_date();
+
+    private:
+      /** \brief The service processing the socket. */
+      boost::asio::io_service& m_service;
+
+      /** \brief The socket connected to the peer. */
+      socket_type m_socket;
+
+      /** \brief The resolver of the address of the peer. */
+      boost::asio::ip::tcp::resolver m_resolver;
+
+      /** \brief The timer triggering the ping frames. */
+      boost::asio::deadline_timer m_ping_timer;
+
+      /** \brief The timer triggering a new connection when the connection is
+          lost. */
+      boost::asio::deadline_timer m_reconnection_timer;
+
+      /** \brief The factory instantiating the received messages. NULL if the
+          messages are ignored. */
+      const message_factory* const m_message_factory;
+
+      /** \brief The host to which the connection is done, empty if the
+          connection has been accepted by a server. */
+      std::string m_host;
+
+      /** \brief The port through which the connection is done. */
+      unsigned int m_port;
+
+      /** \brief Tell if close() has been called. */
+      bool m_closed;
+
+      /** \brief The identifier of the current connection to the peer, such
+          that the events of a lost connection are ignored. */
+      std::size_t m_session;
+
+      /** \brief The decoder of the received frames. */
+      message_decoder m_decoder;
+
+      /** \brief The buffer receiving the bytes from the socket. */
+      std::vector<char> m_read_buffer;
+
+      /** \brief The frames being written in the socket. */
+      std::vector<char> m_write_buffer;
+
+      /** \brief Tell if m_write_buffer is being written. */
+      bool m_writing;
+
+      /** \brief The ping and pong frames to send. */
+      std::vector<char> m_control_frames;
+
+      /** \brief The messages received and not pulled yet. */
+      spsc_queue<message*> m_incoming;
+
+      /** \brief The frames to send. */
+      spsc_queue<std::vector<char>*> m_outgoing;
+
+      /** \brief The status of the connection. */
+      std::atomic<connection_status> m_status;
+
+      /** \brief The smoothed duration of a round trip, in microseconds. */
+      std::atomic<unsigned long long> m_round_trip_time;
+
+      /** \brief The smoothed deviation of the duration of the round trips, in
+          microseconds. */
+      std::atomic<unsigned long long> m_round_trip_time_deviation;
+
+      /** \brief The number of bytes sent through the connection. */
+      std::atomic<std::size_t> m_bytes_sent;
+
+      /** \brief The number of bytes received through the connection. */
+      std::atomic<std::size_t> m_bytes_received;
+
+      /** \brief The delay between two ping frames, in milliseconds. */
+      static const unsigned int s_ping_interval;
+
+      /** \brief The delay before connecting again when the connection failed,
+          in milliseconds. */
+      static const unsigned int s_reconnection_delay;
+
+    }; // class connection
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_CONNECTION_HPP__
@@ -0,0 +1,54 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Some measures about a connection.
+ * \author Julien Jorge
+ */
+#ifndef __NET_CONNECTION_STATISTICS_HPP__
+#define __NET_CONNECTION_STATISTICS_HPP__
+
+#include <cstddef>
+
+namespace bear
+{
+  namespace net
+  {
+    /**
+     * \brief Some measures about a connection.
+     * \author Julien Jorge
+     */
+    struct connection_statistics
+    {
+      /** \brief The smoothed duration of a round trip to the peer, in
+          milliseconds. Zero if it has not been measured yet. */
+      double round_trip_time;
+
+      /** \brief The smoothed deviation of the duration of the round trips,
+          in milliseconds. */
+      double round_trip_time_deviation;
+
+      /** \brief The number of messages received and not pulled yet. */
+      std::size_t incoming_queue_size;
+
+      /** \brief The number of buffers of frames waiting to be sent. */
+      std::size_t outgoing_queue_size;
+
+      /** \brief The number of bytes sent through the connection. */
+      std::size_t bytes_sent;
+
+      /** \brief The number of bytes received through the connection. */
+      std::size_t bytes_received;
+
+    }; // struct connection_statistics
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_CONNECTION_STATISTICS_HPP__
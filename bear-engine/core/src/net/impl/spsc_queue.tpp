@@ -0,0 +1,98 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::net::spsc_queue class.
+ * \author Julien Jorge
+ */
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+template<typename T>
+bear::net::spsc_queue<T>::spsc_queue()
+  : m_head(new node), m_tail(m_head), m_size(0)
+{
+  m_head->next.store( NULL, std::memory_order_relaxed );
+} // spsc_queue::spsc_queue()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The values still in the queue are destroyed.
+ */
+template<typename T>
+bear::net::spsc_queue<T>::~spsc_queue()
+{
+  while ( m_head != NULL )
+    {
+      node* const next( m_head->next.load( std::memory_order_relaxed ) );
+      delete m_head;
+      m_head = next;
+    }
+} // spsc_queue::~spsc_queue()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a value at the end of the queue. This method must be called by
+ *        the producer thread.
+ * \param v The value to add.
+ */
+template<typename T>
+void bear::net::spsc_queue<T>::push( const T& v )
+{
+  node* const n( new node );
+  n->value = v;
+  n->next.store( NULL, std::memory_order_relaxed );
+
+  // The size is increased before the value becomes visible, such that it
+  // never goes below zero when the consumer decreases it.
+  ++m_size;
+
+  m_tail->next.store( n, std::memory_order_release );
+  m_tail = n;
+} // spsc_queue::push()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the first value of the queue. This method must be called by
+ *        the consumer thread.
+ * \param v (out) The value removed from the queue.
+ * \return false if the queue is empty.
+ */
+template<typename T>
+bool bear::net::spsc_queue<T>::pop( T& v )
+{
+  node* const next( m_head->next.load( std::memory_order_acquire ) );
+
+  if ( next == NULL )
+    return false;
+
+  // The next node becomes the sentinel, it must not keep the value.
+  v = next->value;
+  next->value = T();
+
+  delete m_head;
+  m_head = next;
+
+  --m_size;
+
+  return true;
+} // spsc_queue::pop()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of values in the queue. The result is only an
+ *        estimate if the other thread is using the queue.
+ */
+template<typename T>
+std::size_t bear::net::spsc_queue<T>::size() const
+{
+  return m_size.load( std::memory_order_relaxed );
+} // spsc_queue::size()
@@ -0,0 +1,70 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The thread in which the inputs and the outputs of the connections
+ *        are done.
+ * \author Julien Jorge
+ */
+#ifndef __NET_IO_THREAD_HPP__
+#define __NET_IO_THREAD_HPP__
+
+#include "net/class_export.hpp"
+
+#include <claw/non_copyable.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace bear
+{
+  namespace net
+  {
+    /**
+     * \brief The thread in which the inputs and the outputs of the connections
+     *        are done.
+     *
+     * All the sockets of the servers and the clients created with a given
+     * io_thread are processed by its thread, waiting for the events of the
+     * system (epoll on Linux) such that the thread of the game never waits
+     * for the network.
+     *
+     * The io_thread must live longer than the servers and the clients using
+     * it.
+     *
+     * \author Julien Jorge
+     */
+    class NET_EXPORT io_thread:
+      private claw::pattern::non_copyable
+    {
+    public:
+      io_thread();
+      ~io_thread();
+
+      boost::asio::io_service& get_service();
+
+    private:
+      void run();
+
+    private:
+      /** \brief The service dispatching the events of the sockets. */
+      boost::asio::io_service m_service;
+
+      /** \brief Keeps m_service running when there is nothing to do. */
+      boost::asio::io_service::work* m_work;
+
+      /** \brief The thread running m_service. */
+      boost::thread m_thread;
+
+    }; // class io_thread
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_IO_THREAD_HPP__
@@ -0,0 +1,90 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A listener accepts the connections of the clients of a server.
+ * \author Julien Jorge
+ */
+#ifndef __NET_LISTENER_HPP__
+#define __NET_LISTENER_HPP__
+
+#include "net/class_export.hpp"
+
+#include "net/spsc_queue.hpp"
+
+#include <claw/non_copyable.hpp>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace bear
+{
+  namespace net
+  {
+    class connection;
+
+    /**
+     * \brief A listener accepts the connections of the clients of a server.
+     *
+     * The connections are accepted in the thread of an io_thread, then passed
+     * to the thread of the game through a lock-free queue. The methods
+     * documented as called by the thread of the game are the only ones that
+     * can be called from outside the io_thread.
+     *
+     * \author Julien Jorge
+     */
+    class NET_EXPORT listener:
+      public boost::enable_shared_from_this<listener>,
+      private claw::pattern::non_copyable
+    {
+    public:
+      /** \brief The type of the pointer to the accepted connections. */
+      typedef boost::shared_ptr<connection> connection_pointer;
+
+    public:
+      listener( boost::asio::io_service& service, unsigned int port );
+
+      void start();
+      void close();
+
+      connection_pointer pull_connection();
+
+    private:
+      void accept();
+      void on_accepted
+      ( connection_pointer c, const boost::system::error_code& e );
+      void on_accept_timer( const boost::system::error_code& e );
+      void do_close();
+
+    private:
+      /** \brief The service processing the sockets. */
+      boost::asio::io_service& m_service;
+
+      /** \brief The socket accepting the connections. */
+      boost::asio::ip::tcp::acceptor m_acceptor;
+
+      /** \brief The timer delaying the next acceptation after an error. */
+      boost::asio::deadline_timer m_accept_timer;
+
+      /** \brief The connections accepted and not pulled yet. */
+      spsc_queue<connection_pointer> m_connections;
+
+      /** \brief The delay before accepting the connections again when the
+          acceptation failed, in milliseconds. */
+      static const unsigned int s_accept_retry_delay;
+
+    }; // class listener
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_LISTENER_HPP__
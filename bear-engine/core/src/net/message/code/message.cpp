@@ -13,6 +13,11 @@
  */
 #include "net/message/message.hpp"
 
+#include "net/binary_input.hpp"
+#include "net/binary_output.hpp"
+
+#include <sstream>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Print a formatted message in a stream.
@@ -35,6 +40,30 @@ std::istream& operator>>( std::istream& is, bear::net::message& m )
   return m.formatted_input(is);
 } // operator>>()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the binary representation of a message in a buffer.
+ * \param os The buffer in which the message is written.
+ * \param m The message to write.
+ */
+bear::net::binary_output&
+operator<<( bear::net::binary_output& os, const bear::net::message& m )
+{
+  return m.formatted_output(os);
+} // operator<<()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the binary representation of a message from a buffer.
+ * \param is The buffer from which the message is read.
+ * \param m (out) The message read from the buffer.
+ */
+bear::net::binary_input&
+operator>>( bear::net::binary_input& is, bear::net::message& m )
+{
+  return m.formatted_input(is);
+} // operator>>()
+
 /*----------------------------------------------------------------------------*/
 /**
  * Constructor.
@@ -101,3 +130,42 @@ std::istream& bear::net::message::formatted_input( std::istream& is )
 {
   return is;
 } // message::formatted_input()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a binary representation of this message in a buffer.
+ * \param os The buffer in which we write.
+ *
+ * The default implementation writes the formatted text representation of the
+ * message, thus the messages that do not override this method can still be
+ * sent.
+ */
+bear::net::binary_output&
+bear::net::message::formatted_output( binary_output& os ) const
+{
+  std::ostringstream oss;
+  formatted_output( oss );
+
+  return os << oss.str();
+} // message::formatted_output()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a binary representation of this message from a buffer.
+ * \param is The buffer from which we read.
+ *
+ * The default implementation reads the formatted text representation written
+ * by the default implementation of the binary formatted_output().
+ */
+bear::net::binary_input& bear::net::message::formatted_input( binary_input& is )
+{
+  std::string text;
+
+  if ( !(is >> text).fail() )
+    {
+      std::istringstream iss( text );
+      formatted_input( iss );
+    }
+
+  return is;
+} // message::formatted_input()
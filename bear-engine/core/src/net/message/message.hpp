@@ -24,6 +24,8 @@ namespace bear
 {
   namespace net
   {
+    class binary_input;
+    class binary_output;
     class message;
   } // namespace net
 } // namespace bear
@@ -31,6 +33,10 @@ namespace bear
 NET_EXPORT std::ostream& operator<<
 ( std::ostream& os, const bear::net::message& m );
 NET_EXPORT std::istream& operator>>( std::istream& is, bear::net::message& m );
+NET_EXPORT bear::net::binary_output& operator<<
+( bear::net::binary_output& os, const bear::net::message& m );
+NET_EXPORT bear::net::binary_input& operator>>
+( bear::net::binary_input& is, bear::net::message& m );
 
 namespace bear
 {
@@ -47,6 +53,10 @@ namespace bear
         ( std::ostream& os, const message& m );
       friend NET_EXPORT std::istream& ::operator>>
         ( std::istream& is, message& m );
+      friend NET_EXPORT bear::net::binary_output& ::operator<<
+        ( bear::net::binary_output& os, const message& m );
+      friend NET_EXPORT bear::net::binary_input& ::operator>>
+        ( bear::net::binary_input& is, message& m );
 
     public:
       message();
@@ -60,6 +70,8 @@ namespace bear
     private:
       virtual std::ostream& formatted_output( std::ostream& os ) const;
       virtual std::istream& formatted_input( std::istream& is );
+      virtual binary_output& formatted_output( binary_output& os ) const;
+      virtual binary_input& formatted_input( binary_input& is );
       virtual std::string do_get_name() const = 0;
 
     private:
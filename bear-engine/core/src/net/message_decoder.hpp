@@ -0,0 +1,93 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The message_decoder extracts the messages from the frames received
+ *        through a connection.
+ * \author Julien Jorge
+ */
+#ifndef __NET_MESSAGE_DECODER_HPP__
+#define __NET_MESSAGE_DECODER_HPP__
+
+#include "net/class_export.hpp"
+#include "net/message_factory.hpp"
+
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace net
+  {
+    class message;
+
+    /**
+     * \brief The message_decoder extracts the messages from the frames
+     *        received through a connection.
+     *
+     * The bytes received are accumulated until a frame is complete, thus
+     * they can be appended in chunks of any size. The frames declaring the
+     * types of the messages are processed by the decoder, the other ones are
+     * returned by next_frame().
+     *
+     * The bytes come from a peer that is not trusted, thus the length of the
+     * frames and the identifiers of the types are bounded. Once a frame
+     * exceeds these bounds, the decoder is corrupted: it ignores the
+     * remaining bytes and the connection must be closed.
+     *
+     * \sa message_encoder
+     * \author Julien Jorge
+     */
+    class NET_EXPORT message_decoder
+    {
+    public:
+      message_decoder();
+
+      void clear();
+      void append( const char* data, std::size_t size );
+      bool is_corrupted() const;
+
+      message* pull_message( const message_factory& f );
+
+      bool next_frame
+      ( std::size_t& type, const char*& first, const char*& last );
+      message* create_message
+      ( std::size_t type, const char* first, const char* last,
+        const message_factory& f ) const;
+
+    private:
+      bool next_raw_frame( const char*& first, const char*& last );
+      void declare_type( const char* first, const char* last );
+
+    private:
+      /** \brief The names of the types of the messages, by identifier. */
+      std::vector<std::string> m_types;
+
+      /** \brief The bytes received. */
+      std::vector<char> m_input;
+
+      /** \brief The position of the first byte of m_input not decoded yet. */
+      std::size_t m_position;
+
+      /** \brief Tell if a frame has exceeded the bounds of the protocol. */
+      bool m_corrupted;
+
+      /** \brief The maximum number of types of messages declared by the
+          peer. */
+      static const std::size_t s_max_type_count;
+
+      /** \brief The maximum length of a frame, in bytes. */
+      static const std::size_t s_max_frame_length;
+
+    }; // class message_decoder
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_MESSAGE_DECODER_HPP__
@@ -0,0 +1,98 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The message_encoder builds the frames sent through a connection.
+ * \author Julien Jorge
+ */
+#ifndef __NET_MESSAGE_ENCODER_HPP__
+#define __NET_MESSAGE_ENCODER_HPP__
+
+#include "net/class_export.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bear
+{
+  namespace net
+  {
+    class message;
+
+    /**
+     * \brief The message_encoder builds the frames sent through a connection.
+     *
+     * Each frame is made of its length, the identifier of the type of the
+     * message and the binary representation of the message. The identifiers
+     * are small integers given to the types of the messages the first time
+     * they are sent through the connection. A frame of type
+     * type_declaration, associating the identifier with the name of the
+     * message, is inserted before the first message of each type. The
+     * identifiers below first_message_type are reserved for the frames
+     * controlling the connection.
+     *
+     * The frames are kept in a buffer until they are passed to the
+     * connection, such that several messages can be sent at once.
+     *
+     * \author Julien Jorge
+     */
+    class NET_EXPORT message_encoder
+    {
+    public:
+      /** \brief The identifier of the frames declaring the identifier of a
+          type of message. */
+      static const std::size_t type_declaration;
+
+      /** \brief The identifier of the frames asking the peer for a pong
+          frame with the same content. */
+      static const std::size_t type_ping;
+
+      /** \brief The identifier of the frames answering a ping frame. */
+      static const std::size_t type_pong;
+
+      /** \brief The first identifier given to the types of the messages. */
+      static const std::size_t first_message_type;
+
+    public:
+      message_encoder();
+
+      void push( const message& m );
+      void push
+      ( const std::string& name, const std::vector<char>& payload );
+
+      bool empty() const;
+      void swap_frames( std::vector<char>& frames );
+
+      static void encode( const message& m, std::vector<char>& payload );
+      static void append_frame
+      ( std::vector<char>& output, std::size_t type, const char* payload,
+        std::size_t size );
+
+    private:
+      std::size_t get_type_id( const std::string& name );
+      void push_frame
+      ( std::size_t type, const char* payload, std::size_t size );
+
+    private:
+      /** \brief The identifiers of the types of the messages already sent. */
+      std::map<std::string, std::size_t> m_types;
+
+      /** \brief The frames not sent yet. */
+      std::vector<char> m_frames;
+
+      /** \brief A buffer for the payload of the messages. */
+      std::vector<char> m_payload;
+
+    }; // class message_encoder
+
+  } // namespace net
+} // namespace bear
+
+#endif // __NET_MESSAGE_ENCODER_HPP__
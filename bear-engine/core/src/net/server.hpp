@@ -15,28 +15,47 @@
 #define __NET_SERVER_HPP__
 
 #include "net/class_export.hpp"
+#include "net/connection_statistics.hpp"
+#include "net/message_encoder.hpp"
 
 #include <list>
+#include <vector>
 #include <claw/non_copyable.hpp>
-#include <claw/socket_server.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/signals2.hpp>
 
 namespace bear
 {
   namespace net
   {
+    class connection;
+    class io_thread;
+    class listener;
     class message;
 
     /**
      * \brief A server is an object that can dispatch messages to clients.
+     *
+     * The connections are accepted and the messages are sent by the thread of
+     * an io_thread, thus the methods of the server never wait for the
+     * network.
+     *
      * \author Julien Jorge
      */
     class NET_EXPORT server:
       private claw::pattern::non_copyable
     {
     private:
-      /** \brief The type of a clients connected to this server. */
-      typedef claw::net::socket_stream client_type;
+      /** \brief A client connected to this server. */
+      struct client_type
+      {
+        /** \brief The connection through which the messages are sent. */
+        boost::shared_ptr<connection> peer;
+
+        /** \brief The frames of the messages not sent yet. */
+        message_encoder encoder;
+
+      }; // struct client_type
 
       /** \brief The type of a pointer on a client connected to this server. */
       typedef client_type* client_pointer;
@@ -45,28 +64,29 @@ namespace bear
       typedef std::list<client_pointer> client_list;
 
     public:
-      server( unsigned int port, int client_read_time_limit = 0 );
+      server( io_thread& io, unsigned int port );
       ~server();
 
       std::size_t get_connection_count() const;
+      connection_statistics get_statistics( std::size_t client_id ) const;
 
       void dispatch_message( const message& m );
       void send_message( std::size_t client_id, const message& m );
+      void flush();
 
       boost::signals2::signal<void (std::size_t)> on_new_client;
 
       void check_for_new_clients();
 
     private:
-      /** \brief This is the socket in which the messages are dispatched and
-          from which the new clients are taken. */
-      claw::net::socket_server m_server;
+      /** \brief This is the socket from which the new clients are taken. */
+      boost::shared_ptr<listener> m_listener;
 
       /** \brief Those are the clients to which the messages are dispatched. */
       client_list m_clients;
 
-      /** \brief How long do we wait when asking a client for its content. */
-      int m_client_read_time_limit;
+      /** \brief The binary representation of the message being sent. */
+      std::vector<char> m_payload;
 
     }; // class server
 
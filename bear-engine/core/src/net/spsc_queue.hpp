@@ -0,0 +1,84 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A lock-free queue between one producer thread and one consumer
+ *        thread.
+ * \author Julien Jorge
+ */
+#ifndef __NET_SPSC_QUEUE_HPP__
+#define __NET_SPSC_QUEUE_HPP__
+
+#include <claw/non_copyable.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace bear
+{
+  namespace net
+  {
+    /**
+     * \brief A lock-free queue between one producer thread and one consumer
+     *        thread.
+     *
+     * The queue is a linked list whose first node is a sentinel owned by the
+     * consumer. The producer only changes the link of the last node, thus the
+     * threads never wait for each other. The size of the queue is not bounded.
+     *
+     * push() must always be called from the same thread, and pop() from a
+     * single other thread.
+     *
+     * \author Julien Jorge
+     */
+    template<typename T>
+    class spsc_queue:
+      private claw::pattern::non_copyable
+    {
+    private:
+      /** \brief A node of the list. */
+      struct node
+      {
+        /** \brief The value stored in the node. */
+        T value;
+
+        /** \brief The next node in the list. */
+        std::atomic<node*> next;
+
+      }; // struct node
+
+    public:
+      spsc_queue();
+      ~spsc_queue();
+
+      void push( const T& v );
+      bool pop( T& v );
+
+      std::size_t size() const;
+
+    private:
+      /** \brief The sentinel node, before the first value of the queue. It is
+          accessed by the consumer only. */
+      node* m_head;
+
+      /** \brief The last node of the list. It is accessed by the producer
+          only. */
+      node* m_tail;
+
+      /** \brief The number of values in the queue. */
+      std::atomic<std::size_t> m_size;
+
+    }; // class spsc_queue
+
+  } // namespace net
+} // namespace bear
+
+#include "net/impl/spsc_queue.tpp"
+
+#endif // __NET_SPSC_QUEUE_HPP__
@@ -16,10 +16,10 @@
 #define __TEXT_INTERFACE_BASE_EXPORTABLE_HPP__
 
 #include "text_interface/method_caller_implement.hpp"
+#include "text_interface/symbol_table.hpp"
 
 #include <vector>
 #include <string>
-#include <map>
 
 #include <typeinfo>
 #include <iostream>
@@ -31,17 +31,12 @@
  */
 #define TEXT_INTERFACE_DECLARE_METHOD_LIST_BASE                         \
   protected:                                                            \
-  typedef                                                               \
-  std::map                                                              \
-  <std::string, bear::text_interface::method_caller const*>                \
-  method_list_data_type;                                                \
-                                                                        \
   static bear::text_interface::base_exportable::method_list s_method_list; \
                                                                         \
   static void self_methods_set                                          \
   ( const std::string& name,                                            \
     bear::text_interface::method_caller const* m )                        \
-  { s_method_list.data[name] = m; }                                     \
+  { s_method_list.set( name, m ); }                                     \
                                                                         \
 private:                                                                \
   virtual bear::text_interface::base_exportable::method_list const*     \
@@ -68,7 +63,7 @@ protected:                                                                \
     if ( s_method_list.parent == NULL )                                 \
       {                                                                 \
         parent_class::init_method_list();                               \
-        s_method_list.parent = &parent_class::s_method_list;            \
+        s_method_list.inherit( parent_class::s_method_list );           \
         export_func();                                                  \
       }                                                                 \
   }
@@ -84,7 +79,9 @@ namespace bear
      *        call methods from a text_interface file.
      *
      * Those classes contain a static table of the methods to call, associated
-     * with their names.
+     * with the symbols of their names. The table of a class is built once, from
+     * the table of its parent class, and includes the methods of all its
+     * ancestors.
      *
      * \author Julien Jorge.
      */
@@ -95,18 +92,36 @@ namespace bear
       struct method_list
       {
       public:
+        /** \brief A method caller associated with the symbol of the name of
+            the method. */
+        typedef
+        std::pair<symbol_table::symbol_type, method_caller const*> entry_type;
+
         /** \brief The type of the container where the method callers are
-            stored. */
-        typedef std::map<std::string, method_caller const*> list_type;
+            stored, sorted by symbol. */
+        typedef std::vector<entry_type> list_type;
+
+        /** \brief Compare the symbol of an entry with a given symbol. */
+        struct symbol_less
+        {
+          bool operator()
+          ( const entry_type& e, symbol_table::symbol_type s ) const;
+        }; // struct symbol_less
 
+      public:
         method_list();
 
+        void inherit( const method_list& p );
+        void set( const std::string& name, method_caller const* m );
+        method_caller const* find( symbol_table::symbol_type s ) const;
+
       public:
         /** \brief The list of the parent class. Multiple inheritance is not
             allowed yet. */
         method_list const* parent;
 
-        /** \brief The callers of the methods. */
+        /** \brief The callers of the methods of the class and of its
+            ancestors. */
         list_type data;
 
       }; // struct method_list
@@ -114,6 +129,10 @@ namespace bear
     private:
       TEXT_INTERFACE_DECLARE_METHOD_LIST_BASE
 
+    public:
+      /** \brief The type of the symbols identifying the methods. */
+      typedef symbol_table::symbol_type symbol_type;
+
     public:
       /** \remark The desctructor must be virtual so we can use dynamic_cast in
           explicit_method_caller. */
@@ -127,11 +146,22 @@ namespace bear
       void execute( const std::string& n, const std::vector<std::string>& args,
                     const argument_converter& c );
 
+      void execute
+      ( symbol_type s,
+        const std::vector<std::string>& args = std::vector<std::string>() );
+      void execute( symbol_type s, const std::vector<std::string>& args,
+                    const argument_converter& c );
+
+      bound_method_call* bind
+      ( const std::string& n, const std::vector<std::string>& args,
+        const argument_converter& c ) const;
+
     protected:
       static void init_method_list();
 
     private:
       method_caller const* find_function( const std::string& n ) const;
+      method_caller const* find_function( symbol_type s ) const;
 
     }; // class base_exportable
 
@@ -0,0 +1,94 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An argument of a bound method call.
+ * \author Julien Jorge.
+ */
+#ifndef __TEXT_INTERFACE_BOUND_ARGUMENT_HPP__
+#define __TEXT_INTERFACE_BOUND_ARGUMENT_HPP__
+
+#include "text_interface/argument_converter.hpp"
+
+#include <string>
+
+namespace bear
+{
+  namespace text_interface
+  {
+    /**
+     * \brief An argument of a bound method call.
+     *
+     * When the conversion of the argument does not depend on the argument
+     * converter, the value is converted once in the constructor. Otherwise,
+     * the string representation is kept and converted at each call, since the
+     * result may change with the context (for example an actor of a script).
+     *
+     * \author Julien Jorge.
+     */
+    template
+    < typename T, bool ContextFree = string_to_arg<T>::context_free >
+    class bound_argument;
+
+    /**
+     * \brief Specialisation for the arguments whose conversion does not depend
+     *        on the context.
+     * \author Julien Jorge.
+     */
+    template<typename T>
+    class bound_argument<T, true>
+    {
+    public:
+      /** \brief The type of the converted value. */
+      typedef
+      typename argument_converter::conversion_result<T>::result_type
+      value_type;
+
+    public:
+      bound_argument( const argument_converter& c, const std::string& arg );
+
+      const value_type& get( const argument_converter& c ) const;
+
+    private:
+      /** \brief The converted value. */
+      const value_type m_value;
+
+    }; // class bound_argument [true]
+
+    /**
+     * \brief Specialisation for the arguments whose conversion depends on the
+     *        context.
+     * \author Julien Jorge.
+     */
+    template<typename T>
+    class bound_argument<T, false>
+    {
+    public:
+      /** \brief The type of the converted value. */
+      typedef
+      typename argument_converter::conversion_result<T>::result_type
+      value_type;
+
+    public:
+      bound_argument( const argument_converter& c, const std::string& arg );
+
+      value_type get( const argument_converter& c ) const;
+
+    private:
+      /** \brief The string representation of the value. */
+      const std::string m_argument;
+
+    }; // class bound_argument [false]
+
+  } // namespace text_interface
+} // namespace bear
+
+#include "text_interface/impl/bound_argument.tpp"
+
+#endif // __TEXT_INTERFACE_BOUND_ARGUMENT_HPP__
@@ -0,0 +1,55 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Base class for a call to a method whose arguments have been prepared
+ *        in advance.
+ * \author Julien Jorge.
+ */
+#ifndef __TEXT_INTERFACE_BOUND_METHOD_CALL_HPP__
+#define __TEXT_INTERFACE_BOUND_METHOD_CALL_HPP__
+
+namespace bear
+{
+  namespace text_interface
+  {
+    class base_exportable;
+    class argument_converter;
+
+    /**
+     * \brief Base class for a call to a method whose arguments have been
+     *        prepared in advance.
+     *
+     * The instances are created by method_caller::bind(). The arguments that
+     * do not depend on the argument converter are converted when the call is
+     * bound, thus executing the call does not parse them again.
+     *
+     * \author Julien Jorge.
+     */
+    class bound_method_call
+    {
+    public:
+      /** \brief Destructor. */
+      virtual ~bound_method_call() { }
+
+      /**
+       * \brief Execute the method on a given instance.
+       * \param self The instance on which the method is called.
+       * \param c The converter used to convert the arguments that could not be
+       *        converted when the call was bound.
+       */
+      virtual void execute
+      ( base_exportable* self, const argument_converter& c ) const = 0;
+
+    }; // class bound_method_call
+
+  } // namespace text_interface
+} // namespace bear
+
+#endif // __TEXT_INTERFACE_BOUND_METHOD_CALL_HPP__
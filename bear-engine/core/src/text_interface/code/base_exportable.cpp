@@ -18,6 +18,8 @@
 
 #include <claw/logger.hpp>
 
+#include <algorithm>
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Constructor.
@@ -28,6 +30,70 @@ bear::text_interface::base_exportable::method_list::method_list()
   // nothing to do
 } // base_exportable::method_list::method_list()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Initialize the list with the methods of the parent class.
+ * \param p The list of the parent class.
+ */
+void bear::text_interface::base_exportable::method_list::inherit
+( const method_list& p )
+{
+  parent = &p;
+  data = p.data;
+} // base_exportable::method_list::inherit()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the caller of a method, replacing the one of the parent class, if
+ *        any.
+ * \param name The name of the method.
+ * \param m The caller of the method.
+ */
+void bear::text_interface::base_exportable::method_list::set
+( const std::string& name, method_caller const* m )
+{
+  const symbol_table::symbol_type s( symbol_table::get_symbol(name) );
+  const list_type::iterator it
+    ( std::lower_bound( data.begin(), data.end(), s, symbol_less() ) );
+
+  if ( (it != data.end()) && (it->first == s) )
+    it->second = m;
+  else
+    data.insert( it, entry_type(s, m) );
+} // base_exportable::method_list::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the caller of a method.
+ * \param s The symbol of the name of the method.
+ * \return NULL if there is no method with this name.
+ */
+bear::text_interface::method_caller const*
+bear::text_interface::base_exportable::method_list::find
+( symbol_table::symbol_type s ) const
+{
+  const list_type::const_iterator it
+    ( std::lower_bound( data.begin(), data.end(), s, symbol_less() ) );
+
+  if ( (it != data.end()) && (it->first == s) )
+    return it->second;
+  else
+    return NULL;
+} // base_exportable::method_list::find()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compare the symbol of an entry with a given symbol.
+ * \param e The entry.
+ * \param s The symbol.
+ * \return e.first < s
+ */
+bool bear::text_interface::base_exportable::method_list::symbol_less::operator()
+  ( const entry_type& e, symbol_table::symbol_type s ) const
+{
+  return e.first < s;
+} // base_exportable::method_list::symbol_less::operator()()
+
 
 
 
@@ -105,47 +171,98 @@ void bear::text_interface::base_exportable::execute
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Execute a method from the class from its name and its arguments as
- *        passed as strings.
+ * \brief Execute a method from the class from the symbol of its name and its
+ *        arguments as passed as strings.
+ * \param s The symbol of the name of the method to call, as returned by
+ *        symbol_table::get_symbol().
+ * \param args The string representation of the value of the arguments of the
+ *        method.
+ * \remark The call is make without any context, which mean that some argument
+ *         conversion may not work.
+ */
+void bear::text_interface::base_exportable::execute
+( symbol_type s, const std::vector<std::string>& args )
+{
+  method_caller const* f = find_function(s);
+
+  if (f!=NULL)
+    f->execute(this, args, argument_converter());
+} // base_exportable::execute()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute a method from the class from the symbol of its name and its
+ *        arguments as passed as strings.
+ * \param s The symbol of the name of the method to call, as returned by
+ *        symbol_table::get_symbol().
+ * \param args The string representation of the value of the arguments of the
+ *        method.
+ * \param c The argument_converter used to convert the arguments.
+ */
+void bear::text_interface::base_exportable::execute
+( symbol_type s, const std::vector<std::string>& args,
+  const argument_converter& c )
+{
+  method_caller const* f = find_function(s);
+
+  if (f!=NULL)
+    f->execute(this, args, c);
+} // base_exportable::execute()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Prepare a call to a method from the class from its name and its
+ *        arguments as passed as strings, to execute it later without looking
+ *        for the method nor parsing the arguments again.
  * \param n The name of the method to call.
  * \param args The string representation of the value of the arguments of the
  *        method.
- * \param context The context in which these methods are called.
+ * \param c The argument_converter used to convert the arguments.
+ * \return The call, to be deleted by the caller, or NULL if there is no method
+ *         named \a n.
+ */
+bear::text_interface::bound_method_call*
+bear::text_interface::base_exportable::bind
+( const std::string& n, const std::vector<std::string>& args,
+  const argument_converter& c ) const
+{
+  method_caller const* f = find_function(n);
+
+  if (f!=NULL)
+    return f->bind(args, c);
+  else
+    return NULL;
+} // base_exportable::bind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the caller of a method from its name.
+ * \param n The name of the method.
+ * \return NULL if there is no method with this name.
  */
 bear::text_interface::method_caller const*
 bear::text_interface::base_exportable::find_function
 ( const std::string& n ) const
 {
-  method_caller const* result=NULL;
-
-  // Get the callers from the lowest class in the hierarchy.
-  const method_list* m( get_method_list() );
-  method_list_data_type::const_iterator it(m->data.find(n));
-  bool stop(false);
-
-  while( !stop ) // there is at least the null-terminating entry in m.data
-    if ( it == m->data.end() )
-      {
-        // We are at the end of the caller tables. We will now look in the
-        // table of the parent class, if there is such a class.
-        if ( m->parent != NULL )
-          {
-            m = m->parent;
-            it = m->data.find(n);
-          }
-        else
-          {
-            claw::logger << claw::log_warning << "Method '" << n
-                         << "' not found." << std::endl;
-            stop = true;
-          }
-      }
-    else
-      {
-        // We found the method. Execute.
-        stop = true;
-        result = it->second;
-      }
+  return find_function( symbol_table::get_symbol(n) );
+} // base_exportable::find_function()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the caller of a method from the symbol of its name.
+ * \param s The symbol of the name of the method.
+ * \return NULL if there is no method with this name.
+ */
+bear::text_interface::method_caller const*
+bear::text_interface::base_exportable::find_function( symbol_type s ) const
+{
+  // The list of the lowest class in the hierarchy contains the callers of all
+  // the classes.
+  method_caller const* result( get_method_list()->find(s) );
+
+  if ( result == NULL )
+    claw::logger << claw::log_warning << "Method '"
+                 << symbol_table::get_name(s) << "' not found." << std::endl;
 
   return result;
 } // base_exportable::find_function()
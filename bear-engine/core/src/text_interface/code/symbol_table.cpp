@@ -0,0 +1,77 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::text_interface::symbol_table class.
+ * \author Julien Jorge.
+ */
+#include "text_interface/symbol_table.hpp"
+
+#include <claw/assert.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the symbol associated with a name, creating it if needed.
+ * \param name The name for which we want the symbol.
+ */
+bear::text_interface::symbol_table::symbol_type
+bear::text_interface::symbol_table::get_symbol( const std::string& name )
+{
+  symbol_map& symbols( get_symbols() );
+  const symbol_map::const_iterator it( symbols.find(name) );
+
+  if ( it != symbols.end() )
+    return it->second;
+
+  std::vector<const std::string*>& names( get_names() );
+  const symbol_type result( names.size() );
+
+  // The keys of an unordered_map are not moved when the table grows.
+  names.push_back( &symbols.insert( symbol_map::value_type(name, result) )
+                   .first->first );
+
+  return result;
+} // symbol_table::get_symbol()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name associated with a symbol.
+ * \param s The symbol for which we want the name.
+ */
+const std::string&
+bear::text_interface::symbol_table::get_name( symbol_type s )
+{
+  CLAW_PRECOND( s < get_names().size() );
+
+  return *get_names()[s];
+} // symbol_table::get_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the symbols, by name.
+ * \remark The map is a local static variable so it can be used during the
+ *         initialization of the static variables of the other modules.
+ */
+bear::text_interface::symbol_table::symbol_map&
+bear::text_interface::symbol_table::get_symbols()
+{
+  static symbol_map result;
+  return result;
+} // symbol_table::get_symbols()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the names, indexed by symbol.
+ */
+std::vector<const std::string*>&
+bear::text_interface::symbol_table::get_names()
+{
+  static std::vector<const std::string*> result;
+  return result;
+} // symbol_table::get_names()
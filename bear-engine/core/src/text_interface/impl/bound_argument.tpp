@@ -0,0 +1,67 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::text_interface::bound_argument class.
+ * \author Julien Jorge.
+ */
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param c The converter used to convert the argument.
+ * \param arg The string representation of the value of the argument.
+ */
+template<typename T>
+bear::text_interface::bound_argument<T, true>::bound_argument
+( const argument_converter& c, const std::string& arg )
+  : m_value( c.template convert_argument<T>(arg) )
+{
+
+} // bound_argument::bound_argument()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the value of the argument.
+ * \param c (ignored) The converter used to convert the argument.
+ */
+template<typename T>
+const typename bear::text_interface::bound_argument<T, true>::value_type&
+bear::text_interface::bound_argument<T, true>::get
+( const argument_converter& c ) const
+{
+  return m_value;
+} // bound_argument::get()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param c (ignored) The converter used to convert the argument.
+ * \param arg The string representation of the value of the argument.
+ */
+template<typename T>
+bear::text_interface::bound_argument<T, false>::bound_argument
+( const argument_converter& c, const std::string& arg )
+  : m_argument(arg)
+{
+
+} // bound_argument::bound_argument()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the value of the argument.
+ * \param c The converter used to convert the argument.
+ */
+template<typename T>
+typename bear::text_interface::bound_argument<T, false>::value_type
+bear::text_interface::bound_argument<T, false>::get
+( const argument_converter& c ) const
+{
+  return c.template convert_argument<T>(m_argument);
+} // bound_argument::get()
@@ -61,6 +61,44 @@ void bear::text_interface::method_caller_implement_0
   (self.*member)();
 } // method_caller_implement_0::caller_type::explicit_execute()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Prepare a call to the method with given arguments.
+ * \param args The string representation of the value of the arguments passed to
+ *        the method.
+ * \param c The converter used to convert the arguments.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R,
+  R (ParentClass::*Member)() >
+bear::text_interface::bound_method_call*
+bear::text_interface::method_caller_implement_0
+<SelfClass, ParentClass, R, Member>::caller_type::bind
+( const std::vector<std::string>& args, const argument_converter& c ) const
+{
+  CLAW_PRECOND( args.size() == 0 );
+
+  return new bound_call;
+} // method_caller_implement_0::caller_type::bind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute the method on a given instance.
+ * \param self The instance on which the method is called.
+ * \param c The converter used to convert the arguments that could not be
+ *        converted when the call was bound.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R,
+  R (ParentClass::*Member)() >
+void bear::text_interface::method_caller_implement_0
+<SelfClass, ParentClass, R, Member>::bound_call::explicit_execute
+( SelfClass& self, const argument_converter& c ) const
+{
+  const mem_fun_type member(Member);
+  (self.*member)();
+} // method_caller_implement_0::bound_call::explicit_execute()
+
 
 
 
@@ -111,6 +149,63 @@ bear::text_interface::method_caller_implement_1
   // nothing to do
 } // method_caller_implement_1::caller_type::caller_type()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Prepare a call to the method with given arguments.
+ * \param args The string representation of the value of the arguments passed to
+ *        the method.
+ * \param c The converter used to convert the arguments.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  R (ParentClass::*Member)(A0) >
+bear::text_interface::bound_method_call*
+bear::text_interface::method_caller_implement_1
+<SelfClass, ParentClass, R, A0, Member>::caller_type::bind
+( const std::vector<std::string>& args, const argument_converter& c ) const
+{
+  CLAW_PRECOND( args.size() == 1 );
+
+  return new bound_call( args, c );
+} // method_caller_implement_1::caller_type::bind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param args The string representation of the value of the arguments passed to
+ *        the method.
+ * \param c The converter used to convert the arguments.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  R (ParentClass::*Member)(A0) >
+bear::text_interface::method_caller_implement_1
+<SelfClass, ParentClass, R, A0, Member>::bound_call::bound_call
+( const std::vector<std::string>& args, const argument_converter& c )
+  : m_arg0(c, args[0])
+{
+
+} // method_caller_implement_1::bound_call::bound_call()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute the method on a given instance.
+ * \param self The instance on which the method is called.
+ * \param c The converter used to convert the arguments that could not be
+ *        converted when the call was bound.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  R (ParentClass::*Member)(A0) >
+void bear::text_interface::method_caller_implement_1
+<SelfClass, ParentClass, R, A0, Member>::bound_call::explicit_execute
+( SelfClass& self, const argument_converter& c ) const
+{
+  const mem_fun_type member(Member);
+  (self.*member)
+    ( m_arg0.get(c) );
+} // method_caller_implement_1::bound_call::explicit_execute()
+
 
 
 
@@ -162,6 +257,65 @@ void bear::text_interface::method_caller_implement_2
       c.template convert_argument<A1>(args[1]) );
 } // method_caller_implement_2::caller_type::explicit_execute()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Prepare a call to the method with given arguments.
+ * \param args The string representation of the value of the arguments passed to
+ *        the method.
+ * \param c The converter used to convert the arguments.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  typename A1, R (ParentClass::*Member)(A0, A1) >
+bear::text_interface::bound_method_call*
+bear::text_interface::method_caller_implement_2
+<SelfClass, ParentClass, R, A0, A1, Member>::caller_type::bind
+( const std::vector<std::string>& args, const argument_converter& c ) const
+{
+  CLAW_PRECOND( args.size() == 2 );
+
+  return new bound_call( args, c );
+} // method_caller_implement_2::caller_type::bind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param args The string representation of the value of the arguments passed to
+ *        the method.
+ * \param c The converter used to convert the arguments.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  typename A1, R (ParentClass::*Member)(A0, A1) >
+bear::text_interface::method_caller_implement_2
+<SelfClass, ParentClass, R, A0, A1, Member>::bound_call::bound_call
+( const std::vector<std::string>& args, const argument_converter& c )
+  : m_arg0(c, args[0]),
+    m_arg1(c, args[1])
+{
+
+} // method_caller_implement_2::bound_call::bound_call()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute the method on a given instance.
+ * \param self The instance on which the method is called.
+ * \param c The converter used to convert the arguments that could not be
+ *        converted when the call was bound.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  typename A1, R (ParentClass::*Member)(A0, A1) >
+void bear::text_interface::method_caller_implement_2
+<SelfClass, ParentClass, R, A0, A1, Member>::bound_call::explicit_execute
+( SelfClass& self, const argument_converter& c ) const
+{
+  const mem_fun_type member(Member);
+  (self.*member)
+    ( m_arg0.get(c),
+      m_arg1.get(c) );
+} // method_caller_implement_2::bound_call::explicit_execute()
+
 
 
 
@@ -213,3 +367,64 @@ void bear::text_interface::method_caller_implement_3
       c.template convert_argument<A1>(args[1]),
       c.template convert_argument<A2>(args[2]) );
 } // method_caller_implement_3::caller_type::explicit_execute()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Prepare a call to the method with given arguments.
+ * \param args The string representation of the value of the arguments passed to
+ *        the method.
+ * \param c The converter used to convert the arguments.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  typename A1, typename A2, R (ParentClass::*Member)(A0, A1, A2) >
+bear::text_interface::bound_method_call*
+bear::text_interface::method_caller_implement_3
+<SelfClass, ParentClass, R, A0, A1, A2, Member>::caller_type::bind
+( const std::vector<std::string>& args, const argument_converter& c ) const
+{
+  CLAW_PRECOND( args.size() == 3 );
+
+  return new bound_call( args, c );
+} // method_caller_implement_3::caller_type::bind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param args The string representation of the value of the arguments passed to
+ *        the method.
+ * \param c The converter used to convert the arguments.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  typename A1, typename A2, R (ParentClass::*Member)(A0, A1, A2) >
+bear::text_interface::method_caller_implement_3
+<SelfClass, ParentClass, R, A0, A1, A2, Member>::bound_call::bound_call
+( const std::vector<std::string>& args, const argument_converter& c )
+  : m_arg0(c, args[0]),
+    m_arg1(c, args[1]),
+    m_arg2(c, args[2])
+{
+
+} // method_caller_implement_3::bound_call::bound_call()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute the method on a given instance.
+ * \param self The instance on which the method is called.
+ * \param c The converter used to convert the arguments that could not be
+ *        converted when the call was bound.
+ */
+template
+< typename SelfClass, typename ParentClass, typename R, typename A0,
+  typename A1, typename A2, R (ParentClass::*Member)(A0, A1, A2) >
+void bear::text_interface::method_caller_implement_3
+<SelfClass, ParentClass, R, A0, A1, A2, Member>::bound_call::explicit_execute
+( SelfClass& self, const argument_converter& c ) const
+{
+  const mem_fun_type member(Member);
+  (self.*member)
+    ( m_arg0.get(c),
+      m_arg1.get(c),
+      m_arg2.get(c) );
+} // method_caller_implement_3::bound_call::explicit_execute()
@@ -0,0 +1,36 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::text_interface::typed_bound_method_call
+ *        class.
+ * \author Julien Jorge.
+ */
+
+#include <claw/logger.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Execute the method on a given instance.
+ * \param self The instance on which the method is called.
+ * \param c The converter used to convert the arguments that could not be
+ *        converted when the call was bound.
+ */
+template<typename SelfClass>
+void bear::text_interface::typed_bound_method_call<SelfClass>::execute
+( base_exportable* self, const argument_converter& c ) const
+{
+  SelfClass* s = dynamic_cast<SelfClass*>(self);
+
+  if ( s!=NULL )
+    explicit_execute(*s, c);
+  else
+    claw::logger << claw::log_warning << "Failed to cast base_exportable."
+                 << std::endl;
+} // typed_bound_method_call::execute()
@@ -24,6 +24,7 @@ namespace bear
   {
     class base_exportable;
     class argument_converter;
+    class bound_method_call;
 
     /**
      * \brief Base class for calling a method of an instance given the string
@@ -45,6 +46,19 @@ namespace bear
       ( base_exportable* self, const std::vector<std::string>& args,
         const argument_converter& c ) const = 0;
 
+      /**
+       * \brief Prepare a call to the method with given arguments. The
+       *        arguments whose conversion does not depend on the converter are
+       *        converted once here.
+       * \param args The string representation of the value of the arguments
+       *        passed to the method.
+       * \param c The converter used to convert the arguments.
+       * \return A call to delete by the caller.
+       */
+      virtual bound_method_call* bind
+      ( const std::vector<std::string>& args,
+        const argument_converter& c ) const = 0;
+
     }; // class method_caller
 
   } // namespace text_interface
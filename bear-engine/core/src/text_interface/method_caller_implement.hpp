@@ -15,6 +15,8 @@
 #ifndef __TEXT_INTERFACE_METHOD_CALLER_IMPLEMENT_HPP__
 #define __TEXT_INTERFACE_METHOD_CALLER_IMPLEMENT_HPP__
 
+#include "text_interface/bound_argument.hpp"
+#include "text_interface/typed_bound_method_call.hpp"
 #include "text_interface/typed_method_caller.hpp"
 
 namespace bear
@@ -82,6 +84,14 @@ namespace bear
     typedef R (ParentClass::*mem_fun_type)();
 
   public:
+    class bound_call:
+      public typed_bound_method_call<SelfClass>
+    {
+    private:
+      void explicit_execute
+      ( SelfClass& self, const argument_converter& c ) const;
+    }; // class bound_call
+
     class caller_type:
       public typed_method_caller<SelfClass>
     {
@@ -92,6 +102,10 @@ namespace bear
       void explicit_execute
       ( SelfClass& self, const std::vector<std::string>& args,
         const argument_converter& c ) const;
+
+      bound_method_call* bind
+      ( const std::vector<std::string>& args,
+        const argument_converter& c ) const;
     }; // class caller_type;
 
   public:
@@ -119,6 +133,22 @@ namespace bear
       typedef R (ParentClass::*mem_fun_type)(A0);
 
     public:
+      class bound_call:
+        public typed_bound_method_call<SelfClass>
+      {
+      public:
+        bound_call
+        ( const std::vector<std::string>& args, const argument_converter& c );
+
+      private:
+        void explicit_execute
+        ( SelfClass& self, const argument_converter& c ) const;
+
+      private:
+        /** \brief The argument 0 of the method. */
+        const bound_argument<A0> m_arg0;
+      }; // class bound_call
+
       class caller_type:
         public typed_method_caller<SelfClass>
       {
@@ -129,6 +159,10 @@ namespace bear
         void explicit_execute
         ( SelfClass& self, const std::vector<std::string>& args,
           const argument_converter& c ) const;
+
+        bound_method_call* bind
+        ( const std::vector<std::string>& args,
+          const argument_converter& c ) const;
       }; // class caller_type
 
     public:
@@ -156,6 +190,25 @@ namespace bear
       typedef R (ParentClass::*mem_fun_type)(A0, A1);
 
     public:
+      class bound_call:
+        public typed_bound_method_call<SelfClass>
+      {
+      public:
+        bound_call
+        ( const std::vector<std::string>& args, const argument_converter& c );
+
+      private:
+        void explicit_execute
+        ( SelfClass& self, const argument_converter& c ) const;
+
+      private:
+        /** \brief The argument 0 of the method. */
+        const bound_argument<A0> m_arg0;
+
+        /** \brief The argument 1 of the method. */
+        const bound_argument<A1> m_arg1;
+      }; // class bound_call
+
       class caller_type:
         public typed_method_caller<SelfClass>
       {
@@ -166,6 +219,10 @@ namespace bear
         void explicit_execute
         ( SelfClass& self, const std::vector<std::string>& args,
           const argument_converter& c ) const;
+
+        bound_method_call* bind
+        ( const std::vector<std::string>& args,
+          const argument_converter& c ) const;
       }; // class caller_type
 
     public:
@@ -193,6 +250,28 @@ namespace bear
       typedef R (ParentClass::*mem_fun_type)(A0, A1, A2);
 
     public:
+      class bound_call:
+        public typed_bound_method_call<SelfClass>
+      {
+      public:
+        bound_call
+        ( const std::vector<std::string>& args, const argument_converter& c );
+
+      private:
+        void explicit_execute
+        ( SelfClass& self, const argument_converter& c ) const;
+
+      private:
+        /** \brief The argument 0 of the method. */
+        const bound_argument<A0> m_arg0;
+
+        /** \brief The argument 1 of the method. */
+        const bound_argument<A1> m_arg1;
+
+        /** \brief The argument 2 of the method. */
+        const bound_argument<A2> m_arg2;
+      }; // class bound_call
+
       class caller_type:
         public typed_method_caller<SelfClass>
       {
@@ -203,6 +282,10 @@ namespace bear
         void explicit_execute
         ( SelfClass& self, const std::vector<std::string>& args,
           const argument_converter& c ) const;
+
+        bound_method_call* bind
+        ( const std::vector<std::string>& args,
+          const argument_converter& c ) const;
       }; // class caller_type
 
     public:
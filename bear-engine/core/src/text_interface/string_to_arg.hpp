@@ -44,6 +44,10 @@ namespace bear
       /** The type of the result value obtained with this converter. */
       typedef typename get_inner_type<T>::type result_type;
 
+      /** Tell if the result of the conversion does not depend on the
+          argument converter. */
+      static const bool context_free = true;
+
       static result_type convert_argument
       ( const argument_converter& c, const std::string& arg );
     }; // struct string_to_arg_helper [true]
@@ -55,6 +59,10 @@ namespace bear
       /** The type of the result value obtained with this converter. */
       typedef T result_type;
 
+      /** Tell if the result of the conversion does not depend on the
+          argument converter. */
+      static const bool context_free = false;
+
       static T convert_argument
       ( const argument_converter& c, const std::string& arg );
     }; // struct string_to_arg_helper [false]
@@ -66,6 +74,10 @@ namespace bear
       /** The type of the result value obtained with this converter. */
       typedef T& result_type;
 
+      /** Tell if the result of the conversion does not depend on the
+          argument converter. */
+      static const bool context_free = false;
+
       static result_type convert_argument
       ( const argument_converter& c, const std::string& arg );
     }; // struct string_to_arg_helper [false]
@@ -77,6 +89,10 @@ namespace bear
       /** The type of the result value obtained with this converter. */
       typedef const T& result_type;
 
+      /** Tell if the result of the conversion does not depend on the
+          argument converter. */
+      static const bool context_free = false;
+
       static result_type convert_argument
       ( const argument_converter& c, const std::string& arg );
     }; // struct string_to_arg_helper [false]
@@ -127,6 +143,10 @@ namespace bear
       /** The type of the result value obtained with this converter. */
       typedef std::string result_type;
 
+      /** Tell if the result of the conversion does not depend on the
+          argument converter. */
+      static const bool context_free = true;
+
       static std::string convert_argument
       ( const argument_converter& c, const std::string& arg );
     }; // struct string_to_arg [std::string]
@@ -161,6 +181,10 @@ namespace bear
     public:
       typedef Sequence result_type;
 
+      /** Tell if the result of the conversion does not depend on the
+          argument converter. */
+      static const bool context_free = true;
+
       static result_type convert_argument
       ( const argument_converter& c, const std::string& arg );
     }; // struct string_to_sequence_arg
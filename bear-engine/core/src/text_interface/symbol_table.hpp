@@ -0,0 +1,60 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The table of the names of the methods and of the classes, interned
+ *        as integers.
+ * \author Julien Jorge.
+ */
+#ifndef __TEXT_INTERFACE_SYMBOL_TABLE_HPP__
+#define __TEXT_INTERFACE_SYMBOL_TABLE_HPP__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bear
+{
+  namespace text_interface
+  {
+    /**
+     * \brief The table of the names of the methods and of the classes, interned
+     *        as integers.
+     *
+     * Each distinct name receives a symbol the first time it is seen, and
+     * keeps it until the end of the program. Thus the symbols can be computed
+     * once by the callers and compared as integers instead of strings.
+     *
+     * \author Julien Jorge.
+     */
+    class symbol_table
+    {
+    public:
+      /** \brief The type of the symbols. */
+      typedef unsigned int symbol_type;
+
+    private:
+      /** \brief The type of the map associating the names with their
+          symbols. */
+      typedef std::unordered_map<std::string, symbol_type> symbol_map;
+
+    public:
+      static symbol_type get_symbol( const std::string& name );
+      static const std::string& get_name( symbol_type s );
+
+    private:
+      static symbol_map& get_symbols();
+      static std::vector<const std::string*>& get_names();
+
+    }; // class symbol_table
+
+  } // namespace text_interface
+} // namespace bear
+
+#endif // __TEXT_INTERFACE_SYMBOL_TABLE_HPP__
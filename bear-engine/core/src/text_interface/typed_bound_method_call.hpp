@@ -0,0 +1,55 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Base class for a call to a method whose arguments have been prepared
+ *        in advance, on an instance of a given type.
+ * \author Julien Jorge.
+ */
+#ifndef __TEXT_INTERFACE_TYPED_BOUND_METHOD_CALL_HPP__
+#define __TEXT_INTERFACE_TYPED_BOUND_METHOD_CALL_HPP__
+
+#include "text_interface/bound_method_call.hpp"
+
+namespace bear
+{
+  namespace text_interface
+  {
+    /**
+     * \brief Base class for a call to a method whose arguments have been
+     *        prepared in advance. Contrary to bound_method_call, this class
+     *        cast the instance to a given type.
+     *
+     * \author Julien Jorge.
+     */
+    template<typename SelfClass>
+    class typed_bound_method_call:
+      public bound_method_call
+    {
+    public:
+      /**
+       * \brief Execute the method on a given instance.
+       * \param self The instance on which the method is called.
+       * \param c The converter used to convert the arguments that could not be
+       *        converted when the call was bound.
+       */
+      virtual void explicit_execute
+      ( SelfClass& self, const argument_converter& c ) const = 0;
+
+    private:
+      void execute( base_exportable* self, const argument_converter& c ) const;
+
+    }; // class typed_bound_method_call
+
+  } // namespace text_interface
+} // namespace bear
+
+#include "text_interface/impl/typed_bound_method_call.tpp"
+
+#endif // __TEXT_INTERFACE_TYPED_BOUND_METHOD_CALL_HPP__
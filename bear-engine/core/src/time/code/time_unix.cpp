@@ -41,3 +41,30 @@ bear::systime::milliseconds_type bear::systime::get_date_ms()
 
   return tv.tv_sec * 1000 + tv.tv_usec / 1000;
 } // get_date_ms()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop the process for a given amount of time.
+ * \param us Stop the process this number of microseconds.
+ */
+void bear::systime::sleep_us( microseconds_type us )
+{
+  struct timespec time;
+  time.tv_sec = us / 1000000;
+  time.tv_nsec = ( us % 1000000 ) * 1000;
+  nanosleep( &time, NULL );
+} // sleep_us()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the date of a monotonic clock, in microseconds. The origin of the
+ *        dates is unspecified.
+ */
+bear::systime::microseconds_type bear::systime::get_date_us()
+{
+  timespec t;
+
+  clock_gettime( CLOCK_MONOTONIC, &t );
+
+  return (microseconds_type)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+} // get_date_us()
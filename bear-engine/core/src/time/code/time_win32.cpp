@@ -37,3 +37,31 @@ bear::systime::milliseconds_type TIME_EXPORT bear::systime::get_date_ms()
 
   return (milliseconds_type)((c.QuadPart * 1000) / freq.QuadPart);
 } // get_date_ms()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Stop the process for a given amount of time.
+ * \param us Stop the process this number of microseconds. The duration is
+ *        rounded to the millisecond.
+ */
+void TIME_EXPORT bear::systime::sleep_us( microseconds_type us )
+{
+  Sleep( (DWORD)(us / 1000) );
+} // sleep_us()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the date of a monotonic clock, in microseconds. The origin of the
+ *        dates is unspecified.
+ */
+bear::systime::microseconds_type TIME_EXPORT bear::systime::get_date_us()
+{
+  LARGE_INTEGER freq, c;
+
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&c);
+
+  return (microseconds_type)
+    ( (c.QuadPart / freq.QuadPart) * 1000000
+      + ((c.QuadPart % freq.QuadPart) * 1000000) / freq.QuadPart );
+} // get_date_us()
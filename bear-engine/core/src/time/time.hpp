@@ -23,11 +23,15 @@ namespace bear
   namespace systime
   {
     typedef unsigned long milliseconds_type;
+    typedef unsigned long long microseconds_type;
     typedef unsigned long seconds_type;
 
     void TIME_EXPORT sleep( milliseconds_type ms );
     milliseconds_type TIME_EXPORT get_date_ms();
 
+    void TIME_EXPORT sleep_us( microseconds_type us );
+    microseconds_type TIME_EXPORT get_date_us();
+
     seconds_type TIME_EXPORT get_unix_time();
 
     std::string TIME_EXPORT format_time_s
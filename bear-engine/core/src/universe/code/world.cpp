@@ -23,6 +23,9 @@
 #include "universe/link/base_link.hpp"
 #include "universe/shape/rectangle.hpp"
 
+#include "debug/performance_counters.hpp"
+#include "debug/profiler_zone.hpp"
+
 #include <algorithm>
 #include <cassert>
 #include <claw/avl.hpp>
@@ -106,6 +109,8 @@ bear::universe::world::~world()
 void bear::universe::world::progress_entities
 ( const region_type& regions, time_type elapsed_time )
 {
+  BEAR_PROFILE_ZONE( "world::progress_entities" );
+
   item_list items;
   candidate_collisions potential_collision;
 
@@ -117,6 +122,8 @@ void bear::universe::world::progress_entities
     ( std::unordered_set<physical_item*>(items.begin(), items.end()).size()
       == items.size() );
 
+  BEAR_COUNTER_SET( "world/active_items", items.size() );
+
   // call progress for each interesting item
   progress_items(items, elapsed_time);
 
@@ -806,6 +813,8 @@ void bear::universe::world::list_active_items
 void bear::universe::world::detect_collision_all
 ( item_list& items, const candidate_collisions& potential_collision )
 {
+  BEAR_PROFILE_ZONE( "world::detect_collision_all" );
+
   item_list pending;
 
   for (item_list::iterator it=items.begin(); it!=items.end(); ++it)
@@ -909,8 +918,12 @@ bool bear::universe::world::process_collision
 {
   bool result(false);
 
+  BEAR_COUNTER_ADD( "world/collision_pairs_tested", 1 );
+
   if ( self.collides_with(that) )
     {
+      BEAR_COUNTER_ADD( "world/collision_pairs_resolved", 1 );
+
       result = true;
       collision_repair repair(self, that);
 
@@ -1020,6 +1033,8 @@ void bear::universe::world::search_interesting_items
 ( const region_type& regions, item_list& items,
   candidate_collisions& potential_collision ) const
 {
+  BEAR_PROFILE_ZONE( "world::search_interesting_items" );
+
   item_list::const_iterator it;
 
   // add static items of the active zone
@@ -1164,6 +1179,8 @@ void bear::universe::world::make_sorted_dependency_list
 void bear::universe::world::progress_items
 ( const item_list& items, time_type elapsed_time ) const
 {
+  BEAR_PROFILE_ZONE( "world::progress_items" );
+
   item_list::const_iterator it;
 
   for( it=items.begin(); it!=items.end(); ++it )
@@ -1179,6 +1196,8 @@ void bear::universe::world::progress_items
 void bear::universe::world::progress_physic
 ( time_type elapsed_time, const item_list& items ) const
 {
+  BEAR_PROFILE_ZONE( "world::progress_physic" );
+
   item_list::const_iterator it;
 
   apply_links(items);
@@ -1256,6 +1275,8 @@ void bear::universe::world::apply_links(const item_list& items) const
  */
 void bear::universe::world::active_region_traffic( const item_list& items )
 {
+  BEAR_PROFILE_ZONE( "world::active_region_traffic" );
+
   item_list::const_iterator it;
 
   for( it=m_last_interesting_items.begin(); it!=m_last_interesting_items.end();
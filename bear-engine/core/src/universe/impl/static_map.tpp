@@ -12,6 +12,8 @@
  * \author Julien Jorge.
  */
 
+#include "debug/performance_counters.hpp"
+
 #include <claw/assert.hpp>
 #include <claw/logger.hpp>
 #include <limits>
@@ -156,6 +158,11 @@ void bear::universe::static_map<ItemType>::get_area
   if ( max_y >= m_size.y )
     max_y = m_size.y - 1;
 
+  if ( (min_x <= max_x) && (min_y <= max_y) )
+    BEAR_COUNTER_ADD
+      ( "static_map/cells_visited",
+        (max_x - min_x + 1) * (max_y - min_y + 1) );
+
   std::vector<std::size_t> ids_in_area;
 
   for ( unsigned int x( min_x ); x<=max_x; ++x )
@@ -0,0 +1,81 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The pixels of an image, stored in the layout expected by the
+ *        textures, as produced offline by the bake-image tool.
+ * \author Julien Jorge
+ */
+#ifndef __VISUAL_BAKED_IMAGE_HPP__
+#define __VISUAL_BAKED_IMAGE_HPP__
+
+#include <claw/coordinate_2d.hpp>
+#include <claw/pixel.hpp>
+
+#include <iostream>
+#include <vector>
+
+#include "visual/class_export.hpp"
+
+namespace bear
+{
+  namespace visual
+  {
+    /**
+     * \brief The pixels of an image, stored in the layout expected by the
+     *        textures.
+     *
+     * A baked image file is made of the following fields, the integers being
+     * stored as 32 bits little endian values (see bear::baked_image_format):
+     * - the four characters "BTEX",
+     * - the version of the format,
+     * - the width of the image,
+     * - the height of the image,
+     * - the flags of the image (bit 0 tells if some pixels are transparent),
+     * - the pixels, row by row, four bytes per pixel in the RGBA order.
+     *
+     * The file is rejected if its size does not match the dimensions of the
+     * image. The format does not store the opaque rectangle of the image since
+     * the engine only uses the transparency flag of the images.
+     *
+     * \author Julien Jorge
+     */
+    class VISUAL_EXPORT baked_image
+    {
+    public:
+      /** \brief The type of the pixels of the image. */
+      typedef claw::graphic::rgba_pixel_8 pixel_type;
+
+    public:
+      explicit baked_image( std::istream& f );
+
+      static bool is_baked_image( std::istream& f );
+
+      claw::math::coordinate_2d<unsigned int> size() const;
+      bool has_transparency() const;
+      const pixel_type* pixels() const;
+
+    private:
+      static bool read_integer( std::istream& f, unsigned int& i );
+
+    private:
+      /** \brief The size of the image. */
+      claw::math::coordinate_2d<unsigned int> m_size;
+
+      /** \brief Tells if some pixels are not fully opaque. */
+      bool m_has_transparency;
+
+      /** \brief The pixels of the image, row by row. */
+      std::vector<pixel_type> m_pixels;
+
+    }; // class baked_image
+  } // namespace visual
+} // namespace bear
+
+#endif // __VISUAL_BAKED_IMAGE_HPP__
@@ -0,0 +1,134 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::visual::baked_image class.
+ * \author Julien Jorge
+ */
+#include "visual/baked_image.hpp"
+
+#include "baked_image_format.hpp"
+
+#include <claw/exception.hpp>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Loads a baked image from a stream.
+ * \param f The stream from which the image is read.
+ */
+bear::visual::baked_image::baked_image( std::istream& f )
+  : m_has_transparency(false)
+{
+  unsigned int magic;
+
+  if ( !read_integer( f, magic ) || (magic != baked_image_format::magic) )
+    throw claw::bad_format( "Not a baked image." );
+
+  unsigned int version;
+  unsigned int flags;
+
+  if ( !read_integer( f, version ) || !read_integer( f, m_size.x )
+       || !read_integer( f, m_size.y ) || !read_integer( f, flags ) )
+    throw claw::bad_format( "Invalid baked image header." );
+
+  if ( version != baked_image_format::version )
+    throw claw::bad_format( "Unsupported baked image version." );
+
+  // The size of the pixels is checked against the data actually available
+  // before allocating them, since the dimensions come from the file.
+  const std::istream::pos_type pixels_position( f.tellg() );
+  f.seekg( 0, std::ios_base::end );
+  const std::istream::pos_type end_position( f.tellg() );
+  f.seekg( pixels_position );
+
+  const unsigned long long pixels_count
+    ( (unsigned long long)m_size.x * m_size.y );
+
+  if ( (pixels_position == std::istream::pos_type(-1))
+       || (end_position == std::istream::pos_type(-1)) || !f
+       || ( (unsigned long long)(end_position - pixels_position)
+            != pixels_count * baked_image_format::pixel_size ) )
+    throw claw::bad_format( "The size of the baked image does not match its"
+                            " pixels." );
+
+  m_has_transparency = (flags & baked_image_format::flag_transparency) != 0;
+  m_pixels.resize( pixels_count );
+
+  if ( !f.read( reinterpret_cast<char*>( m_pixels.data() ),
+                m_pixels.size() * sizeof(pixel_type) ) )
+    throw claw::bad_format( "Truncated baked image." );
+} // baked_image::baked_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if a stream contains a baked image. The position in the stream
+ *        is left unchanged.
+ * \param f The stream to check.
+ */
+bool bear::visual::baked_image::is_baked_image( std::istream& f )
+{
+  const std::istream::pos_type pos( f.tellg() );
+  unsigned int magic;
+
+  const bool result
+    ( read_integer( f, magic ) && (magic == baked_image_format::magic) );
+
+  f.clear();
+  f.seekg( pos );
+
+  return result;
+} // baked_image::is_baked_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the size of the image.
+ */
+claw::math::coordinate_2d<unsigned int> bear::visual::baked_image::size() const
+{
+  return m_size;
+} // baked_image::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tells if some pixels of the image are not fully opaque.
+ */
+bool bear::visual::baked_image::has_transparency() const
+{
+  return m_has_transparency;
+} // baked_image::has_transparency()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the pixels of the image, row by row.
+ */
+const bear::visual::baked_image::pixel_type*
+bear::visual::baked_image::pixels() const
+{
+  return m_pixels.data();
+} // baked_image::pixels()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Reads a 32 bits little endian integer.
+ * \param f The stream from which the integer is read.
+ * \param i (out) The integer.
+ */
+bool
+bear::visual::baked_image::read_integer( std::istream& f, unsigned int& i )
+{
+  unsigned char bytes[4];
+
+  if ( !f.read( reinterpret_cast<char*>(bytes), sizeof(bytes) ) )
+    return false;
+
+  i = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16)
+    | ((unsigned int)bytes[3] << 24);
+
+  return true;
+} // baked_image::read_integer()
@@ -4,6 +4,8 @@
 #include "visual/gl_state.hpp"
 #include "visual/detail/gl_vertex_attribute_index.hpp"
 
+#include "debug/performance_counters.hpp"
+
 #include <cassert>
 #include <limits>
 #include <numeric>
@@ -166,6 +168,8 @@ void bear::visual::gl_draw::draw( GLenum mode, GLuint first, GLuint count )
     ( mode, count, GL_UNSIGNED_SHORT,
       reinterpret_cast< GLvoid* >( first * sizeof( GLushort ) ) );
   VISUAL_GL_ERROR_THROW();
+
+  BEAR_COUNTER_ADD( "gl/draw_calls", 1 );
 }
 
 void bear::visual::gl_draw::set_viewport
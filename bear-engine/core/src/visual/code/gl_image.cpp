@@ -13,6 +13,7 @@
  */
 #include "visual/gl_image.hpp"
 
+#include "visual/baked_image.hpp"
 #include "visual/gl_renderer.hpp"
 
 #include <climits>
@@ -47,6 +48,27 @@ bear::visual::gl_image::gl_image(const claw::graphic::image& data)
   copy_scanlines(data);
 } // gl_image::gl_image() [claw::graphic::gl_image]
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor with the pixels of a baked image.
+ * \param data The image to copy.
+ */
+bear::visual::gl_image::gl_image( const baked_image& data )
+  : m_texture_id(0), m_size( data.size() ),
+    m_has_transparency( data.has_transparency() )
+{
+  const unsigned int max_size
+    ( gl_renderer::get_instance().get_max_texture_size() );
+
+  if ( (m_size.x > max_size) || (m_size.y > max_size) )
+    throw claw::exception( "The baked image is larger than the textures." );
+
+  create_texture();
+  gl_renderer::get_instance().draw_texture
+    ( m_texture_id, data.pixels(), m_size,
+      claw::math::coordinate_2d<unsigned int>( 0, 0 ) );
+} // gl_image::gl_image() [baked_image]
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Destructor.
@@ -22,6 +22,10 @@
 #include "visual/detail/get_default_fragment_shader_code.hpp"
 #include "visual/detail/get_default_vertex_shader_code.hpp"
 #include "visual/detail/gl_vertex_attribute_index.hpp"
+#include "visual/detail/pack_image_pixels.hpp"
+
+#include "debug/performance_counters.hpp"
+#include "debug/profiler_zone.hpp"
 
 #include "time/time.hpp"
 
@@ -100,6 +104,26 @@ GLuint bear::visual::gl_renderer::create_texture( screen_size_type& size )
   return texture_id;
 } // gl_renderer::create_texture()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Gets the maximum width and height of the textures.
+ */
+unsigned int bear::visual::gl_renderer::get_max_texture_size()
+{
+  boost::mutex::scoped_lock lock( m_mutex.gl_access );
+
+  GLint result(0);
+
+  make_current();
+
+  glGetIntegerv( GL_MAX_TEXTURE_SIZE, &result );
+  VISUAL_GL_ERROR_THROW();
+
+  release_context();
+
+  return result;
+} // gl_renderer::get_max_texture_size()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Replaces a portion of a texture with a given data.
@@ -112,29 +136,36 @@ bool bear::visual::gl_renderer::draw_texture
 ( GLuint texture_id, const claw::graphic::image& data,
   const screen_position_type& pos )
 {
-  const claw::graphic::rgba_pixel_8::component_type opaque =
-    std::numeric_limits<claw::graphic::rgba_pixel_8::component_type>::max();
-
   const std::size_t pixels_count( data.width() * data.height() );
   claw::graphic::rgba_pixel_8* const pixels =
     new claw::graphic::rgba_pixel_8[ pixels_count ];
 
-  std::copy( data.begin(), data.end(), pixels );
+  const bool has_transparency( detail::pack_image_pixels( data, pixels ) );
 
   copy_texture_pixels
     ( texture_id, pixels, pos.x, pos.y, data.width(), data.height() );
 
-  bool has_transparency( false );
-
-  for ( claw::graphic::rgba_pixel_8* p = pixels;
-        (p != pixels + pixels_count) && !has_transparency; ++p )
-    has_transparency = p->components.alpha != opaque;
-  
   delete[] pixels;
 
   return has_transparency;
 } // gl_renderer::draw_texture()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Replaces a portion of a texture with pixels already stored in the
+ *        layout of the textures.
+ * \param texture_id The identifier of the texture in which we write the pixels.
+ * \param pixels The pixels to copy in the image, row by row.
+ * \param size The size of the region described by \a pixels.
+ * \param pos The position in the image where data must be copied.
+ */
+void bear::visual::gl_renderer::draw_texture
+( GLuint texture_id, const claw::graphic::rgba_pixel_8* pixels,
+  const screen_size_type& size, const screen_position_type& pos )
+{
+  copy_texture_pixels( texture_id, pixels, pos.x, pos.y, size.x, size.y );
+} // gl_renderer::draw_texture()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Reads the content of a texture in an image.
@@ -465,6 +496,8 @@ void bear::visual::gl_renderer::set_fullscreen( bool f )
  */
 void bear::visual::gl_renderer::set_gl_states( state_list& states )
 {
+  BEAR_COUNTER_ADD( "gl/states", states.size() );
+
   {
     boost::mutex::scoped_lock lock( m_mutex.gl_set_states );
 
@@ -629,6 +662,8 @@ void bear::visual::gl_renderer::render_states()
  */
 void bear::visual::gl_renderer::draw_scene()
 {
+  BEAR_PROFILE_ZONE( "gl_renderer::draw_scene" );
+
   boost::mutex::scoped_lock gl_lock( m_mutex.gl_access );
   make_current();
 
@@ -706,8 +741,8 @@ void bear::visual::gl_renderer::release_context()
  * \param h The height of the region where the pixels are copied in the texture.
  */
 void bear::visual::gl_renderer::copy_texture_pixels
-( GLuint texture_id, claw::graphic::rgba_pixel_8* pixels, std::size_t x,
-  std::size_t y, std::size_t w, std::size_t h )
+( GLuint texture_id, const claw::graphic::rgba_pixel_8* pixels,
+  std::size_t x, std::size_t y, std::size_t w, std::size_t h )
 {
   boost::mutex::scoped_lock lock( m_mutex.gl_access );
 
@@ -718,6 +753,9 @@ void bear::visual::gl_renderer::copy_texture_pixels
   glTexSubImage2D
     ( GL_TEXTURE_2D, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels );
 
+  BEAR_COUNTER_ADD( "gl/texture_uploads", 1 );
+  BEAR_COUNTER_ADD( "gl/texture_upload_bytes", w * h * 4 );
+
   release_context();
 } // gl_renderer::copy_texture_pixels()
 
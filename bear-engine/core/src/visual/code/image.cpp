@@ -13,6 +13,7 @@
  */
 #include "visual/image.hpp"
 
+#include "visual/baked_image.hpp"
 #include "visual/screen.hpp"
 #include "visual/gl_image.hpp"
 
@@ -58,6 +59,17 @@ bear::visual::image::image(const claw::graphic::image& data)
   restore(data);
 } // image::image() [claw::graphic::image]
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor with a baked image.
+ * \param data The image to copy.
+ */
+bear::visual::image::image( const baked_image& data )
+  : m_impl(new base_image_ptr(NULL))
+{
+  restore(data);
+} // image::image() [baked_image]
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Delete the data ofthe image.
@@ -93,6 +105,31 @@ void bear::visual::image::restore( const claw::graphic::image& data )
     }
 } // image::restore()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restore the image from a baked image.
+ * \param data The image to restore from.
+ */
+void bear::visual::image::restore( const baked_image& data )
+{
+  if ( m_impl == NULL )
+    m_impl = new base_image_ptr(NULL);
+  else if (*m_impl != NULL)
+    {
+      assert( data.size().x == width() );
+      assert( data.size().y == height() );
+    }
+
+  switch ( screen::get_sub_system() )
+    {
+    case screen::screen_gl:
+      *m_impl = new gl_image(data);
+      break;
+    case screen::screen_undef:
+      throw claw::exception("screen sub system has not been set.");
+    }
+} // image::restore() [baked_image]
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get image's width.
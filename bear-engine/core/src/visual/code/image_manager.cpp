@@ -15,6 +15,8 @@
 
 #include "visual/image_manager.hpp"
 
+#include "visual/baked_image.hpp"
+
 #include <claw/assert.hpp>
 #include <claw/functional.hpp>
 #include <claw/png.hpp>
@@ -34,7 +36,8 @@ void bear::visual::image_manager::clear()
 /**
  * \brief Adds an image to the cache.
  * \param name The name of the loaded image.
- * \param file A stream containing the file to load.
+ * \param file A stream containing the file to load, either a PNG file or a
+ *        baked image.
  * \pre name is not used by another image.
  * \post get_image(name) is the image in file_name.
  */
@@ -43,8 +46,13 @@ void bear::visual::image_manager::load_image
 {
   CLAW_PRECOND( !exists(name) );
 
-  claw::graphic::png img(file);
-  add_image( name, image(img) );
+  if ( baked_image::is_baked_image(file) )
+    add_image( name, image( baked_image(file) ) );
+  else
+    {
+      claw::graphic::png img(file);
+      add_image( name, image(img) );
+    }
 } // image_manager::load_image()
 
 /*---------------------------------------------------------------------------*/
@@ -81,7 +89,8 @@ void bear::visual::image_manager::clear_images()
 /**
  * \brief Restore an image.
  * \param name The name of the loaded image.
- * \param file A stream containing the file to load.
+ * \param file A stream containing the file to load, either a PNG file or a
+ *        baked image.
  * \pre There is an image called \a name.
  *
  * This method is useful when the screen goes dirty, to re-initialize the
@@ -92,8 +101,13 @@ void bear::visual::image_manager::restore_image
 {
   CLAW_PRECOND( exists(name) );
 
-  claw::graphic::png img(file);
-  m_images[name].restore(img);
+  if ( baked_image::is_baked_image(file) )
+    m_images[name].restore( baked_image(file) );
+  else
+    {
+      claw::graphic::png img(file);
+      m_images[name].restore(img);
+    }
 } // image_manager::restore_image()
 
 /*---------------------------------------------------------------------------*/
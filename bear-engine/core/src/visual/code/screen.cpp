@@ -15,6 +15,9 @@
 
 #include "visual/gl_screen.hpp"
 
+#include "debug/performance_counters.hpp"
+#include "debug/profiler_zone.hpp"
+
 #include <claw/exception.hpp>
 #include <claw/bitmap.hpp>
 #include <claw/logger.hpp>
@@ -224,8 +227,13 @@ void bear::visual::screen::render( const scene_element& e )
 {
   CLAW_PRECOND(m_mode == SCREEN_RENDER);
 
+  BEAR_COUNTER_ADD( "screen/elements_submitted", 1 );
+
   if ( !e.always_displayed() && e.get_bounding_box().empty() )
-    return;
+    {
+      BEAR_COUNTER_ADD( "screen/elements_culled", 1 );
+      return;
+    }
 
   if ( e.has_shadow() )
     {
@@ -339,6 +347,8 @@ void bear::visual::screen::render_element( const scene_element& e ) const
  */
 void bear::visual::screen::render_elements()
 {
+  BEAR_PROFILE_ZONE( "screen::render_elements" );
+
   if ( m_dumb_rendering )
     {
       for ( scene_element_list::const_iterator it( m_scene_element.begin() );
@@ -363,6 +373,8 @@ void bear::visual::screen::render_elements()
           if ( e.always_displayed()
                || intersects_any( e.get_bounding_box(), boxes ) )
             split( e, final_elements, boxes );
+          else
+            BEAR_COUNTER_ADD( "screen/elements_culled", 1 );
         }
 
       // split() push the elements at the end of the list, so they are now
@@ -0,0 +1,92 @@
+#include "visual/detail/pack_image_pixels.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace bear
+{
+  namespace visual
+  {
+    namespace detail
+    {
+      namespace
+      {
+        typedef claw::graphic::rgba_pixel_8 pixel_type;
+
+        const pixel_type::component_type opaque =
+          std::numeric_limits<pixel_type::component_type>::max();
+
+        /**
+         * \brief Copies a line of pixels and computes the bitwise and of their
+         *        alpha components.
+         * \param first The first pixel to copy.
+         * \param last The pixel just past the last pixel to copy.
+         * \param out The buffer receiving the pixels.
+         * \return opaque if all pixels are opaque.
+         */
+        pixel_type::component_type copy_line
+        ( const pixel_type* first, const pixel_type* last, pixel_type* out )
+        {
+          pixel_type::component_type alpha( opaque );
+
+#ifdef __SSE2__
+          // The pixels are stored as RGBA bytes, thus the alpha is the high
+          // byte of each 32 bits word. Four pixels are processed at once.
+          const __m128i color_mask( _mm_set1_epi32( 0x00ffffff ) );
+          const __m128i all_set( _mm_set1_epi32( -1 ) );
+          __m128i acc( all_set );
+
+          for ( ; last - first >= 4; first += 4, out += 4 )
+            {
+              const __m128i p
+                ( _mm_loadu_si128( reinterpret_cast<const __m128i*>(first) ) );
+              _mm_storeu_si128( reinterpret_cast<__m128i*>(out), p );
+              acc = _mm_and_si128( acc, p );
+            }
+
+          acc = _mm_or_si128( acc, color_mask );
+
+          if ( _mm_movemask_epi8( _mm_cmpeq_epi8( acc, all_set ) ) != 0xffff )
+            alpha = 0;
+#endif
+
+          for ( ; first != last; ++first, ++out )
+            {
+              *out = *first;
+              alpha &= first->components.alpha;
+            }
+
+          return alpha;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * \brief Copies the pixels of an image in a contiguous buffer, ready to be
+ *        sent to the graphic card, and tells if some pixels are transparent.
+ * \param data The image to copy.
+ * \param pixels The buffer receiving the pixels. It must be large enough to
+ *        receive data.width() * data.height() pixels.
+ * \return true if some pixels of the image are not fully opaque.
+ */
+bool bear::visual::detail::pack_image_pixels
+( const claw::graphic::image& data, claw::graphic::rgba_pixel_8* pixels )
+{
+  const std::size_t width( data.width() );
+  pixel_type::component_type alpha( opaque );
+
+  for ( std::size_t y(0); y != data.height(); ++y, pixels += width )
+    if ( width != 0 )
+      {
+        const pixel_type* const line( &*data[y].begin() );
+        alpha &= copy_line( line, line + width, pixels );
+      }
+
+  return alpha != opaque;
+}
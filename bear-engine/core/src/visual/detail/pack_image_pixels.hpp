@@ -0,0 +1,16 @@
+#pragma once
+
+#include <claw/image.hpp>
+
+namespace bear
+{
+  namespace visual
+  {
+    namespace detail
+    {
+      bool pack_image_pixels
+      ( const claw::graphic::image& data,
+        claw::graphic::rgba_pixel_8* pixels );
+    }
+  }
+}
@@ -22,6 +22,8 @@ namespace bear
 {
   namespace visual
   {
+    class baked_image;
+
     /**
      * \brief OpenGL implementation of an image.
      * \author Julien Jorge
@@ -32,6 +34,7 @@ namespace bear
     public:
       gl_image( unsigned int width, unsigned int height );
       explicit gl_image( const claw::graphic::image& data );
+      explicit gl_image( const baked_image& data );
       ~gl_image();
 
       GLuint texture_id() const;
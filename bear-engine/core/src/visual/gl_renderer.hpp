@@ -64,9 +64,13 @@ namespace bear
       static void terminate();
 
       GLuint create_texture( screen_size_type& size );
+      unsigned int get_max_texture_size();
       bool draw_texture
       ( GLuint texture_id, const claw::graphic::image& data,
         const screen_position_type& pos );
+      void draw_texture
+      ( GLuint texture_id, const claw::graphic::rgba_pixel_8* pixels,
+        const screen_size_type& size, const screen_position_type& pos );
 
       claw::graphic::image
       read_texture( GLuint texture_id, const screen_size_type& size );
@@ -122,8 +126,8 @@ namespace bear
       void release_context();
       
       void copy_texture_pixels
-      ( GLuint texture_id, claw::graphic::rgba_pixel_8* pixels, std::size_t x,
-        std::size_t y, std::size_t w, std::size_t h );
+      ( GLuint texture_id, const claw::graphic::rgba_pixel_8* pixels,
+        std::size_t x, std::size_t y, std::size_t w, std::size_t h );
 
       bool ensure_window_exists();
       void create_drawing_helper();
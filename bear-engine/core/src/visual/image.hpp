@@ -26,6 +26,8 @@ namespace bear
 {
   namespace visual
   {
+    class baked_image;
+
     /**
      * \brief An image class, used for sprites.
      * \author Julien Jorge
@@ -39,9 +41,11 @@ namespace bear
       image();
       image( unsigned int width, unsigned int height );
       explicit image( const claw::graphic::image& data );
+      explicit image( const baked_image& data );
 
       void clear();
       void restore( const claw::graphic::image& data );
+      void restore( const baked_image& data );
 
       unsigned int width() const;
       unsigned int height() const;
@@ -0,0 +1,121 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the bear::performance_counters_layer class.
+ * \author Julien Jorge
+ */
+#include "generic_items/layer/performance_counters_layer.hpp"
+
+#include "debug/performance_counters.hpp"
+#include "input/keyboard.hpp"
+
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+const bear::gui::size_type bear::performance_counters_layer::s_margin(10);
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param f The font to use to display the counters.
+ */
+bear::performance_counters_layer::performance_counters_layer( visual::font f )
+  : m_toggle_key(input::keyboard::kc_F10), m_font(f), m_text(NULL)
+{
+
+} // performance_counters_layer::performance_counters_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+bear::performance_counters_layer::~performance_counters_layer()
+{
+  delete m_text;
+} // performance_counters_layer::~performance_counters_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do one step in the progression of the layer.
+ * \param elapsed_time Elapsed time since the last call.
+ */
+void bear::performance_counters_layer::progress
+( universe::time_type elapsed_time )
+{
+  if ( m_text != NULL )
+    update();
+} // performance_counters_layer::progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the layer on a screen.
+ * \param e (out) The scene elements.
+ */
+void bear::performance_counters_layer::render( scene_element_list& e ) const
+{
+  if ( m_text != NULL )
+    m_text->render( e );
+} // performance_counters_layer::render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Inform the layer that a keyboard key has been pressed.
+ * \param key The value of the pressed key.
+ */
+bool
+bear::performance_counters_layer::key_pressed( const input::key_info& key )
+{
+  bool result = true;
+
+  if ( key.get_code() == m_toggle_key )
+    {
+      if ( m_text == NULL )
+        {
+          m_text = new gui::static_text( m_font );
+          m_text->set_auto_size(true);
+          m_text->set_background_color( gui::color_type( "#80000000" ) );
+          update();
+        }
+      else
+        {
+          delete m_text;
+          m_text = NULL;
+        }
+    }
+  else
+    result = false;
+
+  return result;
+} // performance_counters_layer::key_pressed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Display the values of the counters in the last frame, in the top left
+ *        corner of the layer.
+ */
+void bear::performance_counters_layer::update()
+{
+  const debug::performance_counters::value_list& values
+    ( debug::performance_counters::get_last_frame() );
+
+  std::ostringstream oss;
+
+  for ( std::size_t i=0; i!=values.size(); ++i )
+    {
+      if ( i != 0 )
+        oss << '\n';
+
+      oss << debug::performance_counters::get_counter_name(i) << ": "
+          << values[i];
+    }
+
+  m_text->set_text( oss.str() );
+  m_text->set_position( s_margin, get_size().y - m_text->height() - s_margin );
+} // performance_counters_layer::update()
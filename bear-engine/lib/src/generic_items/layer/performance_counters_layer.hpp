@@ -0,0 +1,66 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief This layer displays the values of the performance counters in the
+ *        last frame.
+ * \author Julien Jorge
+ */
+#ifndef __BEAR_PERFORMANCE_COUNTERS_LAYER_HPP__
+#define __BEAR_PERFORMANCE_COUNTERS_LAYER_HPP__
+
+#include "engine/layer/gui_layer.hpp"
+#include "gui/static_text.hpp"
+
+#include "generic_items/class_export.hpp"
+
+namespace bear
+{
+  /**
+   * \brief This layer displays the values of the performance counters in the
+   *        last frame.
+   *
+   * The layer is shown and hidden with the F10 key.
+   *
+   * \author Julien Jorge
+   */
+  class GENERIC_ITEMS_EXPORT performance_counters_layer:
+    public engine::gui_layer
+  {
+  public:
+    explicit performance_counters_layer( visual::font f );
+    ~performance_counters_layer();
+
+    void progress( universe::time_type elapsed_time );
+    void render( scene_element_list& e ) const;
+
+    bool key_pressed( const input::key_info& key );
+
+  private:
+    void update();
+
+  private:
+    /** \brief The value of the key that changes the visibility of the
+        layer. */
+    const input::key_code m_toggle_key;
+
+    /** \brief The font to use to display the counters. */
+    visual::font m_font;
+
+    /** \brief The component displaying the counters, NULL when the layer is
+        hidden. */
+    gui::static_text* m_text;
+
+    /** \brief The margin between the text and the border of the layer. */
+    static const gui::size_type s_margin;
+
+  }; // class performance_counters_layer
+} // namespace bear
+
+#endif // __BEAR_PERFORMANCE_COUNTERS_LAYER_HPP__
@@ -0,0 +1,160 @@
+/**
+ * \file
+ *
+ * Performance test of the mixing of the samples, without an audio device.
+ *
+ * Usage: audio-mix [samples] [buffers] [output.wav]
+ *
+ * The given number of looping samples are played at random positions, with a
+ * fixed seed, while the ears move around them. The buffers are mixed as fast
+ * as possible and the time spent in each of them is reported in microseconds,
+ * along with the fraction of the real time budget it represents. If an output
+ * file is given, the mixed frames are saved in it, such that two runs can be
+ * compared.
+ */
+
+#include "audio/sample.hpp"
+#include "audio/sound_effect.hpp"
+#include "audio/sound_manager.hpp"
+#include "audio/wav_writer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+typedef std::chrono::steady_clock clock_type;
+
+const std::size_t buffer_frames( 1024 );
+
+std::string make_tone( unsigned int rate, double frequency, double seconds )
+{
+  std::ostringstream result;
+  bear::audio::wav_writer writer( result, rate, 2 );
+
+  const std::size_t frames( rate * seconds );
+  std::vector<claw::int_16> samples( 2 * frames );
+
+  for ( std::size_t i(0); i != frames; ++i )
+    {
+      const double t( 2 * M_PI * frequency * i / rate );
+      samples[2 * i] = 8000 * std::sin( t );
+      samples[2 * i + 1] = 8000 * std::sin( 1.5 * t );
+    }
+
+  writer.write( samples.data(), frames );
+  writer.close();
+
+  return result.str();
+}
+
+int main( int argc, char* argv[] )
+{
+  std::size_t sample_count( 256 );
+  std::size_t buffer_count( 2000 );
+
+  if ( argc > 1 )
+    std::istringstream( argv[1] ) >> sample_count;
+
+  if ( argc > 2 )
+    std::istringstream( argv[2] ) >> buffer_count;
+
+  bear::audio::sound_manager::initialize_offline();
+  const unsigned int rate( bear::audio::sound_manager::get_output_rate() );
+
+  std::ofstream output_file;
+  bear::audio::wav_writer* output( NULL );
+
+  if ( argc > 3 )
+    {
+      output_file.open( argv[3], std::ios::binary );
+      output = new bear::audio::wav_writer( output_file, rate, 2 );
+    }
+
+  std::mt19937 generator( 42 );
+  std::uniform_real_distribution<double> coordinate( -2000, 2000 );
+  std::uniform_real_distribution<double> duration( 0.5, 3 );
+
+  bear::audio::sound_manager manager;
+  const std::size_t tone_count( 8 );
+
+  for ( std::size_t i(0); i != tone_count; ++i )
+    {
+      std::istringstream tone
+        ( make_tone( rate, 220 * (i + 1), duration( generator ) ) );
+      std::ostringstream name;
+      name << "tone-" << i;
+      manager.load_sound( name.str(), tone );
+    }
+
+  std::vector<bear::audio::sample*> samples( sample_count );
+
+  for ( std::size_t i(0); i != sample_count; ++i )
+    {
+      std::ostringstream name;
+      name << "tone-" << (i % tone_count);
+
+      bear::audio::sound_effect effect( 0u );
+      effect.set_position
+        ( claw::math::coordinate_2d<double>
+          ( coordinate( generator ), coordinate( generator ) ) );
+
+      samples[i] = manager.new_sample( name.str() );
+      samples[i]->play( effect );
+    }
+
+  std::vector<claw::int_16> buffer( 2 * buffer_frames );
+  std::vector<double> durations( buffer_count );
+
+  for ( std::size_t i(0); i != buffer_count; ++i )
+    {
+      const double angle( 2 * M_PI * i / buffer_count );
+      manager.set_ears_position
+        ( claw::math::coordinate_2d<double>
+          ( 1000 * std::cos( angle ), 1000 * std::sin( angle ) ) );
+
+      const clock_type::time_point start( clock_type::now() );
+      bear::audio::sound_manager::render( buffer.data(), buffer_frames );
+      durations[i] =
+        std::chrono::duration<double, std::micro>
+        ( clock_type::now() - start ).count();
+
+      if ( output != NULL )
+        output->write( buffer.data(), buffer_frames );
+    }
+
+  delete output;
+
+  for ( std::size_t i(0); i != sample_count; ++i )
+    delete samples[i];
+
+  manager.clear();
+  bear::audio::sound_manager::release();
+
+  if ( buffer_count == 0 )
+    return 0;
+
+  double total( 0 );
+
+  for ( std::size_t i(0); i != buffer_count; ++i )
+    total += durations[i];
+
+  std::sort( durations.begin(), durations.end() );
+
+  const double budget( 1000000.0 * buffer_frames / rate );
+  const double mean( total / buffer_count );
+
+  std::cout << "samples: " << sample_count << '\n'
+            << "buffers: " << buffer_count << " of " << buffer_frames
+            << " frames\n"
+            << "mean us/buffer: " << mean << '\n'
+            << "median us/buffer: " << durations[ buffer_count / 2 ] << '\n'
+            << "max us/buffer: " << durations.back() << '\n'
+            << "real time fraction: " << mean / budget << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * \file
+ *
+ * Performance test of the conversion of the PNG files into the buffers sent to
+ * the textures.
+ *
+ * Usage: image-decode directory [repeat]
+ *
+ * All the PNG files found in the directory and its subdirectories are decoded
+ * then packed both with the legacy per pixel copy and with
+ * bear::visual::detail::pack_image_pixels. The durations are reported in
+ * milliseconds per megapixel.
+ */
+
+#include "visual/detail/pack_image_pixels.hpp"
+
+#include <claw/png.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+typedef std::chrono::steady_clock clock_type;
+
+double elapsed_ms( clock_type::time_point start )
+{
+  return std::chrono::duration<double, std::milli>
+    ( clock_type::now() - start ).count();
+}
+
+bool legacy_pack
+( const claw::graphic::image& data, claw::graphic::rgba_pixel_8* pixels )
+{
+  const claw::graphic::rgba_pixel_8::component_type opaque =
+    std::numeric_limits<claw::graphic::rgba_pixel_8::component_type>::max();
+
+  const std::size_t pixels_count( data.width() * data.height() );
+  std::copy( data.begin(), data.end(), pixels );
+
+  bool has_transparency( false );
+
+  for ( claw::graphic::rgba_pixel_8* p = pixels;
+        (p != pixels + pixels_count) && !has_transparency; ++p )
+    has_transparency = p->components.alpha != opaque;
+
+  return has_transparency;
+}
+
+int main( int argc, char* argv[] )
+{
+  if ( argc < 2 )
+    {
+      std::cerr << "Usage: " << argv[0] << " directory [repeat]" << std::endl;
+      return 1;
+    }
+
+  std::size_t repeat( 10 );
+
+  if ( argc > 2 )
+    std::istringstream( argv[2] ) >> repeat;
+
+  double megapixels( 0 );
+  double decode_ms( 0 );
+  double legacy_ms( 0 );
+  double packed_ms( 0 );
+  std::size_t files( 0 );
+
+  for ( boost::filesystem::recursive_directory_iterator it( argv[1] ), eit;
+        it != eit; ++it )
+    {
+      if ( it->path().extension() != ".png" )
+        continue;
+
+      std::ifstream f( it->path().string().c_str(), std::ios::binary );
+      std::stringstream content;
+      content << f.rdbuf();
+
+      clock_type::time_point start( clock_type::now() );
+      claw::graphic::png image( content );
+      decode_ms += elapsed_ms( start );
+
+      const std::size_t count( image.width() * image.height() );
+      std::vector<claw::graphic::rgba_pixel_8> pixels( count );
+      bool legacy_transparency( false );
+      bool packed_transparency( false );
+
+      start = clock_type::now();
+
+      for ( std::size_t i(0); i != repeat; ++i )
+        legacy_transparency = legacy_pack( image, pixels.data() );
+
+      legacy_ms += elapsed_ms( start ) / repeat;
+
+      start = clock_type::now();
+
+      for ( std::size_t i(0); i != repeat; ++i )
+        packed_transparency =
+          bear::visual::detail::pack_image_pixels( image, pixels.data() );
+
+      packed_ms += elapsed_ms( start ) / repeat;
+
+      if ( legacy_transparency != packed_transparency )
+        std::cerr << "Transparency mismatch in " << it->path() << std::endl;
+
+      megapixels += count / 1000000.0;
+      ++files;
+    }
+
+  if ( megapixels == 0 )
+    {
+      std::cerr << "No PNG file found." << std::endl;
+      return 1;
+    }
+
+  std::cout << "files: " << files << '\n'
+            << "megapixels: " << megapixels << '\n'
+            << "decode ms/MP: " << decode_ms / megapixels << '\n'
+            << "legacy pack ms/MP: " << legacy_ms / megapixels << '\n'
+            << "fused pack ms/MP: " << packed_ms / megapixels << std::endl;
+
+  return 0;
+}
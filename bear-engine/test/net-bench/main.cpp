@@ -0,0 +1,267 @@
+/**
+ * \file
+ *
+ * Performance test of the network of the engine through the loopback
+ * interface.
+ *
+ * Usage: net-bench [clients] [iterations] [probes] [blobs] [payload] [port]
+ *
+ * A game_network creates a service and connects the given number of clients
+ * to it, in the same process. Each client uses its own loopback address
+ * (127.0.0.1, 127.0.0.2, …) since the game_network shares the connections to
+ * the same host and port. Then the game_network progresses in lockstep: at
+ * each iteration it waits for the synchronization of all the clients,
+ * processes the received messages, sends the given number of small probes and
+ * of blobs carrying a payload of the given size, and sends the sync messages.
+ *
+ * The reported latency is the time between the dispatch of a message and its
+ * processing by a client, thus it includes the lockstep delay. The CPU time
+ * includes the io_thread.
+ */
+
+#include "engine/game_network.hpp"
+#include "engine/network/message/message_export.hpp"
+
+#include "net/binary_input.hpp"
+#include "net/binary_output.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock clock_type;
+
+long long get_date()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>
+    ( clock_type::now().time_since_epoch() ).count();
+}
+
+class probe:
+  public bear::net::message
+{
+  DECLARE_MESSAGE(probe);
+
+public:
+  probe()
+    : date(0)
+  {
+
+  }
+
+  probe( long long d, std::size_t payload_size )
+    : date(d), payload( payload_size, 'x' )
+  {
+
+  }
+
+private:
+  bear::net::binary_output&
+  formatted_output( bear::net::binary_output& os ) const
+  {
+    return os << date << payload;
+  }
+
+  bear::net::binary_input& formatted_input( bear::net::binary_input& is )
+  {
+    return is >> date >> payload;
+  }
+
+public:
+  long long date;
+  std::string payload;
+
+};
+
+class blob:
+  public probe
+{
+  DECLARE_MESSAGE(blob);
+
+public:
+  blob()
+  {
+
+  }
+
+  blob( long long d, std::size_t payload_size )
+    : probe( d, payload_size )
+  {
+
+  }
+
+};
+
+MESSAGE_EXPORT_NO_NAMESPACE( probe )
+MESSAGE_EXPORT_NO_NAMESPACE( blob )
+
+class latency_recorder
+{
+public:
+  explicit latency_recorder( std::vector<double>& latencies )
+    : m_latencies( latencies )
+  {
+
+  }
+
+  void operator()( const probe& m ) const
+  {
+    m_latencies.push_back( get_date() - m.date );
+  }
+
+private:
+  std::vector<double>& m_latencies;
+
+};
+
+bool synchronize( bear::engine::game_network& network )
+{
+  const clock_type::time_point limit
+    ( clock_type::now() + std::chrono::seconds(10) );
+
+  while ( !network.synchronize() )
+    if ( clock_type::now() >= limit )
+      return false;
+    else
+      {
+        // flush the pending messages
+        network.send_synchronization();
+        std::this_thread::yield();
+      }
+
+  return true;
+}
+
+double get_percentile( std::vector<double>& values, double p )
+{
+  if ( values.empty() )
+    return 0;
+
+  const std::size_t i( (values.size() - 1) * p );
+  std::nth_element( values.begin(), values.begin() + i, values.end() );
+
+  return values[i];
+}
+
+int main( int argc, char* argv[] )
+{
+  std::size_t client_count( 8 );
+  std::size_t iteration_count( 2000 );
+  std::size_t probe_count( 16 );
+  std::size_t blob_count( 2 );
+  std::size_t payload_size( 512 );
+  unsigned int port( 43211 );
+
+  if ( argc > 1 )
+    std::istringstream( argv[1] ) >> client_count;
+
+  if ( argc > 2 )
+    std::istringstream( argv[2] ) >> iteration_count;
+
+  if ( argc > 3 )
+    std::istringstream( argv[3] ) >> probe_count;
+
+  if ( argc > 4 )
+    std::istringstream( argv[4] ) >> blob_count;
+
+  if ( argc > 5 )
+    std::istringstream( argv[5] ) >> payload_size;
+
+  if ( argc > 6 )
+    std::istringstream( argv[6] ) >> port;
+
+  if ( (client_count == 0) || (client_count > 254) )
+    {
+      std::cerr << "The number of clients must be in [1, 254]." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  std::vector<double> latencies;
+  latencies.reserve
+    ( iteration_count * client_count * (probe_count + blob_count) );
+
+  bear::engine::game_network network;
+  network.create_service( "bench", port );
+
+  std::vector<bear::engine::client_observer> observers;
+
+  for ( std::size_t i(0); i != client_count; ++i )
+    {
+      std::ostringstream host;
+      host << "127.0.0." << (i + 1);
+
+      observers.push_back( network.connect_to_service( host.str(), port ) );
+      observers.back().subscribe<probe>( latency_recorder( latencies ) );
+      observers.back().subscribe<blob>( latency_recorder( latencies ) );
+    }
+
+  if ( !synchronize( network ) )
+    {
+      std::cerr << "The clients did not connect." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  const clock_type::time_point start( clock_type::now() );
+  const std::clock_t cpu_start( std::clock() );
+  double wait( 0 );
+
+  for ( std::size_t i(0); i != iteration_count; ++i )
+    {
+      for ( std::size_t j(0); j != probe_count; ++j )
+        {
+          probe m( get_date(), 0 );
+          network.send_message( "bench", m );
+        }
+
+      for ( std::size_t j(0); j != blob_count; ++j )
+        {
+          blob m( get_date(), payload_size );
+          network.send_message( "bench", m );
+        }
+
+      network.send_synchronization();
+
+      const clock_type::time_point wait_start( clock_type::now() );
+
+      if ( !synchronize( network ) )
+        {
+          std::cerr << "The synchronization failed at iteration " << i
+                    << '.' << std::endl;
+          return EXIT_FAILURE;
+        }
+
+      wait +=
+        std::chrono::duration<double, std::micro>
+        ( clock_type::now() - wait_start ).count();
+
+      for ( std::size_t j(0); j != observers.size(); ++j )
+        observers[j].process_message();
+    }
+
+  const double duration
+    ( std::chrono::duration<double>( clock_type::now() - start ).count() );
+  const double cpu( double( std::clock() - cpu_start ) / CLOCKS_PER_SEC );
+  const std::size_t received( latencies.size() );
+
+  std::cout << "clients: " << client_count << '\n'
+            << "iterations: " << iteration_count << '\n'
+            << "messages/iteration: " << probe_count << " probes, "
+            << blob_count << " blobs of " << payload_size << " bytes\n"
+            << "received messages: " << received << " (expected "
+            << iteration_count * client_count * (probe_count + blob_count)
+            << ")\n"
+            << "throughput: " << received / duration << " messages/s\n"
+            << "iterations/s: " << iteration_count / duration << '\n'
+            << "mean us waiting for sync: " << wait / iteration_count << '\n'
+            << "p50 latency us: " << get_percentile( latencies, 0.5 ) << '\n'
+            << "p99 latency us: " << get_percentile( latencies, 0.99 ) << '\n'
+            << "cpu us/message: "
+            << (received == 0 ? 0 : 1000000 * cpu / received) << std::endl;
+
+  return EXIT_SUCCESS;
+}
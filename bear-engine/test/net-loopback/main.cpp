@@ -0,0 +1,215 @@
+/**
+ * \file
+ *
+ * Test of the network layer through the loopback interface.
+ *
+ * Usage: net-loopback [port]
+ *
+ * A server and a client are created in the same process, sharing an
+ * io_thread. The test checks that the client connects asynchronously, that
+ * the messages are delivered in order, that the round trip is measured, that
+ * the received messages are queued until they are pulled, and that the client
+ * connects again when the server is restarted. The result of each check is
+ * printed and the program fails if any of them failed.
+ */
+
+#include "net/binary_input.hpp"
+#include "net/binary_output.hpp"
+#include "net/client.hpp"
+#include "net/io_thread.hpp"
+#include "net/message/message.hpp"
+#include "net/server.hpp"
+
+#include <boost/function.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+typedef std::chrono::steady_clock clock_type;
+
+class counter:
+  public bear::net::message
+{
+public:
+  counter()
+    : value(0)
+  {
+
+  }
+
+  explicit counter( unsigned int v )
+    : value(v), text( v, 'x' )
+  {
+
+  }
+
+private:
+  std::string do_get_name() const
+  {
+    return "counter";
+  }
+
+  bear::net::binary_output&
+  formatted_output( bear::net::binary_output& os ) const
+  {
+    return os << value << text;
+  }
+
+  bear::net::binary_input& formatted_input( bear::net::binary_input& is )
+  {
+    return is >> value >> text;
+  }
+
+public:
+  unsigned int value;
+  std::string text;
+
+};
+
+bool wait_for( const boost::function<bool ()>& condition )
+{
+  const clock_type::time_point limit
+    ( clock_type::now() + std::chrono::seconds(10) );
+
+  while ( !condition() )
+    if ( clock_type::now() >= limit )
+      return false;
+    else
+      std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+
+  return true;
+}
+
+bool has_client( bear::net::server& s )
+{
+  s.check_for_new_clients();
+  return s.get_connection_count() != 0;
+}
+
+bool is_connected( const bear::net::client& c )
+{
+  return c.get_status() == bear::net::connection_status_connected;
+}
+
+bool is_reconnecting( const bear::net::client& c )
+{
+  return c.get_status() == bear::net::connection_status_connecting;
+}
+
+bool has_round_trip( const bear::net::client& c, bear::net::server& s )
+{
+  return (c.get_statistics().round_trip_time > 0)
+    && (s.get_statistics(0).round_trip_time > 0);
+}
+
+bool has_incoming( const bear::net::client& c, std::size_t n )
+{
+  return c.get_statistics().incoming_queue_size == n;
+}
+
+bool receive( bear::net::client& c, unsigned int first, unsigned int count )
+{
+  for ( unsigned int i(0); i != count; ++i )
+    {
+      bear::net::message_handle m;
+
+      if ( !wait_for( [&]() -> bool { m = c.pull_message(); return m != NULL; } ) )
+        return false;
+
+      const counter* const v( dynamic_cast<const counter*>( &*m ) );
+
+      if ( (v == NULL) || (v->value != first + i)
+           || (v->text != std::string( first + i, 'x' )) )
+        return false;
+    }
+
+  return true;
+}
+
+void send( bear::net::server& s, unsigned int first, unsigned int count )
+{
+  for ( unsigned int i(0); i != count; ++i )
+    s.dispatch_message( counter( first + i ) );
+
+  s.flush();
+}
+
+bool check( const std::string& name, bool result )
+{
+  std::cout << (result ? "passed: " : "FAILED: ") << name << std::endl;
+  return result;
+}
+
+int main( int argc, char* argv[] )
+{
+  unsigned int port( 43210 );
+
+  if ( argc > 1 )
+    port = std::atoi( argv[1] );
+
+  bear::net::message_factory factory;
+  factory.register_type<counter>( "counter" );
+
+  bear::net::io_thread io;
+  std::unique_ptr<bear::net::server> server
+    ( new bear::net::server( io, port ) );
+  bear::net::client client( io, "127.0.0.1", port, factory );
+  bool ok( true );
+
+  ok &= check
+    ( "connection",
+      wait_for( [&]() -> bool { return is_connected( client ); } )
+      && wait_for( [&]() -> bool { return has_client( *server ); } ) );
+
+  if ( !ok )
+    return EXIT_FAILURE;
+
+  const clock_type::time_point start( clock_type::now() );
+  send( *server, 0, 1000 );
+  ok &= check( "delivery", receive( client, 0, 1000 ) );
+
+  std::cout << "1000 messages in "
+            << std::chrono::duration_cast<std::chrono::microseconds>
+    ( clock_type::now() - start ).count() << " µs." << std::endl;
+
+  ok &= check
+    ( "round trip",
+      wait_for( [&]() -> bool { return has_round_trip( client, *server ); } ) );
+
+  std::cout << "round trip: client " << client.get_statistics().round_trip_time
+            << " ms, server " << server->get_statistics(0).round_trip_time
+            << " ms." << std::endl;
+
+  send( *server, 1000, 50 );
+  ok &= check
+    ( "queue depth",
+      wait_for( [&]() -> bool { return has_incoming( client, 50 ); } ) );
+  ok &= check( "queued delivery", receive( client, 1000, 50 ) );
+
+  std::cout << "server sent " << server->get_statistics(0).bytes_sent
+            << " bytes, client received "
+            << client.get_statistics().bytes_received << " bytes."
+            << std::endl;
+
+  server.reset();
+  ok &= check
+    ( "disconnection",
+      wait_for( [&]() -> bool { return is_reconnecting( client ); } ) );
+
+  server.reset( new bear::net::server( io, port ) );
+  ok &= check
+    ( "reconnection",
+      wait_for( [&]() -> bool { return is_connected( client ); } )
+      && wait_for( [&]() -> bool { return has_client( *server ); } ) );
+
+  send( *server, 2000, 10 );
+  ok &= check( "delivery after reconnection", receive( client, 2000, 10 ) );
+
+  if ( ok )
+    return EXIT_SUCCESS;
+  else
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,712 @@
+/**
+ * \file
+ *
+ * Benchmark of the physics and of the preparation of the rendering, without a
+ * screen nor inputs.
+ *
+ * Usage: world-bench [--ticks=N] [--scale=F] [--scenario=name]
+ *                    [--output=file] [--baseline=file] [--tolerance=F]
+ *
+ * Each scenario builds a world with a fixed seed and runs it for the given
+ * number of ticks of 1/60 s, after a warm up of a tenth of these ticks. The
+ * scenarios are:
+ *  - bouncing_boxes: boxes bouncing in an arena, the case of entity-count,
+ *  - dense_static_map: boxes falling on a ground made of many static blocks,
+ *  - force_rectangles: boxes flying through force, density, friction and
+ *    environment rectangles,
+ *  - chain_links: long chains of items hanging from fixed anchors,
+ *  - decorations: many decorative items, whose scene elements are built for
+ *    a moving camera at each tick,
+ *  - item_picking: rectangle, position and circle queries among many items.
+ *
+ * The results are written on the standard output, and in the output file if
+ * any, as tab separated lines "scenario metric value": the mean and the 95th
+ * percentile of the duration of the ticks, the mean time per tick spent in
+ * each profiled zone, in microseconds, and the mean value per tick of the
+ * performance counters. The size of the scenarios is multiplied by the scale.
+ *
+ * When a baseline file, previously written with --output, is given, the
+ * metrics greater than their baseline value by more than the tolerance (0.1
+ * by default) are reported as regressions and the exit status is 1.
+ */
+
+#include "debug/performance_counters.hpp"
+#include "debug/profiler.hpp"
+#include "debug/profiler_zone.hpp"
+#include "universe/collision_info.hpp"
+#include "universe/link/chain_link.hpp"
+#include "universe/physical_item.hpp"
+#include "universe/world.hpp"
+#include "visual/scene_element.hpp"
+#include "visual/scene_rectangle.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock clock_type;
+
+/** The measures of a scenario, by name of metric. */
+typedef std::map<std::string, double> metric_map;
+
+/** The measures of all the scenarios, by name of scenario. */
+typedef std::map<std::string, metric_map> result_map;
+
+const double time_step( 1.0 / 60 );
+
+/**
+ * A dynamic item of the scenarios.
+ */
+class box:
+  public bear::universe::physical_item
+{
+public:
+  box( std::mt19937& random, double speed )
+  {
+    std::uniform_real_distribution<double> unit( 0, 1 );
+
+    set_size( 20, 20 );
+    set_mass( 500 + 1000 * unit( random ) );
+    set_friction( 1 );
+    set_system_angle( 2 * 3.14159 * unit( random ) );
+    set_speed( get_x_axis() * ( speed + speed * unit( random ) ) );
+    set_density( unit( random ) * 10 );
+    set_angular_speed( -0.05 + unit( random ) * 0.1 );
+    set_elasticity( 0.5 + unit( random ) / 2 );
+  }
+};
+
+/**
+ * A static item on which the other items are aligned.
+ */
+class block:
+  public bear::universe::physical_item
+{
+private:
+  void collision( bear::universe::collision_info& info ) override
+  {
+    switch( info.get_collision_side() )
+      {
+      case bear::universe::zone::bottom_zone:
+        collision_align_bottom(info);
+        break;
+      case bear::universe::zone::top_zone:
+        collision_align_top(info);
+        break;
+      case bear::universe::zone::middle_left_zone:
+        collision_align_left(info);
+        break;
+      case bear::universe::zone::middle_right_zone:
+        collision_align_right(info);
+        break;
+      default:
+        break;
+      }
+  }
+};
+
+/**
+ * The base class of the scenarios: a world, its items and a random generator
+ * with a fixed seed.
+ */
+class scenario
+{
+public:
+  scenario( const std::string& name, double width, double height )
+    : m_name( name ), m_world( bear::universe::size_box_type( width, height ) ),
+      m_random( 42 )
+  {
+    m_region.push_back
+      ( bear::universe::rectangle_type( 0, 0, width, height ) );
+  }
+
+  virtual ~scenario()
+  {
+    for ( bear::universe::physical_item* item : m_items )
+      delete item;
+
+    for ( bear::universe::physical_item* item : m_static_items )
+      delete item;
+  }
+
+  const std::string& get_name() const
+  {
+    return m_name;
+  }
+
+  void tick()
+  {
+    BEAR_PROFILE_ZONE( "bench::tick" );
+
+    m_world.progress_entities( m_region, time_step );
+    extra_work();
+  }
+
+protected:
+  virtual void extra_work()
+  {
+
+  }
+
+  double random_number( double min, double max )
+  {
+    return std::uniform_real_distribution<double>( min, max )( m_random );
+  }
+
+  box* add_box( double x, double y, double speed )
+  {
+    box* const result( new box( m_random, speed ) );
+    result->set_center_of_mass( x, y );
+
+    m_items.push_back( result );
+    m_world.register_item( result );
+
+    return result;
+  }
+
+  block* add_block( double x, double y, double width, double height )
+  {
+    block* const result( new block );
+    result->set_bottom_left( x, y );
+    result->set_size( width, height );
+
+    m_static_items.push_back( result );
+    m_world.add_static( result );
+
+    return result;
+  }
+
+  void add_bounds( double margin )
+  {
+    const bear::universe::size_box_type size( m_world.get_size() );
+
+    add_block( 0, 0, size.x, margin );
+    add_block( 0, size.y - margin, size.x, margin );
+    add_block( 0, margin, margin, size.y - 2 * margin );
+    add_block( size.x - margin, margin, margin, size.y - 2 * margin );
+  }
+
+protected:
+  const std::string m_name;
+  bear::universe::world m_world;
+  bear::universe::world::region_type m_region;
+  std::mt19937 m_random;
+  std::vector<bear::universe::physical_item*> m_items;
+  std::vector<bear::universe::physical_item*> m_static_items;
+};
+
+class bouncing_boxes:
+  public scenario
+{
+public:
+  explicit bouncing_boxes( double scale )
+    : scenario( "bouncing_boxes", 1124, 675 )
+  {
+    m_world.set_gravity( bear::universe::force_type( 0, 0 ) );
+    add_bounds( 50 );
+
+    for ( std::size_t i( 0 ); i < 500 * scale; ++i )
+      add_box( random_number( 100, 1024 ), random_number( 100, 575 ), 200 );
+  }
+};
+
+class dense_static_map:
+  public scenario
+{
+public:
+  explicit dense_static_map( double scale )
+    : scenario( "dense_static_map", 20000 * scale, 2000 )
+  {
+    add_bounds( 50 );
+
+    const double width( m_world.get_size().x );
+
+    // A ground of 10 rows of blocks, and some platforms above.
+    for ( double x( 50 ); x + 20 <= width - 50; x += 20 )
+      for ( std::size_t y( 0 ); y != 10; ++y )
+        add_block( x, 50 + 20 * y, 20, 20 );
+
+    for ( std::size_t i( 0 ); i < 200 * scale; ++i )
+      add_block
+        ( random_number( 50, width - 250 ), random_number( 400, 1800 ), 200,
+          20 );
+
+    for ( std::size_t i( 0 ); i < 300 * scale; ++i )
+      add_box( random_number( 100, width - 100 ), random_number( 300, 1900 ),
+               50 );
+  }
+};
+
+class force_rectangles:
+  public scenario
+{
+public:
+  explicit force_rectangles( double scale )
+    : scenario( "force_rectangles", 4000 * scale, 4000 )
+  {
+    m_world.set_gravity( bear::universe::force_type( 0, 0 ) );
+    add_bounds( 50 );
+
+    const bear::universe::size_box_type size( m_world.get_size() );
+
+    for ( std::size_t i( 0 ); i < 200 * scale; ++i )
+      {
+        m_world.add_force_rectangle
+          ( random_rectangle( size ),
+            bear::universe::force_type
+            ( random_number( -500, 500 ), random_number( -500, 500 ) ) );
+        m_world.add_density_rectangle
+          ( random_rectangle( size ), random_number( 0.5, 2 ) );
+        m_world.add_friction_rectangle
+          ( random_rectangle( size ), random_number( 0.8, 1 ) );
+        m_world.add_environment_rectangle
+          ( random_rectangle( size ), bear::universe::water_environment );
+      }
+
+    for ( std::size_t i( 0 ); i < 500 * scale; ++i )
+      add_box( random_number( 100, size.x - 100 ),
+               random_number( 100, size.y - 100 ), 200 );
+  }
+
+private:
+  bear::universe::rectangle_type
+  random_rectangle( const bear::universe::size_box_type& size )
+  {
+    const double x( random_number( 50, size.x - 450 ) );
+    const double y( random_number( 50, size.y - 450 ) );
+
+    return bear::universe::rectangle_type
+      ( x, y, x + random_number( 50, 400 ), y + random_number( 50, 400 ) );
+  }
+};
+
+class chain_links:
+  public scenario
+{
+public:
+  explicit chain_links( double scale )
+    : scenario( "chain_links", 4000 * scale, 3000 )
+  {
+    add_bounds( 50 );
+
+    const std::size_t chain_length( 100 );
+
+    for ( std::size_t i( 0 ); i < 20 * scale; ++i )
+      {
+        const double x( 150 + 140 * i );
+
+        box* previous( add_box( x, 2900, 0 ) );
+        previous->fix();
+
+        for ( std::size_t j( 1 ); j != chain_length; ++j )
+          {
+            // The chains start on a slope, so they swing.
+            box* const item( add_box( x + 10 * j, 2900 - 22 * j, 0 ) );
+            new bear::universe::chain_link( *previous, *item, 0, 25 );
+            previous = item;
+          }
+      }
+  }
+};
+
+class decorations:
+  public scenario
+{
+public:
+  explicit decorations( double scale )
+    : scenario( "decorations", 20000 * scale, 2000 ), m_camera_x( 0 )
+  {
+    m_world.set_gravity( bear::universe::force_type( 0, 0 ) );
+    add_bounds( 50 );
+
+    const bear::universe::size_box_type size( m_world.get_size() );
+
+    for ( std::size_t i( 0 ); i < 20000 * scale; ++i )
+      {
+        block* const item
+          ( add_block
+            ( random_number( 50, size.x - 250 ),
+              random_number( 50, size.y - 250 ), random_number( 10, 200 ),
+              random_number( 10, 200 ) ) );
+        item->set_phantom( true );
+        item->set_artificial( true );
+      }
+
+    for ( std::size_t i( 0 ); i < 100 * scale; ++i )
+      add_box( random_number( 100, size.x - 100 ),
+               random_number( 100, size.y - 100 ), 200 );
+  }
+
+private:
+  /**
+   * Builds the scene elements of the items visible by a camera moving across
+   * the world, from the background to the foreground, as a layer does before
+   * passing them to the screen.
+   */
+  void extra_work() override
+  {
+    BEAR_PROFILE_ZONE( "bench::render_prep" );
+
+    const bear::universe::size_box_type size( m_world.get_size() );
+    const bear::universe::rectangle_type camera
+      ( m_camera_x, 0, m_camera_x + 1280, 720 );
+
+    m_camera_x += 8;
+
+    if ( m_camera_x + 1280 > size.x )
+      m_camera_x = 0;
+
+    bear::universe::world::item_list visible;
+    m_world.pick_items_in_rectangle( visible, camera );
+
+    std::sort
+      ( visible.begin(), visible.end(),
+        []( const bear::universe::physical_item* a,
+            const bear::universe::physical_item* b ) -> bool
+        {
+          return a->get_bottom() < b->get_bottom();
+        } );
+
+    std::list<bear::visual::scene_element> scene;
+
+    for ( const bear::universe::physical_item* item : visible )
+      {
+        const bear::universe::rectangle_type box( item->get_bounding_box() );
+        const bear::visual::rectangle_type r
+          ( 0, 0, box.width(), box.height() );
+
+        scene.push_back
+          ( bear::visual::scene_rectangle
+            ( box.left() - camera.left(), box.bottom() - camera.bottom(),
+              bear::visual::color_type( "#808080" ), r ) );
+      }
+
+    std::size_t culled( 0 );
+    const bear::visual::rectangle_type screen( 0, 0, 1280, 720 );
+
+    for ( const bear::visual::scene_element& e : scene )
+      if ( !e.get_bounding_box().intersects( screen ) )
+        ++culled;
+
+    BEAR_COUNTER_ADD( "bench/scene_elements", scene.size() );
+    BEAR_COUNTER_ADD( "bench/culled_elements", culled );
+  }
+
+private:
+  double m_camera_x;
+};
+
+class item_picking:
+  public scenario
+{
+public:
+  explicit item_picking( double scale )
+    : scenario( "item_picking", 5000 * scale, 5000 )
+  {
+    m_world.set_gravity( bear::universe::force_type( 0, 0 ) );
+    add_bounds( 50 );
+
+    const bear::universe::size_box_type size( m_world.get_size() );
+
+    for ( std::size_t i( 0 ); i < 2000 * scale; ++i )
+      add_box( random_number( 100, size.x - 100 ),
+               random_number( 100, size.y - 100 ), 20 );
+  }
+
+private:
+  void extra_work() override
+  {
+    BEAR_PROFILE_ZONE( "bench::picking" );
+
+    const bear::universe::size_box_type size( m_world.get_size() );
+    bear::universe::world::item_list items;
+    std::size_t found( 0 );
+
+    for ( std::size_t i( 0 ); i != 200; ++i )
+      {
+        const bear::universe::position_type p
+          ( random_number( 0, size.x ), random_number( 0, size.y ) );
+
+        items.clear();
+        m_world.pick_items_by_position( items, p );
+        found += items.size();
+
+        items.clear();
+        m_world.pick_items_in_circle( items, p, random_number( 10, 300 ) );
+        found += items.size();
+
+        items.clear();
+        m_world.pick_items_in_rectangle
+          ( items,
+            bear::universe::rectangle_type
+            ( p.x, p.y, p.x + random_number( 10, 600 ),
+              p.y + random_number( 10, 600 ) ) );
+        found += items.size();
+      }
+
+    BEAR_COUNTER_ADD( "bench/picked_items", found );
+  }
+};
+
+/**
+ * Runs a scenario and measures the duration of the ticks, the time spent in
+ * the profiled zones and the performance counters.
+ */
+metric_map run( scenario& s, std::size_t ticks )
+{
+  for ( std::size_t i( 0 ); i != ticks / 10; ++i )
+    s.tick();
+
+  bear::debug::profiler::end_frame();
+  bear::debug::performance_counters::end_frame();
+
+  std::vector<double> durations;
+  durations.reserve( ticks );
+
+  std::vector<double> zones;
+  std::vector<double> counters;
+
+  for ( std::size_t i( 0 ); i != ticks; ++i )
+    {
+      const clock_type::time_point start( clock_type::now() );
+      s.tick();
+      durations.push_back
+        ( std::chrono::duration<double, std::micro>
+          ( clock_type::now() - start ).count() );
+
+      bear::debug::profiler::end_frame();
+      bear::debug::performance_counters::end_frame();
+
+      const bear::debug::profiler::frame_statistics& frame
+        ( bear::debug::profiler::get_last_frame() );
+      zones.resize( std::max( zones.size(), frame.zones.size() ), 0 );
+
+      for ( std::size_t z( 0 ); z != frame.zones.size(); ++z )
+        zones[ z ] += frame.zones[ z ].inclusive_duration / 1000.0;
+
+      const bear::debug::performance_counters::value_list& values
+        ( bear::debug::performance_counters::get_last_frame() );
+      counters.resize( std::max( counters.size(), values.size() ), 0 );
+
+      for ( std::size_t c( 0 ); c != values.size(); ++c )
+        counters[ c ] += values[ c ];
+    }
+
+  metric_map result;
+
+  if ( ticks == 0 )
+    return result;
+
+  double sum( 0 );
+
+  for ( double d : durations )
+    sum += d;
+
+  std::sort( durations.begin(), durations.end() );
+
+  result[ "tick_mean_us" ] = sum / ticks;
+  result[ "tick_p95_us" ] = durations[ ( ticks - 1 ) * 95 / 100 ];
+
+  for ( std::size_t z( 0 ); z != zones.size(); ++z )
+    if ( zones[ z ] != 0 )
+      result[ "zone:" + bear::debug::profiler::get_zone_name( z ) ] =
+        zones[ z ] / ticks;
+
+  for ( std::size_t c( 0 ); c != counters.size(); ++c )
+    if ( counters[ c ] != 0 )
+      result[ "counter:"
+              + bear::debug::performance_counters::get_counter_name( c ) ] =
+        counters[ c ] / ticks;
+
+  return result;
+}
+
+scenario* create_scenario( const std::string& name, double scale )
+{
+  if ( name == "bouncing_boxes" )
+    return new bouncing_boxes( scale );
+  if ( name == "dense_static_map" )
+    return new dense_static_map( scale );
+  if ( name == "force_rectangles" )
+    return new force_rectangles( scale );
+  if ( name == "chain_links" )
+    return new chain_links( scale );
+  if ( name == "decorations" )
+    return new decorations( scale );
+  if ( name == "item_picking" )
+    return new item_picking( scale );
+
+  return NULL;
+}
+
+void write_results( std::ostream& os, const result_map& results )
+{
+  for ( const result_map::value_type& s : results )
+    for ( const metric_map::value_type& m : s.second )
+      os << s.first << '\t' << m.first << '\t' << m.second << '\n';
+}
+
+bool read_results( const std::string& path, result_map& results )
+{
+  std::ifstream f( path.c_str() );
+
+  if ( !f )
+    return false;
+
+  std::string line;
+
+  while ( std::getline( f, line ) )
+    {
+      std::istringstream iss( line );
+      std::string name;
+      std::string metric;
+      double value;
+
+      if ( std::getline( iss, name, '\t' ) && std::getline( iss, metric, '\t' )
+           && ( iss >> value ) )
+        results[ name ][ metric ] = value;
+    }
+
+  return true;
+}
+
+/**
+ * Compares the results with the baseline and tells if there is no
+ * regression. The durations under one microsecond are ignored since they are
+ * mostly noise.
+ */
+bool compare_results
+( const result_map& results, const result_map& baseline, double tolerance )
+{
+  bool result( true );
+
+  for ( const result_map::value_type& s : results )
+    {
+      const result_map::const_iterator base( baseline.find( s.first ) );
+
+      if ( base == baseline.end() )
+        continue;
+
+      for ( const metric_map::value_type& m : s.second )
+        {
+          const metric_map::const_iterator it( base->second.find( m.first ) );
+
+          if ( ( it == base->second.end() ) || ( it->second <= 0 ) )
+            continue;
+
+          const bool is_duration
+            ( m.first.compare( 0, 8, "counter:" ) != 0 );
+
+          if ( is_duration && ( m.second < 1 ) )
+            continue;
+
+          const double ratio( m.second / it->second );
+
+          if ( ratio > 1 + tolerance )
+            {
+              std::cerr << "regression: " << s.first << ' ' << m.first << ' '
+                        << it->second << " -> " << m.second << " (+"
+                        << ( ratio - 1 ) * 100 << "%)\n";
+              result = false;
+            }
+        }
+    }
+
+  return result;
+}
+
+int main( int argc, char* argv[] )
+{
+  std::size_t ticks( 600 );
+  double scale( 1 );
+  double tolerance( 0.1 );
+  std::string output;
+  std::string baseline;
+  std::vector<std::string> names
+    ( { "bouncing_boxes", "dense_static_map", "force_rectangles",
+        "chain_links", "decorations", "item_picking" } );
+  std::vector<std::string> selected;
+
+  for ( int i( 1 ); i != argc; ++i )
+    {
+      const std::string arg( argv[ i ] );
+      const std::string::size_type eq( arg.find( '=' ) );
+      const std::string key( arg.substr( 0, eq ) );
+      const std::string value
+        ( eq == std::string::npos ? std::string() : arg.substr( eq + 1 ) );
+
+      if ( key == "--ticks" )
+        std::istringstream( value ) >> ticks;
+      else if ( key == "--scale" )
+        std::istringstream( value ) >> scale;
+      else if ( key == "--tolerance" )
+        std::istringstream( value ) >> tolerance;
+      else if ( key == "--scenario" )
+        selected.push_back( value );
+      else if ( key == "--output" )
+        output = value;
+      else if ( key == "--baseline" )
+        baseline = value;
+      else
+        {
+          std::cerr << "Unknown argument: " << arg << '\n';
+          return 2;
+        }
+    }
+
+  if ( !selected.empty() )
+    names = selected;
+
+  bear::debug::profiler::set_enabled( true );
+
+  result_map results;
+
+  for ( const std::string& name : names )
+    {
+      scenario* const s( create_scenario( name, scale ) );
+
+      if ( s == NULL )
+        {
+          std::cerr << "Unknown scenario: " << name << '\n';
+          return 2;
+        }
+
+      results[ name ] = run( *s, ticks );
+      delete s;
+
+      std::cerr << name << ": " << results[ name ][ "tick_mean_us" ]
+                << " us per tick\n";
+    }
+
+  write_results( std::cout, results );
+
+  if ( !output.empty() )
+    {
+      std::ofstream f( output.c_str() );
+      write_results( f, results );
+    }
+
+  if ( !baseline.empty() )
+    {
+      result_map reference;
+
+      if ( !read_results( baseline, reference ) )
+        {
+          std::cerr << "Can't read the baseline " << baseline << '\n';
+          return 2;
+        }
+
+      if ( !compare_results( results, reference, tolerance ) )
+        return 1;
+    }
+
+  return 0;
+}
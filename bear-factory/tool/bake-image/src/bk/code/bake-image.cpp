@@ -0,0 +1,102 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Converts an image into the baked format loaded by
+ *        bear::visual::image_manager without decoding.
+ *
+ * See bear::visual::baked_image for a description of the format.
+ */
+#include "baked_image_format.hpp"
+
+#include <claw/image.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+void help( const std::string& n )
+{
+  std::cerr << "usage:\n" << n << " source_image output_file\n"
+            << "\nThe output file can replace the source image in the game's "
+            << "resources." << std::endl;
+} // help()
+
+void write_integer( std::ostream& os, unsigned int i )
+{
+  const char bytes[4] =
+    { char(i & 0xff), char((i >> 8) & 0xff), char((i >> 16) & 0xff),
+      char((i >> 24) & 0xff) };
+
+  os.write( bytes, sizeof(bytes) );
+} // write_integer()
+
+bool has_transparency( const claw::graphic::image& img )
+{
+  const claw::graphic::rgba_pixel_8::component_type opaque =
+    std::numeric_limits<claw::graphic::rgba_pixel_8::component_type>::max();
+
+  for ( claw::graphic::image::const_iterator it=img.begin(); it!=img.end();
+        ++it )
+    if ( it->components.alpha != opaque )
+      return true;
+
+  return false;
+} // has_transparency()
+
+void bake( const claw::graphic::image& img, std::ostream& os )
+{
+  write_integer( os, bear::baked_image_format::magic );
+  write_integer( os, bear::baked_image_format::version );
+  write_integer( os, img.width() );
+  write_integer( os, img.height() );
+  write_integer
+    ( os,
+      has_transparency(img) ? bear::baked_image_format::flag_transparency : 0 );
+
+  for ( claw::graphic::image::const_iterator it=img.begin(); it!=img.end();
+        ++it )
+    {
+      const char pixel[ bear::baked_image_format::pixel_size ] =
+        { char(it->components.red), char(it->components.green),
+          char(it->components.blue), char(it->components.alpha) };
+
+      os.write( pixel, sizeof(pixel) );
+    }
+} // bake()
+
+int main( int argc, char* argv[] )
+{
+  if ( argc != 3 )
+    {
+      help(argv[0]);
+      return 1;
+    }
+
+  std::ifstream f( argv[1], std::ios::binary );
+
+  if ( !f )
+    {
+      std::cerr << "Can't open file for reading: " << argv[1] << std::endl;
+      return 1;
+    }
+
+  std::ofstream output( argv[2], std::ios::binary );
+
+  if ( !output )
+    {
+      std::cerr << "Can't open file for writing: " << argv[2] << std::endl;
+      return 1;
+    }
+
+  const claw::graphic::image source(f);
+  bake( source, output );
+
+  return output ? 0 : 1;
+} // main()
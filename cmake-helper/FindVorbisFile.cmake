@@ -0,0 +1,45 @@
+# - Locate the vorbisfile library
+# This module defines:
+#  VORBISFILE_LIBRARIES, the libraries to link against
+#  VORBISFILE_INCLUDE_DIRS, where to find the headers
+#  VORBISFILE_FOUND, if false, do not try to link against
+
+find_path(VORBISFILE_INCLUDE_DIR vorbis/vorbisfile.h
+  HINTS
+    ENV VORBISDIR
+  PATH_SUFFIXES include
+)
+
+find_library(VORBISFILE_LIBRARY
+  NAMES vorbisfile
+  HINTS
+    ENV VORBISDIR
+  PATH_SUFFIXES lib
+)
+
+find_library(VORBIS_LIBRARY
+  NAMES vorbis
+  HINTS
+    ENV VORBISDIR
+  PATH_SUFFIXES lib
+)
+
+find_library(OGG_LIBRARY
+  NAMES ogg
+  HINTS
+    ENV OGGDIR
+    ENV VORBISDIR
+  PATH_SUFFIXES lib
+)
+
+set(VORBISFILE_LIBRARIES ${VORBISFILE_LIBRARY} ${VORBIS_LIBRARY} ${OGG_LIBRARY})
+set(VORBISFILE_INCLUDE_DIRS ${VORBISFILE_INCLUDE_DIR})
+
+include(FindPackageHandleStandardArgs)
+
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(VorbisFile
+  REQUIRED_VARS VORBISFILE_LIBRARY VORBIS_LIBRARY OGG_LIBRARY
+                VORBISFILE_INCLUDE_DIR)
+
+mark_as_advanced(
+  VORBISFILE_INCLUDE_DIR VORBISFILE_LIBRARY VORBIS_LIBRARY OGG_LIBRARY)
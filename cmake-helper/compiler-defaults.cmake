@@ -10,10 +10,6 @@ if(CMAKE_COMPILER_IS_GNUCXX)
   endif(NOT WIN32 AND NOT APPLE)
 endif(CMAKE_COMPILER_IS_GNUCXX)
 
-IF( BEAR_PROFILE )
-  add_definitions( "-DBEAR_PROFILE" )
-ENDIF( BEAR_PROFILE )
-
 IF( CLAW_SOFT_ASSERT )
   add_definitions( "-DCLAW_SOFT_ASSERT" )
 ENDIF( CLAW_SOFT_ASSERT )
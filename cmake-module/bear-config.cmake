@@ -46,6 +46,25 @@ else()
   )
 endif( NOT SDL2MIXER_FOUND )
 
+#-------------------------------------------------------------------------------
+# vorbisfile is used to stream the musics
+include( FindVorbisFile )
+
+if( NOT VORBISFILE_FOUND )
+  message( FATAL_ERROR "The Bear Engine needs vorbisfile." )
+else()
+  set(
+    BEAR_ENGINE_INCLUDE_DIRECTORY
+    ${BEAR_ENGINE_INCLUDE_DIRECTORY}
+    ${VORBISFILE_INCLUDE_DIRS}
+    )
+  set(
+    BEAR_ENGINE_LIBRARIES
+    ${BEAR_ENGINE_LIBRARIES}
+    ${VORBISFILE_LIBRARIES}
+  )
+endif( NOT VORBISFILE_FOUND )
+
 #-------------------------------------------------------------------------------
 # The SDL2 is used for the display and the inputs.
 include( FindSDL2 )
@@ -106,7 +125,7 @@ endif()
 #-------------------------------------------------------------------------------
 # Boost is used in a lot of places in the Bear Engine
 find_package(
-  Boost 1.42 REQUIRED COMPONENTS filesystem regex system thread
+  Boost 1.47 REQUIRED COMPONENTS filesystem regex system thread
   )
 
 if( NOT Boost_FOUND )